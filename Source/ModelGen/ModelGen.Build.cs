@@ -23,6 +23,7 @@ public class ModelGen : ModuleRules
 
 		PrivateDependencyModuleNames.AddRange(new string[] { 
 			"PhysXCooking",
+			"Json",
 		});
 
 		// 注意：已移除VHACD依赖，改用全平台支持的QuickHull实现（ModelGenConvexDecomp）
@@ -11,7 +11,10 @@ ABevelCube::ABevelCube()
 
 void ABevelCube::GenerateMesh()
 {
-    TryGenerateMeshInternal();
+    if (!TryGenerateMeshInternal())
+    {
+        ClearGeneratedMesh();
+    }
 }
 
 bool ABevelCube::TryGenerateMeshInternal()
@@ -21,46 +24,48 @@ bool ABevelCube::TryGenerateMeshInternal()
         return false;
     }
 
-    FBevelCubeBuilder Builder(*this);
-    FModelGenMeshData MeshData;
-
-    if (!Builder.Generate(MeshData))
+    if (RefreshInstancedShape())
     {
-        return false;
+        return true;
     }
 
-    if (!MeshData.IsValid())
-    {
-        return false;
-    }
+    const FBevelCubeParams Params = GetParams();
+    FBevelCubeBuilder Builder(Params);
+    return GenerateAndApplyMesh(Builder, Params);
+}
 
-    MeshData.ToProceduralMesh(GetProceduralMesh(), 0);
-    return true;
+TUniquePtr<FModelGenMeshBuilder> ABevelCube::CreateMeshBuilder() const
+{
+    return MakeUnique<FBevelCubeBuilder>(GetParams());
+}
+
+FBevelCubeParams ABevelCube::GetParams() const
+{
+    FBevelCubeParams Params;
+    Params.Size = Size;
+    Params.BevelRadius = BevelRadius;
+    Params.BevelSegments = BevelSegments;
+    return Params;
+}
+
+FModelGenParamsHash ABevelCube::GetShapeParamsHash() const
+{
+    return FModelGenParamsHash::Compute(GetParams());
 }
 
 bool ABevelCube::IsValid() const
 {
-    return Size.X > 0.0f && Size.Y > 0.0f && Size.Z > 0.0f &&
-        BevelRadius >= 0.0f &&
-        BevelSegments >= 0 && BevelSegments <= 10;
+    return GetParams().IsValid();
 }
 
 int32 ABevelCube::GetVertexCount() const
 {
-    if (BevelSegments == 0)
-    {
-        return 24;
-    }
-    return 24 + 24 * (BevelSegments + 1) + 4 * (BevelSegments + 1) * (BevelSegments + 1);
+    return GetParams().GetVertexCount();
 }
 
 int32 ABevelCube::GetTriangleCount() const
 {
-    if (BevelSegments == 0)
-    {
-        return 12;
-    }
-    return 12 + 24 * BevelSegments + 8 * BevelSegments * BevelSegments;
+    return GetParams().GetTriangleCount();
 }
 
 void ABevelCube::SetSize(FVector NewSize)
@@ -1,12 +1,13 @@
 // Copyright (c) 2024. All rights reserved.
 
 #include "BevelCubeBuilder.h"
-#include "BevelCube.h"
 #include "ModelGenMeshData.h"
+#include "PhysicsEngine/AggregateGeom.h"
 #include "ModelGenConstants.h"
+#include "ModelGenStats.h"
 
-FBevelCubeBuilder::FBevelCubeBuilder(const ABevelCube & InBevelCube)
-    : BevelCube(InBevelCube)
+FBevelCubeBuilder::FBevelCubeBuilder(const FBevelCubeParams& InParams)
+    : Params(InParams)
 {
     Clear();
 }
@@ -21,7 +22,9 @@ void FBevelCubeBuilder::Clear()
 
 bool FBevelCubeBuilder::Generate(FModelGenMeshData& OutMeshData)
 {
-    if (!BevelCube.IsValid())
+    MODELGEN_GENERATE_SCOPE(OutMeshData);
+
+    if (!Params.IsValid())
     {
         return false;
     }
@@ -29,11 +32,11 @@ bool FBevelCubeBuilder::Generate(FModelGenMeshData& OutMeshData)
     Clear();
     ReserveMemory();
 
-    HalfSize = BevelCube.GetHalfSize();
-    InnerOffset = BevelCube.GetInnerOffset();
+    HalfSize = Params.GetHalfSize();
+    InnerOffset = Params.GetInnerOffset();
 
-    BevelRadius = BevelCube.BevelRadius;
-    BevelSegments = BevelCube.BevelSegments;
+    BevelRadius = Params.BevelRadius;
+    BevelSegments = Params.BevelSegments;
 
     bEnableBevel = (BevelSegments > 0) && (BevelRadius > KINDA_SMALL_NUMBER) &&
         (HalfSize.X > InnerOffset.X + KINDA_SMALL_NUMBER) &&
@@ -61,12 +64,70 @@ bool FBevelCubeBuilder::Generate(FModelGenMeshData& OutMeshData)
 
 int32 FBevelCubeBuilder::CalculateVertexCountEstimate() const
 {
-    return BevelCube.GetVertexCount();
+    return Params.GetVertexCount();
 }
 
 int32 FBevelCubeBuilder::CalculateTriangleCountEstimate() const
 {
-    return BevelCube.GetTriangleCount();
+    return Params.GetTriangleCount();
+}
+
+bool FBevelCubeBuilder::GenerateSimpleCollision(FKAggregateGeom& OutGeom) const
+{
+    if (!Params.IsValid())
+    {
+        return false;
+    }
+
+    const FVector CubeHalfSize = Params.GetHalfSize();
+    const FVector CubeInnerOffset = Params.GetInnerOffset();
+    const bool bHasBevel = (Params.BevelSegments > 0) && (Params.BevelRadius > KINDA_SMALL_NUMBER) &&
+        (CubeHalfSize.X > CubeInnerOffset.X + KINDA_SMALL_NUMBER) &&
+        (CubeHalfSize.Y > CubeInnerOffset.Y + KINDA_SMALL_NUMBER) &&
+        (CubeHalfSize.Z > CubeInnerOffset.Z + KINDA_SMALL_NUMBER);
+
+    if (!bHasBevel)
+    {
+        OutGeom.BoxElems.Add(FKBoxElem(Params.Size.X, Params.Size.Y, Params.Size.Z));
+        return true;
+    }
+
+    // 圆角立方体是凸体：八个内角点沿各自卦限的球面方向外推倒角半径
+    const int32 OctantSegments = FMath::Clamp(Params.BevelSegments, 1, 3);
+
+    TArray<FVector> Points;
+    Points.Reserve(8 * (OctantSegments + 1) * (OctantSegments + 2) / 2);
+
+    for (int32 Corner = 0; Corner < 8; ++Corner)
+    {
+        const FVector Sign((Corner & 1) ? 1.0f : -1.0f, (Corner & 2) ? 1.0f : -1.0f, (Corner & 4) ? 1.0f : -1.0f);
+        const FVector CornerCenter = CubeInnerOffset * Sign;
+
+        for (int32 i = 0; i <= OctantSegments; ++i)
+        {
+            for (int32 j = 0; j <= OctantSegments - i; ++j)
+            {
+                const FVector Direction = FVector(i, j, OctantSegments - i - j).GetSafeNormal() * Sign;
+                Points.Add(CornerCenter + Direction * Params.BevelRadius);
+            }
+        }
+    }
+
+    AddConvexElem(OutGeom, MoveTemp(Points));
+    return OutGeom.ConvexElems.Num() > 0;
+}
+
+TUniquePtr<FModelGenMeshBuilder> FBevelCubeBuilder::CreateReducedBuilder(float TessellationScale) const
+{
+    FBevelCubeParams Reduced = Params;
+    Reduced.BevelSegments = ScaleSegmentCount(Params.BevelSegments, TessellationScale, 1);
+
+    if (Reduced.BevelSegments == Params.BevelSegments)
+    {
+        return nullptr;
+    }
+
+    return MakeUnique<FBevelCubeBuilder>(Reduced);
 }
 
 void FBevelCubeBuilder::PrecomputeGrids()
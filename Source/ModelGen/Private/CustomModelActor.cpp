@@ -2,7 +2,6 @@
 
 #include "CustomModelActor.h"
 #include "Materials/MaterialInterface.h"
-#include "ProceduralMeshActor.h"
 
 ACustomModelActor::ACustomModelActor()
 {
@@ -42,29 +41,19 @@ void ACustomModelActor::Tick(float DeltaTime)
 
 void ACustomModelActor::GenerateMesh()
 {
+    // 由参数直接生成 StaticMesh，不再生成临时的 ProceduralMeshActor
     TMap<FString, FString> EmptyParameters;
-    AActor* ModelActor = UCustomModelFactory::CreateModelActorWithParams(ModelTypeName, EmptyParameters, GetWorld(), GetActorLocation(), GetActorRotation());
-    
-    if (ModelActor)
+    UStaticMesh* GeneratedStaticMesh = UCustomModelFactory::CreateModelStaticMesh(ModelTypeName, EmptyParameters, GetWorld());
+
+    if (GeneratedStaticMesh && StaticMeshComponent)
     {
-        if (AProceduralMeshActor* ProcMeshActor = Cast<AProceduralMeshActor>(ModelActor))
+        StaticMeshComponent->SetStaticMesh(GeneratedStaticMesh);
+        StaticMeshComponent->StreamingDistanceMultiplier = 10.0f;
+
+        if (StaticMeshMaterial)
         {
-            ProcMeshActor->GenerateMesh();
-            UStaticMesh* GeneratedStaticMesh = ProcMeshActor->ConvertProceduralMeshToStaticMesh();
-            
-            if (GeneratedStaticMesh && StaticMeshComponent)
-            {
-                StaticMeshComponent->SetStaticMesh(GeneratedStaticMesh);
-                StaticMeshComponent->StreamingDistanceMultiplier = 10.0f;
-                
-                if (StaticMeshMaterial)
-                {
-                    StaticMeshComponent->SetMaterial(0, StaticMeshMaterial);
-                }
-            }
+            StaticMeshComponent->SetMaterial(0, StaticMeshMaterial);
         }
-        
-        ModelActor->Destroy();
     }
 }
 
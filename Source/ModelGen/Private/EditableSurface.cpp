@@ -3,6 +3,8 @@
 #include "EditableSurface.h"
 #include "EditableSurfaceBuilder.h"
 #include "ModelGenMeshData.h"
+#include "ModelGenDiskCache.h"
+#include "Async/ParallelFor.h"
 
 AEditableSurface::AEditableSurface()
 {
@@ -21,8 +23,17 @@ AEditableSurface::AEditableSurface()
 void AEditableSurface::OnConstruction(const FTransform& Transform)
 {
     Super::OnConstruction(Transform);
-    UpdateSplineFromWaypoints();
-    GenerateMesh();
+    RebuildSplineData();
+
+    // 分块模式下只重建脏分块，开销已足够小；按三角形切分需要在游戏线程写入多个组件，两者都直接同步生成
+    if (bAsyncMeshGeneration && SegmentsPerChunk <= 0 && MaxTrianglesPerChunk <= 0)
+    {
+        GenerateMeshAsync();
+    }
+    else
+    {
+        GenerateMesh();
+    }
 }
 
 void AEditableSurface::InitializeDefaultWaypoints()
@@ -39,59 +50,10 @@ void AEditableSurface::RebuildSplineData()
 {
     if (!SplineComponent) return;
 
-    SplineComponent->ClearSplinePoints(false);
-
-    if (Waypoints.Num() < 2) return;
-
-    auto GetActualWidth = [&](float WPWidth) -> float {
-        return (WPWidth > 0.0f) ? WPWidth : SurfaceWidth;
-    };
-
-    if (CurveType == ESurfaceCurveType::Standard)
-    {
-        for (int32 i = 0; i < Waypoints.Num(); ++i)
-        {
-            SplineComponent->AddSplinePoint(Waypoints[i].Position, ESplineCoordinateSpace::Local, false);
-            SplineComponent->SetSplinePointType(i, ESplinePointType::Curve, false);
-            
-            float ActualWidth = GetActualWidth(Waypoints[i].Width);
-            SplineComponent->SetScaleAtSplinePoint(i, FVector(1.0f, ActualWidth, 1.0f), false);
-        }
-    }
-    else 
-    {
-        SplineComponent->AddSplinePoint(Waypoints[0].Position, ESplineCoordinateSpace::Local, false);
-        SplineComponent->SetSplinePointType(0, ESplinePointType::Curve, false);
-        
-        float StartWidth = GetActualWidth(Waypoints[0].Width);
-        SplineComponent->SetScaleAtSplinePoint(0, FVector(1.0f, StartWidth, 1.0f), false);
-
-        for (int32 i = 0; i < Waypoints.Num() - 1; ++i)
-        {
-            const FSurfaceWaypoint& P0 = Waypoints[i];
-            const FSurfaceWaypoint& P1 = Waypoints[i+1];
-
-            FVector MidPos = (P0.Position + P1.Position) * 0.5f;
-
-            float W0 = GetActualWidth(P0.Width);
-            float W1 = GetActualWidth(P1.Width);
-            float MidWidth = (W0 + W1) * 0.5f;
-
-            SplineComponent->AddSplinePoint(MidPos, ESplineCoordinateSpace::Local, false);
-            int32 NewIdx = SplineComponent->GetNumberOfSplinePoints() - 1;
-            
-            SplineComponent->SetSplinePointType(NewIdx, ESplinePointType::Curve, false);
-            SplineComponent->SetScaleAtSplinePoint(NewIdx, FVector(1.0f, MidWidth, 1.0f), false);
-        }
-
-        SplineComponent->AddSplinePoint(Waypoints.Last().Position, ESplineCoordinateSpace::Local, false);
-        int32 LastIdx = SplineComponent->GetNumberOfSplinePoints() - 1;
-        SplineComponent->SetSplinePointType(LastIdx, ESplinePointType::Curve, false);
-        
-        float EndWidth = GetActualWidth(Waypoints.Last().Width);
-        SplineComponent->SetScaleAtSplinePoint(LastIdx, FVector(1.0f, EndWidth, 1.0f), false);
-    }
+    FEditableSurfaceParams Params = GetParams();
+    Params.BuildSplineCurves(SplineComponent->ReparamStepsPerSegment);
 
+    SplineComponent->SplineCurves = Params.SplineCurves;
     SplineComponent->UpdateSpline();
 }
 
@@ -128,13 +90,17 @@ void AEditableSurface::GenerateMesh()
 {
     if (!TryGenerateMeshInternal())
     {
-        if (ProceduralMeshComponent)
-        {
-            ProceduralMeshComponent->ClearAllMeshSections();
-        }
+        ClearGeneratedMesh();
     }
 }
 
+void AEditableSurface::ClearGeneratedMesh()
+{
+    ChunkHashes.Reset();
+    PersistedChunks.Reset();
+    Super::ClearGeneratedMesh();
+}
+
 bool AEditableSurface::TryGenerateMeshInternal()
 {
     if (SplineComponent && SplineComponent->GetNumberOfSplinePoints() < 2 && Waypoints.Num() >= 2)
@@ -147,26 +113,198 @@ bool AEditableSurface::TryGenerateMeshInternal()
         return false;
     }
 
-    FEditableSurfaceBuilder Builder(*this);
+    // 实例化时共享网格由实例组按参数哈希取得，不必为自身生成
+    if (RefreshInstancedShape())
+    {
+        return true;
+    }
+
+    FEditableSurfaceParams Params = GetParams();
+    if (SegmentsPerChunk > 0)
+    {
+        return TryGenerateChunkedMeshInternal(Params);
+    }
+
+    ChunkHashes.Reset();
+    PersistedChunks.Reset();
+
+    FEditableSurfaceBuilder Builder(Params);
     FModelGenMeshData MeshData;
 
     int32 EstVerts = Builder.CalculateVertexCountEstimate();
     int32 EstTris = Builder.CalculateTriangleCountEstimate();
     MeshData.Reserve(EstVerts, EstTris);
 
-    if (Builder.Generate(MeshData))
+    if (FModelGenDiskCache::Get().FindOrGenerate(ComputeShapeHash(Params), Builder, MeshData, ShouldPersistMeshData()))
     {
-        if (ProceduralMeshComponent)
+        if (MaxTrianglesPerChunk > 0 && MeshData.Triangles.Num() / 3 > MaxTrianglesPerChunk)
         {
-            MeshData.ToProceduralMesh(ProceduralMeshComponent, 0);
+            TArray<FModelGenMeshData> Chunks;
+            MeshData.SplitByTriangleBudget(MaxTrianglesPerChunk, Chunks);
+
+            SetNumMeshChunks(Chunks.Num());
+            for (int32 ChunkIndex = 0; ChunkIndex < Chunks.Num(); ++ChunkIndex)
+            {
+                ApplyMeshChunk(ChunkIndex, Chunks[ChunkIndex]);
+            }
+            return true;
         }
 
+        ApplyMeshData(MoveTemp(MeshData));
+
         return true;
     }
 
     return false;
 }
 
+bool AEditableSurface::TryGenerateChunkedMeshInternal(const FEditableSurfaceParams& Params)
+{
+    UProceduralMeshComponent* MeshComponent = GetProceduralMesh();
+    if (!MeshComponent || !Params.IsValid())
+    {
+        return false;
+    }
+
+    const int32 NumSegments = Params.GetNumSplinePoints() - 1;
+    const int32 NumChunks = FMath::DivideAndRoundUp(NumSegments, SegmentsPerChunk);
+
+    // 路点之外的参数对所有分块生效，路点本身通过各分块的样条点参与哈希
+    FEditableSurfaceParams SharedParams = Params;
+    SharedParams.Waypoints.Reset();
+    const FModelGenParamsHash SharedHash = FModelGenParamsHash::Compute(SharedParams);
+
+    // 分块数变化或组件已被整体结果覆盖时，现有分块与哈希对应不上，全部重建
+    if (ChunkHashes.Num() != NumChunks || GetNumMeshChunks() != NumChunks || HasWholeMeshData())
+    {
+        ChunkHashes.Reset();
+        ChunkHashes.SetNum(NumChunks);
+        PersistedChunks.Reset();
+        PersistedChunks.SetNumZeroed(NumChunks);
+        SetNumMeshChunks(NumChunks);
+    }
+
+    const bool bPersist = ShouldPersistMeshData();
+
+    TArray<int32> DirtyChunks;
+    TArray<FModelGenParamsHash> DirtyHashes;
+    for (int32 ChunkIndex = 0; ChunkIndex < NumChunks; ++ChunkIndex)
+    {
+        const int32 FirstPoint = ChunkIndex * SegmentsPerChunk;
+        const int32 LastPoint = FMath::Min(FirstPoint + SegmentsPerChunk, NumSegments);
+
+        const FModelGenParamsHash Hash = ComputeChunkHash(Params, SharedHash, FirstPoint, LastPoint);
+        if (Hash != ChunkHashes[ChunkIndex] || (bPersist && !PersistedChunks[ChunkIndex]))
+        {
+            DirtyChunks.Add(ChunkIndex);
+            DirtyHashes.Add(Hash);
+        }
+    }
+
+    if (DirtyChunks.Num() == 0)
+    {
+        return true;
+    }
+
+    // 各分块互不依赖，脏分块在任务图上并行生成，上传仍在游戏线程按分块顺序进行
+    TArray<FModelGenMeshData> ChunkMeshes;
+    ChunkMeshes.SetNum(DirtyChunks.Num());
+
+    ParallelFor(DirtyChunks.Num(), [&](int32 Index)
+    {
+        const int32 FirstPoint = DirtyChunks[Index] * SegmentsPerChunk;
+        const int32 LastPoint = FMath::Min(FirstPoint + SegmentsPerChunk, NumSegments);
+
+        FEditableSurfaceBuilder Builder(Params);
+        Builder.SetDistanceRange(Params.GetDistanceAtSplinePoint(FirstPoint), Params.GetDistanceAtSplinePoint(LastPoint));
+
+        FModelGenMeshData& ChunkMesh = ChunkMeshes[Index];
+        ChunkMesh.Reserve(Builder.CalculateVertexCountEstimate(), Builder.CalculateTriangleCountEstimate());
+        if (!FModelGenDiskCache::Get().FindOrGenerate(DirtyHashes[Index], Builder, ChunkMesh, bPersist))
+        {
+            ChunkMesh.Clear();
+        }
+    }, DirtyChunks.Num() < 2 ? EParallelForFlags::ForceSingleThread : EParallelForFlags::None);
+
+    for (int32 Index = 0; Index < DirtyChunks.Num(); ++Index)
+    {
+        ApplyMeshChunk(DirtyChunks[Index], ChunkMeshes[Index]);
+        ChunkHashes[DirtyChunks[Index]] = DirtyHashes[Index];
+        PersistedChunks[DirtyChunks[Index]] = bPersist;
+    }
+
+    return true;
+}
+
+FModelGenParamsHash AEditableSurface::ComputeChunkHash(const FEditableSurfaceParams& Params, const FModelGenParamsHash& SharedHash,
+    int32 FirstPoint, int32 LastPoint)
+{
+    // 样条段的几何只取决于两端样条点的值与切线（自动切线已在 UpdateSpline 时算好），因此分块外的编辑不会弄脏本块
+    TArray<uint8> Bytes;
+    auto Write = [&Bytes](const void* Data, int32 NumBytes)
+    {
+        Bytes.Append(static_cast<const uint8*>(Data), NumBytes);
+    };
+
+    Write(&SharedHash.Low, sizeof(uint64));
+    Write(&SharedHash.High, sizeof(uint64));
+    Write(&Params.DefaultUpVector, sizeof(FVector));
+
+    // 是否封口取决于分块是否位于样条两端
+    const uint8 bStartCap = FirstPoint == 0 ? 1 : 0;
+    const uint8 bEndCap = LastPoint == Params.GetNumSplinePoints() - 1 ? 1 : 0;
+    Write(&bStartCap, sizeof(uint8));
+    Write(&bEndCap, sizeof(uint8));
+
+    const FSplineCurves& Curves = Params.SplineCurves;
+    for (int32 PointIndex = FirstPoint; PointIndex <= LastPoint; ++PointIndex)
+    {
+        const FInterpCurvePoint<FVector>& Position = Curves.Position.Points[PointIndex];
+        const uint8 InterpMode = Position.InterpMode;
+        Write(&Position.InVal, sizeof(float));
+        Write(&Position.OutVal, sizeof(FVector));
+        Write(&Position.ArriveTangent, sizeof(FVector));
+        Write(&Position.LeaveTangent, sizeof(FVector));
+        Write(&InterpMode, sizeof(uint8));
+
+        const FInterpCurvePoint<FQuat>& Rotation = Curves.Rotation.Points[PointIndex];
+        Write(&Rotation.OutVal, sizeof(FQuat));
+        Write(&Rotation.ArriveTangent, sizeof(FQuat));
+        Write(&Rotation.LeaveTangent, sizeof(FQuat));
+
+        const FInterpCurvePoint<FVector>& Scale = Curves.Scale.Points[PointIndex];
+        Write(&Scale.OutVal, sizeof(FVector));
+        Write(&Scale.ArriveTangent, sizeof(FVector));
+        Write(&Scale.LeaveTangent, sizeof(FVector));
+    }
+
+    // 分块的采样位置由其段内的距离-参数映射决定，表项按 GetDistanceAtSplinePoint 的方式定位
+    const TArray<FInterpCurvePoint<float>>& ReparamPoints = Curves.ReparamTable.Points;
+    const int32 NumSegments = Params.GetNumSplinePoints() - 1;
+    const int32 StepsPerSegment = NumSegments > 0 ? FMath::Max(1, (ReparamPoints.Num() - 1) / NumSegments) : 1;
+    const int32 FirstReparam = FMath::Min(FirstPoint * StepsPerSegment, ReparamPoints.Num());
+    const int32 LastReparam = FMath::Min(LastPoint * StepsPerSegment, ReparamPoints.Num() - 1);
+    Write(&StepsPerSegment, sizeof(int32));
+    for (int32 ReparamIndex = FirstReparam; ReparamIndex <= LastReparam; ++ReparamIndex)
+    {
+        Write(&ReparamPoints[ReparamIndex].InVal, sizeof(float));
+        Write(&ReparamPoints[ReparamIndex].OutVal, sizeof(float));
+    }
+
+    return FModelGenParamsHash::ComputeBytes(Bytes.GetData(), Bytes.Num());
+}
+
+TUniquePtr<FModelGenMeshBuilder> AEditableSurface::CreateMeshBuilder() const
+{
+    FEditableSurfaceParams Params = GetParams();
+    if (!SplineComponent || !Params.IsValid())
+    {
+        return nullptr;
+    }
+
+    return MakeUnique<FEditableSurfaceBuilder>(Params);
+}
+
 
 FVector AEditableSurface::GetWaypointPosition(int32 Index) const
 {
@@ -280,6 +418,12 @@ void AEditableSurface::SetLoopRemovalThreshold(float NewValue)
     GenerateMesh();
 }
 
+void AEditableSurface::SetAdaptiveSampling(bool bNewAdaptiveSampling)
+{
+    bAdaptiveSampling = bNewAdaptiveSampling;
+    GenerateMesh();
+}
+
 void AEditableSurface::SetEnableThickness(bool bNewEnableThickness)
 {
     bEnableThickness = bNewEnableThickness;
@@ -335,6 +479,97 @@ void AEditableSurface::SetTextureMapping(ESurfaceTextureMapping NewTextureMappin
     GenerateMesh();
 }
 
+FEditableSurfaceParams AEditableSurface::GetParams() const
+{
+    FEditableSurfaceParams Params;
+    Params.Waypoints = Waypoints;
+    Params.CurveType = CurveType;
+    Params.SurfaceWidth = SurfaceWidth;
+    Params.SplineSampleStep = SplineSampleStep;
+    Params.LoopRemovalThreshold = LoopRemovalThreshold;
+    Params.bAdaptiveSampling = bAdaptiveSampling;
+    Params.AdaptiveAngleTolerance = AdaptiveAngleTolerance;
+    Params.AdaptiveChordTolerance = AdaptiveChordTolerance;
+    Params.AdaptiveMaxStep = AdaptiveMaxStep;
+    Params.bEnableThickness = bEnableThickness;
+    Params.ThicknessValue = ThicknessValue;
+    Params.SideSmoothness = SideSmoothness;
+    Params.RightSlopeLength = RightSlopeLength;
+    Params.RightSlopeGradient = RightSlopeGradient;
+    Params.LeftSlopeLength = LeftSlopeLength;
+    Params.LeftSlopeGradient = LeftSlopeGradient;
+    Params.TextureMapping = TextureMapping;
+
+    if (SplineComponent)
+    {
+        Params.SplineCurves = SplineComponent->SplineCurves;
+        Params.DefaultUpVector = SplineComponent->DefaultUpVector;
+    }
+
+    return Params;
+}
+
+FModelGenParamsHash AEditableSurface::GetShapeParamsHash() const
+{
+    return ComputeShapeHash(GetParams());
+}
+
+FModelGenParamsHash AEditableSurface::ComputeShapeHash(const FEditableSurfaceParams& Params)
+{
+    const FModelGenParamsHash ReflectedHash = FModelGenParamsHash::Compute(Params);
+
+    TArray<uint8> Bytes;
+    auto Write = [&Bytes](const void* Data, int32 NumBytes)
+    {
+        Bytes.Append(static_cast<const uint8*>(Data), NumBytes);
+    };
+
+    Write(&ReflectedHash.Low, sizeof(uint64));
+    Write(&ReflectedHash.High, sizeof(uint64));
+    Write(&Params.DefaultUpVector, sizeof(FVector));
+
+    const FSplineCurves& Curves = Params.SplineCurves;
+    const uint8 bLooped = Curves.Position.bIsLooped ? 1 : 0;
+    const int32 NumPoints = Curves.Position.Points.Num();
+    Write(&bLooped, sizeof(uint8));
+    Write(&NumPoints, sizeof(int32));
+
+    for (const FInterpCurvePoint<FVector>& Position : Curves.Position.Points)
+    {
+        const uint8 InterpMode = Position.InterpMode;
+        Write(&Position.InVal, sizeof(float));
+        Write(&Position.OutVal, sizeof(FVector));
+        Write(&Position.ArriveTangent, sizeof(FVector));
+        Write(&Position.LeaveTangent, sizeof(FVector));
+        Write(&InterpMode, sizeof(uint8));
+    }
+
+    for (const FInterpCurvePoint<FQuat>& Rotation : Curves.Rotation.Points)
+    {
+        Write(&Rotation.OutVal, sizeof(FQuat));
+        Write(&Rotation.ArriveTangent, sizeof(FQuat));
+        Write(&Rotation.LeaveTangent, sizeof(FQuat));
+    }
+
+    for (const FInterpCurvePoint<FVector>& Scale : Curves.Scale.Points)
+    {
+        Write(&Scale.OutVal, sizeof(FVector));
+        Write(&Scale.ArriveTangent, sizeof(FVector));
+        Write(&Scale.LeaveTangent, sizeof(FVector));
+    }
+
+    // 距离与参数的映射决定采样位置，其精度随 ReparamStepsPerSegment 变化
+    const int32 NumReparamPoints = Curves.ReparamTable.Points.Num();
+    Write(&NumReparamPoints, sizeof(int32));
+    for (const FInterpCurvePoint<float>& Reparam : Curves.ReparamTable.Points)
+    {
+        Write(&Reparam.InVal, sizeof(float));
+        Write(&Reparam.OutVal, sizeof(float));
+    }
+
+    return FModelGenParamsHash::ComputeBytes(Bytes.GetData(), Bytes.Num());
+}
+
 bool AEditableSurface::IsValid() const
 {
     return SplineComponent != nullptr && Waypoints.Num() >= 2;
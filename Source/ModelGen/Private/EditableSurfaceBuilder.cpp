@@ -1,36 +1,53 @@
 #include "EditableSurfaceBuilder.h"
 #include "ModelGenConstants.h"
-#include "Components/SplineComponent.h"
+#include "ModelGenStats.h"
 
-FEditableSurfaceBuilder::FEditableSurfaceBuilder(const AEditableSurface& InSurface)
-    : Surface(InSurface)
+FEditableSurfaceBuilder::FEditableSurfaceBuilder(const FEditableSurfaceParams& InParams)
+    : Params(InParams)
 {
-    SplineComponent = InSurface.SplineComponent;
-    SurfaceWidth = InSurface.SurfaceWidth;
-    SplineSampleStep = InSurface.SplineSampleStep;
-    LoopRemovalThreshold = InSurface.LoopRemovalThreshold;
+    SurfaceWidth = Params.SurfaceWidth;
+    SplineSampleStep = Params.SplineSampleStep;
+    LoopRemovalThreshold = Params.LoopRemovalThreshold;
     
     if (SplineSampleStep < 1.0f) SplineSampleStep = 10.0f;
     if (LoopRemovalThreshold < 1.0f) LoopRemovalThreshold = 10.0f;
 
-    bEnableThickness = InSurface.bEnableThickness;
-    ThicknessValue = InSurface.ThicknessValue;
-    SideSmoothness = InSurface.SideSmoothness;
-    RightSlopeLength = InSurface.RightSlopeLength;
-    RightSlopeGradient = InSurface.RightSlopeGradient;
-    LeftSlopeLength = InSurface.LeftSlopeLength;
-    LeftSlopeGradient = InSurface.LeftSlopeGradient;
-    TextureMapping = InSurface.TextureMapping;
+    bAdaptiveSampling = Params.bAdaptiveSampling;
+    AdaptiveAngleTolerance = FMath::Max(Params.AdaptiveAngleTolerance, 0.1f);
+    AdaptiveChordTolerance = FMath::Max(Params.AdaptiveChordTolerance, 0.01f);
+    AdaptiveMaxStep = FMath::Max(Params.AdaptiveMaxStep, SplineSampleStep);
+
+    bEnableThickness = Params.bEnableThickness;
+    ThicknessValue = Params.ThicknessValue;
+    SideSmoothness = Params.SideSmoothness;
+    RightSlopeLength = Params.RightSlopeLength;
+    RightSlopeGradient = Params.RightSlopeGradient;
+    LeftSlopeLength = Params.LeftSlopeLength;
+    LeftSlopeGradient = Params.LeftSlopeGradient;
+    TextureMapping = Params.TextureMapping;
+
+    RangeStartDistance = 0.0f;
+    RangeEndDistance = (Params.GetNumSplinePoints() >= 2) ? Params.GetSplineLength() : 0.0f;
+    bHasDistanceRange = false;
 
     Clear();
 }
 
+void FEditableSurfaceBuilder::SetDistanceRange(float StartDistance, float EndDistance)
+{
+    const float SplineLen = Params.GetSplineLength();
+    RangeStartDistance = FMath::Clamp(StartDistance, 0.0f, SplineLen);
+    RangeEndDistance = FMath::Clamp(EndDistance, RangeStartDistance, SplineLen);
+    bHasDistanceRange = true;
+}
+
 void FEditableSurfaceBuilder::Clear()
 {
     FModelGenMeshBuilder::Clear();
     
     SampledPath.Empty();
     PathCornerData.Empty();
+    AdaptiveRailFractions.Empty();
     
     LeftRailRaw.Empty();
     LeftRailRaw.Empty();
@@ -46,7 +63,7 @@ void FEditableSurfaceBuilder::Clear()
 int32 FEditableSurfaceBuilder::CalculateVertexCountEstimate() const
 {
     int32 ProfilePointCount = 2 + (SideSmoothness * 2);
-    float SplineLength = SplineComponent ? SplineComponent->GetSplineLength() : 1000.0f;
+    float SplineLength = (Params.GetNumSplinePoints() >= 2) ? (RangeEndDistance - RangeStartDistance) : 1000.0f;
     int32 PathSampleCount = FMath::CeilToInt(SplineLength / SplineSampleStep) + 1;
     int32 BaseCount = PathSampleCount * ProfilePointCount;
     return bEnableThickness ? BaseCount * 2 + (PathSampleCount * 2) : BaseCount;
@@ -147,9 +164,35 @@ void FEditableSurfaceBuilder::CalculateCornerGeometry()
     }
 }
 
+TUniquePtr<FModelGenMeshBuilder> FEditableSurfaceBuilder::CreateReducedBuilder(float TessellationScale) const
+{
+    if (TessellationScale <= 0.0f)
+    {
+        return nullptr;
+    }
+
+    const float Coarsen = 1.0f / TessellationScale;
+
+    FEditableSurfaceParams Reduced = Params;
+    Reduced.SplineSampleStep = FMath::Min(SplineSampleStep * Coarsen, 1000.0f);
+    Reduced.AdaptiveAngleTolerance = FMath::Min(AdaptiveAngleTolerance * Coarsen, 45.0f);
+    Reduced.AdaptiveChordTolerance = FMath::Min(AdaptiveChordTolerance * Coarsen, 100.0f);
+    Reduced.SideSmoothness = ScaleSegmentCount(SideSmoothness, TessellationScale, 1);
+
+    if (FMath::IsNearlyEqual(Reduced.SplineSampleStep, SplineSampleStep) && Reduced.SideSmoothness == SideSmoothness &&
+        (!bAdaptiveSampling || FMath::IsNearlyEqual(Reduced.AdaptiveAngleTolerance, AdaptiveAngleTolerance)))
+    {
+        return nullptr;
+    }
+
+    return MakeUnique<FEditableSurfaceBuilder>(Reduced);
+}
+
 bool FEditableSurfaceBuilder::Generate(FModelGenMeshData& OutMeshData)
 {
-    if (!SplineComponent || SplineComponent->GetNumberOfSplinePoints() < 2)
+    MODELGEN_GENERATE_SCOPE(OutMeshData);
+
+    if (Params.GetNumSplinePoints() < 2)
     {
         return false;
     }
@@ -162,6 +205,11 @@ bool FEditableSurfaceBuilder::Generate(FModelGenMeshData& OutMeshData)
     }
 
     SampleSplinePath();
+    if (SampledPath.Num() < 2)
+    {
+        return false;
+    }
+
     CalculateCornerGeometry();
     GenerateRoadSurface();
     
@@ -220,33 +268,111 @@ bool FEditableSurfaceBuilder::Generate(FModelGenMeshData& OutMeshData)
 
 void FEditableSurfaceBuilder::SampleSplinePath()
 {
-    if (!SplineComponent) return;
+    if (bAdaptiveSampling)
+    {
+        SampleSplinePathAdaptive();
+        return;
+    }
 
-    float SplineLen = SplineComponent->GetSplineLength();
-    int32 NumSteps = FMath::CeilToInt(SplineLen / SplineSampleStep);
+    int32 NumSteps = FMath::CeilToInt((RangeEndDistance - RangeStartDistance) / SplineSampleStep);
 
     SampledPath.Reserve(NumSteps + 1);
 
     for (int32 i = 0; i <= NumSteps; ++i)
     {
-        float Dist = FMath::Min(static_cast<float>(i) * SplineSampleStep, SplineLen);
-        
-        FSurfaceSamplePoint Point;
-        Point.Distance = Dist;
-        Point.Alpha = (SplineLen > KINDA_SMALL_NUMBER) ? (Dist / SplineLen) : 0.0f;
-        
-        FTransform TF = SplineComponent->GetTransformAtDistanceAlongSpline(Dist, ESplineCoordinateSpace::Local);
-        
-        Point.Location = TF.GetLocation();
-        Point.Tangent = TF.GetUnitAxis(EAxis::X);
-        Point.RightVector = TF.GetUnitAxis(EAxis::Y);
-        Point.Normal = TF.GetUnitAxis(EAxis::Z);
+        float Dist = FMath::Min(RangeStartDistance + static_cast<float>(i) * SplineSampleStep, RangeEndDistance);
+        SampledPath.Add(MakeSamplePoint(Dist));
+    }
+}
+
+FSurfaceSamplePoint FEditableSurfaceBuilder::MakeSamplePoint(float Distance) const
+{
+    float SplineLen = Params.GetSplineLength();
+
+    FSurfaceSamplePoint Point;
+    Point.Distance = Distance;
+    Point.Alpha = (SplineLen > KINDA_SMALL_NUMBER) ? (Distance / SplineLen) : 0.0f;
 
-        FVector Scale = SplineComponent->GetScaleAtDistanceAlongSpline(Dist);
-        Point.InterpolatedWidth = Scale.Y;
+    FTransform TF = Params.GetTransformAtDistance(Distance);
+
+    Point.Location = TF.GetLocation();
+    Point.Tangent = TF.GetUnitAxis(EAxis::X);
+    Point.RightVector = TF.GetUnitAxis(EAxis::Y);
+    Point.Normal = TF.GetUnitAxis(EAxis::Z);
+
+    FVector Scale = Params.GetScaleAtDistance(Distance);
+    Point.InterpolatedWidth = Scale.Y;
+
+    return Point;
+}
+
+void FEditableSurfaceBuilder::SampleSplinePathAdaptive()
+{
+    const float RangeLen = RangeEndDistance - RangeStartDistance;
+    const float CosAngleTolerance = FMath::Cos(FMath::DegreesToRadians(AdaptiveAngleTolerance));
+
+    // 先按最大步长均匀分段，再在不满足容差的段内二分加密，最小不低于 SplineSampleStep
+    const int32 NumSpans = FMath::Max(1, FMath::CeilToInt(RangeLen / AdaptiveMaxStep));
+
+    SampledPath.Reset();
+    SampledPath.Add(MakeSamplePoint(RangeStartDistance));
+
+    for (int32 i = 1; i <= NumSpans; ++i)
+    {
+        const float Dist = (i == NumSpans) ? RangeEndDistance : RangeStartDistance + RangeLen * static_cast<float>(i) / static_cast<float>(NumSpans);
+
+        // 递归过程中会向 SampledPath 追加元素，起点需要按值拷贝
+        const FSurfaceSamplePoint Start = SampledPath.Last();
+        const FSurfaceSamplePoint End = MakeSamplePoint(Dist);
+
+        SubdivideSampleSpan(Start, End, CosAngleTolerance);
+        SampledPath.Add(End);
+    }
+
+    AdaptiveRailFractions.Reset(SampledPath.Num());
+    for (const FSurfaceSamplePoint& Point : SampledPath)
+    {
+        AdaptiveRailFractions.Add((RangeLen > KINDA_SMALL_NUMBER) ? (Point.Distance - RangeStartDistance) / RangeLen : 0.0f);
+    }
+}
+
+void FEditableSurfaceBuilder::SubdivideSampleSpan(const FSurfaceSamplePoint& Start, const FSurfaceSamplePoint& End, float CosAngleTolerance)
+{
+    const float Span = End.Distance - Start.Distance;
+    if (Span < SplineSampleStep * 2.0f)
+    {
+        return;
+    }
+
+    const FSurfaceSamplePoint Mid = MakeSamplePoint(Start.Distance + Span * 0.5f);
+    if (!NeedsSubdivision(Start, Mid, End, CosAngleTolerance))
+    {
+        return;
+    }
+
+    SubdivideSampleSpan(Start, Mid, CosAngleTolerance);
+    SampledPath.Add(Mid);
+    SubdivideSampleSpan(Mid, End, CosAngleTolerance);
+}
+
+bool FEditableSurfaceBuilder::NeedsSubdivision(const FSurfaceSamplePoint& Start, const FSurfaceSamplePoint& Mid, const FSurfaceSamplePoint& End, float CosAngleTolerance) const
+{
+    // 方向或倾斜变化超过角度容差
+    if (FVector::DotProduct(Start.Tangent, End.Tangent) < CosAngleTolerance ||
+        FVector::DotProduct(Start.Tangent, Mid.Tangent) < CosAngleTolerance ||
+        FVector::DotProduct(Start.Normal, End.Normal) < CosAngleTolerance)
+    {
+        return true;
+    }
 
-        SampledPath.Add(Point);
+    // 中点偏离弦线，或宽度不再线性变化
+    if (FMath::PointDistToSegment(Mid.Location, Start.Location, End.Location) > AdaptiveChordTolerance)
+    {
+        return true;
     }
+
+    const float LinearWidth = (Start.InterpolatedWidth + End.InterpolatedWidth) * 0.5f;
+    return FMath::Abs(Mid.InterpolatedWidth - LinearWidth) * 0.5f > AdaptiveChordTolerance;
 }
 
 void FEditableSurfaceBuilder::GenerateRoadSurface()
@@ -352,6 +478,7 @@ void FEditableSurfaceBuilder::BuildRawRails()
     RightRailRaw.Reset(NumPoints);
 
     float HalfWidth = SurfaceWidth * 0.5f;
+    const bool bHasFractions = AdaptiveRailFractions.Num() == NumPoints;
     FVector LastValidLeftPos = FVector::ZeroVector;
     FVector LastValidRightPos = FVector::ZeroVector;
 
@@ -377,11 +504,14 @@ void FEditableSurfaceBuilder::BuildRawRails()
         float U_Left = 0.0f;
         float U_Right = ActualPhysicalWidth * ModelGenConstants::GLOBAL_UV_SCALE;
 
+        const float PathFraction = bHasFractions ? AdaptiveRailFractions[i] : ((NumPoints > 1) ? static_cast<float>(i) / static_cast<float>(NumPoints - 1) : 0.0f);
+
         FRailPoint LPoint;
         LPoint.Position = LeftPos;
         LPoint.Normal = Sample.Normal;
         LPoint.Tangent = Sample.Tangent;
         LPoint.UV = FVector2D(U_Left, 0.0f);
+        LPoint.PathFraction = PathFraction;
         LeftRailRaw.Add(LPoint);
 
         FRailPoint RPoint;
@@ -389,6 +519,7 @@ void FEditableSurfaceBuilder::BuildRawRails()
         RPoint.Normal = Sample.Normal;
         RPoint.Tangent = Sample.Tangent;
         RPoint.UV = FVector2D(U_Right, 0.0f);
+        RPoint.PathFraction = PathFraction;
         RightRailRaw.Add(RPoint);
     }
 }
@@ -444,7 +575,9 @@ void FEditableSurfaceBuilder::ResampleSingleRail(const TArray<FRailPoint>& InPoi
         return;
     }
 
-    int32 NumSegments = FMath::Max(1, FMath::CeilToInt(TotalLength / SegmentLength));
+    // 自适应采样时不按各自弧长均分，而是在同一组中心线参数处取点：内外侧弧长不同，按弧长比例会让左右点在弯道处错位
+    const bool bUseFractions = AdaptiveRailFractions.Num() >= 2;
+    int32 NumSegments = bUseFractions ? AdaptiveRailFractions.Num() - 1 : FMath::Max(1, FMath::CeilToInt(TotalLength / SegmentLength));
     float ActualStep = TotalLength / NumSegments;
 
     OutPoints.Reset(NumSegments + 1);
@@ -452,11 +585,22 @@ void FEditableSurfaceBuilder::ResampleSingleRail(const TArray<FRailPoint>& InPoi
 
     for (int32 i = 0; i <= NumSegments; ++i)
     {
+        const float TargetFraction = bUseFractions ? AdaptiveRailFractions[i] : 0.0f;
         float TargetDist = static_cast<float>(i) * ActualStep;
 
-        while (CurrentIndex < AccumulatedDists.Num() - 1 && AccumulatedDists[CurrentIndex + 1] < TargetDist)
+        if (bUseFractions)
+        {
+            while (CurrentIndex < InPoints.Num() - 1 && InPoints[CurrentIndex + 1].PathFraction < TargetFraction)
+            {
+                CurrentIndex++;
+            }
+        }
+        else
         {
-            CurrentIndex++;
+            while (CurrentIndex < AccumulatedDists.Num() - 1 && AccumulatedDists[CurrentIndex + 1] < TargetDist)
+            {
+                CurrentIndex++;
+            }
         }
 
         if (CurrentIndex >= InPoints.Num() - 1)
@@ -471,13 +615,25 @@ void FEditableSurfaceBuilder::ResampleSingleRail(const TArray<FRailPoint>& InPoi
             continue;
         }
 
+        const FRailPoint& P0 = InPoints[CurrentIndex];
+        const FRailPoint& P1 = InPoints[CurrentIndex + 1];
+
         float StartD = AccumulatedDists[CurrentIndex];
         float EndD = AccumulatedDists[CurrentIndex + 1];
         float Span = EndD - StartD;
-        float Alpha = (Span > KINDA_SMALL_NUMBER) ? (TargetDist - StartD) / Span : 0.0f;
+        float Alpha = 0.0f;
 
-        const FRailPoint& P0 = InPoints[CurrentIndex];
-        const FRailPoint& P1 = InPoints[CurrentIndex + 1];
+        if (bUseFractions)
+        {
+            // 去环时删掉的点会让参数跨度变大，此时在保留下来的两点之间插值，另一侧仍取同一参数
+            float FractionSpan = P1.PathFraction - P0.PathFraction;
+            Alpha = (FractionSpan > KINDA_SMALL_NUMBER) ? FMath::Clamp((TargetFraction - P0.PathFraction) / FractionSpan, 0.0f, 1.0f) : 0.0f;
+            TargetDist = StartD + Span * Alpha;
+        }
+        else
+        {
+            Alpha = (Span > KINDA_SMALL_NUMBER) ? (TargetDist - StartD) / Span : 0.0f;
+        }
 
         FVector T0 = GeoTangents[CurrentIndex] * Span;
         FVector T1 = GeoTangents[CurrentIndex + 1] * Span;
@@ -488,6 +644,7 @@ void FEditableSurfaceBuilder::ResampleSingleRail(const TArray<FRailPoint>& InPoi
         NewPt.Tangent = FMath::Lerp(P0.Tangent, P1.Tangent, Alpha).GetSafeNormal();
         NewPt.UV.X = P0.UV.X;
         NewPt.DistanceAlongRail = TargetDist;
+        NewPt.PathFraction = FMath::Lerp(P0.PathFraction, P1.PathFraction, Alpha);
 
         float V = TargetDist * ModelGenConstants::GLOBAL_UV_SCALE;
         NewPt.UV.Y = V;
@@ -526,45 +683,95 @@ void FEditableSurfaceBuilder::RemoveGeometricLoops(TArray<FRailPoint>& InPoints,
 {
     if (InPoints.Num() < 4) return;
 
-    float ThresholdSq = Threshold * Threshold;
-    bool bLoopFound = true;
+    const int32 NumPoints = InPoints.Num();
+    const float ThresholdSq = Threshold * Threshold;
+    // 格子边长不小于阈值即可保证邻域查找正确；下限 1 厘米使格子坐标在世界范围内不会溢出 int32
+    const float InvCellSize = 1.0f / FMath::Max(Threshold, 1.0f);
 
-    int32 MaxIterations = 10; 
-    int32 Iter = 0;
+    // 至多去掉的环数，与原先逐轮重扫的迭代上限一致
+    const int32 MaxLoops = 10;
 
-    while (bLoopFound && Iter < MaxIterations)
+    // 以阈值为边长的均匀网格：距离小于阈值的点只可能落在相邻的 3x3x3 个格子里
+    auto GetCell = [InvCellSize](const FVector& Position)
     {
-        bLoopFound = false;
-        
-        for (int32 i = 0; i < InPoints.Num() - 2; ++i)
-        {
-            int32 BestJ = -1;
+        return FIntVector(
+            FMath::FloorToInt(Position.X * InvCellSize),
+            FMath::FloorToInt(Position.Y * InvCellSize),
+            FMath::FloorToInt(Position.Z * InvCellSize));
+    };
+
+    TMap<FIntVector, int32> CellHeads;
+    CellHeads.Reserve(NumPoints);
+    TArray<int32> NextInCell;
+    NextInCell.SetNumUninitialized(NumPoints);
+
+    for (int32 i = 0; i < NumPoints; ++i)
+    {
+        int32& Head = CellHeads.FindOrAdd(GetCell(InPoints[i].Position), INDEX_NONE);
+        NextInCell[i] = Head;
+        Head = i;
+    }
+
+    // 原算法每删一个环都从头重扫，但删点不会让更靠前的点产生新的匹配，
+    // 所以等价于单遍扫描：对每个 i 找距离小于阈值的最远 j（j > i + 1），删去其间的点后从 j 继续。
+    // 扫描到 i 时其后的点都尚未被删，因此只需按原始下标判断
+    TBitArray<> Keep(true, NumPoints);
+    int32 LoopCount = 0;
+    int32 i = 0;
 
-            for (int32 j = InPoints.Num() - 1; j > i + 1; --j)
+    while (i < NumPoints - 2 && LoopCount < MaxLoops)
+    {
+        const FVector& Position = InPoints[i].Position;
+        const FIntVector Cell = GetCell(Position);
+        int32 BestJ = INDEX_NONE;
+
+        for (int32 DZ = -1; DZ <= 1; ++DZ)
+        {
+            for (int32 DY = -1; DY <= 1; ++DY)
             {
-                float DistSq = FVector::DistSquared(InPoints[i].Position, InPoints[j].Position);
-                
-                if (DistSq < ThresholdSq)
+                for (int32 DX = -1; DX <= 1; ++DX)
                 {
-                    BestJ = j;
-                    break;
+                    const int32* Head = CellHeads.Find(Cell + FIntVector(DX, DY, DZ));
+                    for (int32 j = Head ? *Head : INDEX_NONE; j != INDEX_NONE; j = NextInCell[j])
+                    {
+                        if (j > i + 1 && j > BestJ && FVector::DistSquared(Position, InPoints[j].Position) < ThresholdSq)
+                        {
+                            BestJ = j;
+                        }
+                    }
                 }
             }
+        }
 
-            if (BestJ != -1)
+        if (BestJ != INDEX_NONE)
+        {
+            for (int32 k = i + 1; k < BestJ; ++k)
             {
-                int32 CountToRemove = BestJ - i - 1;
-                
-                if (CountToRemove > 0)
-                {
-                    InPoints.RemoveAt(i + 1, CountToRemove);
-                    bLoopFound = true;
-                    break; // 数组变了，跳出 for 循环，重新开始下一轮 while
-                }
+                Keep[k] = false;
             }
+            ++LoopCount;
+            i = BestJ;
+        }
+        else
+        {
+            ++i;
+        }
+    }
+
+    if (LoopCount == 0)
+    {
+        return;
+    }
+
+    int32 WriteIndex = 0;
+    for (int32 ReadIndex = 0; ReadIndex < NumPoints; ++ReadIndex)
+    {
+        if (Keep[ReadIndex])
+        {
+            InPoints[WriteIndex++] = InPoints[ReadIndex];
         }
-        Iter++;
     }
+    InPoints.SetNum(WriteIndex, false);
 }
 
 void FEditableSurfaceBuilder::StitchRailsInternal(int32 LeftStartIdx, int32 RightStartIdx, int32 LeftCount, int32 RightCount, bool bReverseWinding)
@@ -729,6 +936,7 @@ void FEditableSurfaceBuilder::BuildNextSlopeRail(const TArray<FRailPoint>& Refer
         NewPt.Normal = SlopeNormal;
         NewPt.Tangent = AvgTangent;
         NewPt.UV = RefPt.UV;
+        NewPt.PathFraction = RefPt.PathFraction;
 
         RawPoints.Add(NewPt);
     }
@@ -868,8 +1076,16 @@ void FEditableSurfaceBuilder::GenerateThickness()
         EndCapNormal = AvgEndTan;
     }
 
-    BuildCap(TopStartIndices, true, StartCapNormal);
-    BuildCap(TopEndIndices, false, EndCapNormal);
+    // 分块生成时只有触及样条两端的分块才封口，中间接缝保持开放
+    const float SplineLen = Params.GetSplineLength();
+    if (RangeStartDistance <= KINDA_SMALL_NUMBER)
+    {
+        BuildCap(TopStartIndices, true, StartCapNormal);
+    }
+    if (RangeEndDistance >= SplineLen - KINDA_SMALL_NUMBER)
+    {
+        BuildCap(TopEndIndices, false, EndCapNormal);
+    }
 }
 
 void FEditableSurfaceBuilder::BuildSideWall(const TArray<FRailPoint>& Rail, bool bIsRightSide)
@@ -877,6 +1093,7 @@ void FEditableSurfaceBuilder::BuildSideWall(const TArray<FRailPoint>& Rail, bool
     if (Rail.Num() < 2) return;
 
     float V_Bottom = ThicknessValue * ModelGenConstants::GLOBAL_UV_SCALE;
+    float USnapScale = GetTileSnapScale(Rail.Last().DistanceAlongRail * ModelGenConstants::GLOBAL_UV_SCALE);
 
     for (int32 i = 0; i < Rail.Num() - 1; ++i)
     {
@@ -901,8 +1118,8 @@ void FEditableSurfaceBuilder::BuildSideWall(const TArray<FRailPoint>& Rail, bool
         FVector BotPos0 = TopPos0 - (P0.Normal * ThicknessValue);
         FVector BotPos1 = TopPos1 - (P1.Normal * ThicknessValue);
 
-        float U0 = P0.DistanceAlongRail * ModelGenConstants::GLOBAL_UV_SCALE;
-        float U1 = P1.DistanceAlongRail * ModelGenConstants::GLOBAL_UV_SCALE;
+        float U0 = P0.DistanceAlongRail * ModelGenConstants::GLOBAL_UV_SCALE * USnapScale;
+        float U1 = P1.DistanceAlongRail * ModelGenConstants::GLOBAL_UV_SCALE * USnapScale;
 
         int32 V_TL = AddVertex(TopPos0, Normal0, FVector2D(U0, 0.0f));
         int32 V_TR = AddVertex(TopPos1, Normal1, FVector2D(U1, 0.0f));
@@ -980,4 +1197,23 @@ void FEditableSurfaceBuilder::CorrectRailUVs(TArray<FRailPoint>& Rail, float Tar
             Pt.UV.Y = Ratio * TargetTotalLength * ModelGenConstants::GLOBAL_UV_SCALE;
         }
     }
-}
\ No newline at end of file
+
+    const float VSnapScale = GetTileSnapScale(Rail.Last().UV.Y);
+    if (VSnapScale != 1.0f)
+    {
+        for (FRailPoint& Pt : Rail)
+        {
+            Pt.UV.Y *= VSnapScale;
+        }
+    }
+}
+
+float FEditableSurfaceBuilder::GetTileSnapScale(float UVSpan) const
+{
+    if (!bHasDistanceRange || UVSpan < KINDA_SMALL_NUMBER)
+    {
+        return 1.0f;
+    }
+
+    return FMath::Max(1.0f, FMath::RoundToFloat(UVSpan)) / UVSpan;
+}
@@ -11,7 +11,10 @@ AFrustum::AFrustum()
 
 void AFrustum::GenerateMesh()
 {
-    TryGenerateMeshInternal();
+    if (!TryGenerateMeshInternal())
+    {
+        ClearGeneratedMesh();
+    }
 }
 
 bool AFrustum::TryGenerateMeshInternal()
@@ -21,63 +24,56 @@ bool AFrustum::TryGenerateMeshInternal()
         return false;
     }
 
-    FFrustumBuilder Builder(*this);
-    FModelGenMeshData MeshData;
-
-    if (!Builder.Generate(MeshData))
+    if (RefreshInstancedShape())
     {
-        return false;
+        return true;
     }
 
-    if (!MeshData.IsValid())
-    {
-        return false;
-    }
+    const FFrustumParams Params = GetParams();
+    FFrustumBuilder Builder(Params);
+    return GenerateAndApplyMesh(Builder, Params);
+}
 
-    MeshData.ToProceduralMesh(GetProceduralMesh(), 0);
-    return true;
+TUniquePtr<FModelGenMeshBuilder> AFrustum::CreateMeshBuilder() const
+{
+    return MakeUnique<FFrustumBuilder>(GetParams());
 }
 
-bool AFrustum::IsValid() const
+FFrustumParams AFrustum::GetParams() const
 {
-    return TopRadius > 0.0f && BottomRadius > 0.0f && Height > 0.0f &&
-           TopSides >= 3 && TopSides <= 25 && BottomSides >= 3 && BottomSides <= 25 && HeightSegments >= 0 && HeightSegments <= 12 &&
-           BevelRadius >= 0.0f && 
-           MinBendRadius >= 0.0f && ArcAngle > 0.0f && ArcAngle <= 360.0f;
+    FFrustumParams Params;
+    Params.TopRadius = TopRadius;
+    Params.BottomRadius = BottomRadius;
+    Params.Height = Height;
+    Params.TopSides = TopSides;
+    Params.BottomSides = BottomSides;
+    Params.HeightSegments = HeightSegments;
+    Params.BevelRadius = BevelRadius;
+    Params.BevelSegments = BevelSegments;
+    Params.BendAmount = BendAmount;
+    Params.MinBendRadius = MinBendRadius;
+    Params.ArcAngle = ArcAngle;
+    return Params;
 }
 
-int32 AFrustum::CalculateVertexCountEstimate() const
+FModelGenParamsHash AFrustum::GetShapeParamsHash() const
 {
-    if (!IsValid()) return 0;
+    return FModelGenParamsHash::Compute(GetParams());
+}
 
-    const int32 MaxSides = FMath::Max(TopSides, BottomSides);
-    const int32 BaseVertices = TopSides + BottomSides + 2; // 加中心点
-    const int32 SideVertices = (HeightSegments + 1) * MaxSides; // 包括顶部和底部
-    
-    int32 BevelVertices = 0;
-    if (BevelRadius > 0.0f && BevelSegments > 0)
-    {
-        BevelVertices = (TopSides + BottomSides) * (BevelSegments + 1) * 2; // 顶部和底部倒角，每个有 (Segments + 1) 环
-    }
+bool AFrustum::IsValid() const
+{
+    return GetParams().IsValid();
+}
 
-    return BaseVertices + SideVertices + BevelVertices;
+int32 AFrustum::CalculateVertexCountEstimate() const
+{
+    return GetParams().CalculateVertexCountEstimate();
 }
 
 int32 AFrustum::CalculateTriangleCountEstimate() const
 {
-    if (!IsValid()) return 0;
-
-    const int32 MaxSides = FMath::Max(TopSides, BottomSides);
-    const int32 BaseTriangles = TopSides + BottomSides;
-    const int32 SideTriangles = HeightSegments * MaxSides * 2;
-    
-    int32 BevelTriangles = 0;
-    if (BevelRadius > 0.0f && BevelSegments > 0)
-    {
-        BevelTriangles = (TopSides + BottomSides) * BevelSegments * 2 * 2; // 每个倒角部分有 Segments 个 quad
-    }
-
-    return BaseTriangles + SideTriangles + BevelTriangles;
+    return GetParams().CalculateTriangleCountEstimate();
 }
 
 void AFrustum::SetTopRadius(float NewTopRadius)
@@ -1,12 +1,13 @@
 // Copyright (c) 2024. All rights reserved.
 
 #include "FrustumBuilder.h"
-#include "Frustum.h"
 #include "ModelGenMeshData.h"
+#include "PhysicsEngine/AggregateGeom.h"
 #include "ModelGenConstants.h"
+#include "ModelGenStats.h"
 
-FFrustumBuilder::FFrustumBuilder(const AFrustum& InFrustum)
-    : Frustum(InFrustum)
+FFrustumBuilder::FFrustumBuilder(const FFrustumParams& InParams)
+    : Params(InParams)
 {
     Clear();
 }
@@ -26,7 +27,9 @@ void FFrustumBuilder::Clear()
 
 bool FFrustumBuilder::Generate(FModelGenMeshData& OutMeshData)
 {
-    if (!Frustum.IsValid())
+    MODELGEN_GENERATE_SCOPE(OutMeshData);
+
+    if (!Params.IsValid())
     {
         return false;
     }
@@ -34,9 +37,9 @@ bool FFrustumBuilder::Generate(FModelGenMeshData& OutMeshData)
     Clear();
     ReserveMemory();
 
-    const float MinDimension = FMath::Min(Frustum.TopRadius, Frustum.BottomRadius);
-    bEnableBevel = (Frustum.BevelRadius > KINDA_SMALL_NUMBER) &&
-        (Frustum.BevelSegments > 0) &&
+    const float MinDimension = FMath::Min(Params.TopRadius, Params.BottomRadius);
+    bEnableBevel = (Params.BevelRadius > KINDA_SMALL_NUMBER) &&
+        (Params.BevelSegments > 0) &&
         (MinDimension > KINDA_SMALL_NUMBER);
 
     CalculateCommonParams();
@@ -62,24 +65,99 @@ bool FFrustumBuilder::Generate(FModelGenMeshData& OutMeshData)
         return false;
     }
 
-    MeshData.CalculateTangents();
+    // 切线已在生成顶点时解析给出，无需再做整网格切线计算
     OutMeshData = MeshData;
     return true;
 }
 
 int32 FFrustumBuilder::CalculateVertexCountEstimate() const
 {
-    return Frustum.CalculateVertexCountEstimate();
+    return Params.CalculateVertexCountEstimate();
 }
 
 int32 FFrustumBuilder::CalculateTriangleCountEstimate() const
 {
-    return Frustum.CalculateTriangleCountEstimate();
+    return Params.CalculateTriangleCountEstimate();
+}
+
+bool FFrustumBuilder::GenerateSimpleCollision(FKAggregateGeom& OutGeom) const
+{
+    if (!Params.IsValid())
+    {
+        return false;
+    }
+
+    const float ArcRadians = FMath::DegreesToRadians(Params.ArcAngle);
+    const float ArcStart = -ArcRadians / 2.0f;
+    const bool bFullCircle = Params.ArcAngle >= 360.0f - 0.01f;
+    const bool bBent = FMath::Abs(Params.BendAmount) > KINDA_SMALL_NUMBER;
+
+    // 未弯曲的台体是凸体：整圈一个凸包，非整圈按不超过 180 度的扇区切开；弯曲时再沿高度分段
+    const int32 SectorCount = bFullCircle ? 1 : FMath::CeilToInt(Params.ArcAngle / 180.0f);
+    const int32 HeightBands = bBent ? 4 : 1;
+    const float SectorStep = ArcRadians / SectorCount;
+
+    auto AppendRing = [&](float HeightRatio, float FromAngle, float ToAngle, TArray<FVector>& OutPoints)
+    {
+        const bool bTop = HeightRatio >= 1.0f - KINDA_SMALL_NUMBER;
+        const int32 Sides = bTop ? Params.TopSides : Params.BottomSides;
+        float Radius = FMath::Lerp(Params.BottomRadius, Params.TopRadius, HeightRatio);
+
+        if (bBent)
+        {
+            const bool bCapRing = HeightRatio < KINDA_SMALL_NUMBER || bTop;
+            Radius *= 1.0f - Params.BendAmount * FMath::Sin(HeightRatio * PI);
+            if (!bCapRing)
+            {
+                Radius = FMath::Max(Radius, Params.MinBendRadius);
+            }
+        }
+
+        const float Z = Params.Height * HeightRatio;
+        AppendPolygonArcPoints(Radius, Sides, ArcStart, ArcRadians, FromAngle, ToAngle, Z, OutPoints);
+        if (!bFullCircle)
+        {
+            OutPoints.Add(FVector(0.0f, 0.0f, Z));
+        }
+    };
+
+    for (int32 Sector = 0; Sector < SectorCount; ++Sector)
+    {
+        const float FromAngle = ArcStart + Sector * SectorStep;
+        const float ToAngle = FromAngle + SectorStep;
+
+        for (int32 Band = 0; Band < HeightBands; ++Band)
+        {
+            TArray<FVector> Points;
+            AppendRing(static_cast<float>(Band) / HeightBands, FromAngle, ToAngle, Points);
+            AppendRing(static_cast<float>(Band + 1) / HeightBands, FromAngle, ToAngle, Points);
+            AddConvexElem(OutGeom, MoveTemp(Points));
+        }
+    }
+
+    return OutGeom.ConvexElems.Num() > 0;
+}
+
+TUniquePtr<FModelGenMeshBuilder> FFrustumBuilder::CreateReducedBuilder(float TessellationScale) const
+{
+    FFrustumParams Reduced = Params;
+    Reduced.TopSides = ScaleSegmentCount(Params.TopSides, TessellationScale, MinLODSides);
+    Reduced.BottomSides = ScaleSegmentCount(Params.BottomSides, TessellationScale, MinLODSides);
+    Reduced.HeightSegments = ScaleSegmentCount(Params.HeightSegments, TessellationScale, 0);
+    Reduced.BevelSegments = ScaleSegmentCount(Params.BevelSegments, TessellationScale, 1);
+
+    if (Reduced.TopSides == Params.TopSides && Reduced.BottomSides == Params.BottomSides &&
+        Reduced.HeightSegments == Params.HeightSegments && Reduced.BevelSegments == Params.BevelSegments)
+    {
+        return nullptr;
+    }
+
+    return MakeUnique<FFrustumBuilder>(Reduced);
 }
 
 void FFrustumBuilder::CalculateCommonParams()
 {
-    ArcAngleRadians = FMath::DegreesToRadians(Frustum.ArcAngle);
+    ArcAngleRadians = FMath::DegreesToRadians(Params.ArcAngle);
     StartAngle = -ArcAngleRadians / 2.0f;
 }
 
@@ -122,7 +200,7 @@ TArray<int32> FFrustumBuilder::CreateBevelRing(const FRingContext& Context, floa
     TArray<int32> Indices;
     Indices.Reserve(Context.Sides + 1);
 
-    const float HeightRatio = Context.Z / Frustum.Height;
+    const float HeightRatio = Context.Z / Params.Height;
     const float AngleStep = (Context.Sides > 0) ? (ArcAngleRadians / Context.Sides) : 0.0f;
 
     FVector VerticalNormal(0.0f, 0.0f, bIsTopBevel ? 1.0f : -1.0f);
@@ -138,9 +216,9 @@ TArray<int32> FFrustumBuilder::CreateBevelRing(const FRingContext& Context, floa
 
         FVector HorizontalNormal(CosA, SinA, 0.0f);
 
-        if (FMath::Abs(Frustum.BendAmount) > KINDA_SMALL_NUMBER)
+        if (FMath::Abs(Params.BendAmount) > KINDA_SMALL_NUMBER)
         {
-            float BendNormalZ = Frustum.BendAmount * FMath::Cos(HeightRatio * PI);
+            float BendNormalZ = Params.BendAmount * FMath::Cos(HeightRatio * PI);
             HorizontalNormal.Z += BendNormalZ;
             HorizontalNormal.Normalize();
         }
@@ -151,7 +229,10 @@ TArray<int32> FFrustumBuilder::CreateBevelRing(const FRingContext& Context, floa
         float U = (Angle - StartAngle) * UVRadius;
         FVector2D UV(U * ModelGenConstants::GLOBAL_UV_SCALE, VCoord * ModelGenConstants::GLOBAL_UV_SCALE);
 
-        Indices.Add(GetOrAddVertex(Pos, SmoothNormal, UV));
+        // 与侧面相同：U 沿圆周，V 沿母线向外侧向下，副切线与 N x T 反向
+        const FProcMeshTangent Tangent(FVector(-SinA, CosA, 0.0f), true);
+
+        Indices.Add(GetOrAddVertex(Pos, SmoothNormal, UV, Tangent));
     }
 
     return Indices;
@@ -159,10 +240,10 @@ TArray<int32> FFrustumBuilder::CreateBevelRing(const FRingContext& Context, floa
 
 void FFrustumBuilder::GenerateSides()
 {
-    float TopZ = Frustum.Height;
+    float TopZ = Params.Height;
     float BottomZ = 0.0f;
-    float TopR = Frustum.TopRadius;
-    float BottomR = Frustum.BottomRadius;
+    float TopR = Params.TopRadius;
+    float BottomR = Params.BottomRadius;
 
     float TopBevelHeight = 0.0f;
     float BottomBevelHeight = 0.0f;
@@ -170,27 +251,27 @@ void FFrustumBuilder::GenerateSides()
 
     if (bEnableBevel)
     {
-        TopBevelHeight = CalculateBevelHeight(Frustum.TopRadius);
-        BottomBevelHeight = CalculateBevelHeight(Frustum.BottomRadius);
+        TopBevelHeight = CalculateBevelHeight(Params.TopRadius);
+        BottomBevelHeight = CalculateBevelHeight(Params.BottomRadius);
 
-        const float RadiusDiff = Frustum.TopRadius - Frustum.BottomRadius;
-        const float SideLength = FMath::Sqrt(RadiusDiff * RadiusDiff + Frustum.Height * Frustum.Height);
+        const float RadiusDiff = Params.TopRadius - Params.BottomRadius;
+        const float SideLength = FMath::Sqrt(RadiusDiff * RadiusDiff + Params.Height * Params.Height);
 
         if (SideLength > KINDA_SMALL_NUMBER)
         {
             const float RadiusDir = RadiusDiff / SideLength;
-            const float HeightDir = Frustum.Height / SideLength;
+            const float HeightDir = Params.Height / SideLength;
 
-            TopR = Frustum.TopRadius - TopBevelHeight * RadiusDir;
-            TopZ = Frustum.Height - TopBevelHeight * HeightDir;
+            TopR = Params.TopRadius - TopBevelHeight * RadiusDir;
+            TopZ = Params.Height - TopBevelHeight * HeightDir;
 
-            BottomR = Frustum.BottomRadius + BottomBevelHeight * RadiusDir;
+            BottomR = Params.BottomRadius + BottomBevelHeight * RadiusDir;
             BottomZ = BottomBevelHeight * HeightDir;
         }
         else
         {
-            const float MinRadius = FMath::Min(Frustum.TopRadius, Frustum.BottomRadius);
-            const float EffectiveBevel = FMath::Min(Frustum.BevelRadius, MinRadius);
+            const float MinRadius = FMath::Min(Params.TopRadius, Params.BottomRadius);
+            const float EffectiveBevel = FMath::Min(Params.BevelRadius, MinRadius);
             TopZ -= EffectiveBevel;
             BottomZ += EffectiveBevel;
         }
@@ -203,12 +284,12 @@ void FFrustumBuilder::GenerateSides()
 
     float CurrentV = TopBevelArc + TotalSideLength;
 
-    float UVReferenceRadius = FMath::Max(Frustum.TopRadius, Frustum.BottomRadius);
+    float UVReferenceRadius = FMath::Max(Params.TopRadius, Params.BottomRadius);
 
-    TArray<FVector2D> BottomRef = GetRingPos2D(BottomR, Frustum.BottomSides);
-    TArray<FVector2D> TopRef = GetRingPos2D(TopR, Frustum.TopSides);
+    TArray<FVector2D> BottomRef = GetRingPos2D(BottomR, Params.BottomSides);
+    TArray<FVector2D> TopRef = GetRingPos2D(TopR, Params.TopSides);
 
-    const int32 Segments = FMath::Max(1, Frustum.HeightSegments + 1);
+    const int32 Segments = FMath::Max(1, Params.HeightSegments + 1);
     TArray<TArray<int32>> Rings;
     Rings.Reserve(Segments + 1);
 
@@ -219,7 +300,7 @@ void FFrustumBuilder::GenerateSides()
     {
         const float Alpha = static_cast<float>(h) / Segments;
         const float CurrentZ = FMath::Lerp(BottomZ, TopZ, Alpha);
-        const float HeightRatio = CurrentZ / Frustum.Height;
+        const float HeightRatio = CurrentZ / Params.Height;
 
         const float CurrentBaseRadius = FMath::Lerp(BottomR, TopR, Alpha);
 
@@ -234,7 +315,7 @@ void FFrustumBuilder::GenerateSides()
         PrevZ = CurrentZ;
         PrevRadius = CurrentBaseRadius;
 
-        int32 CurrentSides = (h == Segments) ? Frustum.TopSides : Frustum.BottomSides;
+        int32 CurrentSides = (h == Segments) ? Params.TopSides : Params.BottomSides;
         TArray<int32> CurrentRingIndices;
         CurrentRingIndices.Reserve(CurrentSides + 1);
 
@@ -254,8 +335,8 @@ void FFrustumBuilder::GenerateSides()
             else
             {
                 FVector2D PosStart = BottomRef[i];
-                float Ratio = static_cast<float>(i) / Frustum.BottomSides;
-                int32 TopIndex = FMath::Clamp(FMath::RoundToInt(Ratio * Frustum.TopSides), 0, Frustum.TopSides);
+                float Ratio = static_cast<float>(i) / Params.BottomSides;
+                int32 TopIndex = FMath::Clamp(FMath::RoundToInt(Ratio * Params.TopSides), 0, Params.TopSides);
                 FVector2D PosEnd = TopRef[TopIndex];
                 FVector2D LerpedPos = FMath::Lerp(PosStart, PosEnd, Alpha);
                 FinalPos = FVector(LerpedPos.X, LerpedPos.Y, CurrentZ);
@@ -265,9 +346,9 @@ void FFrustumBuilder::GenerateSides()
             float CurrentRadius = FVector2D(FinalPos.X, FinalPos.Y).Size();
             FinalPos = ApplyBend(FinalPos, CurrentRadius, HeightRatio);
 
-            if (FMath::Abs(Frustum.BendAmount) > KINDA_SMALL_NUMBER)
+            if (FMath::Abs(Params.BendAmount) > KINDA_SMALL_NUMBER)
             {
-                float NormalZ = Frustum.BendAmount * FMath::Cos(HeightRatio * PI);
+                float NormalZ = Params.BendAmount * FMath::Cos(HeightRatio * PI);
                 Normal.Z += NormalZ;
                 Normal.Normalize();
             }
@@ -276,7 +357,11 @@ void FFrustumBuilder::GenerateSides()
             float U = (CurrentAngle - StartAngle) * UVReferenceRadius;
             FVector2D UV(U * ModelGenConstants::GLOBAL_UV_SCALE, CurrentV * ModelGenConstants::GLOBAL_UV_SCALE);
 
-            CurrentRingIndices.Add(GetOrAddVertex(FinalPos, Normal, UV));
+            // U 沿圆周增加，V 自顶向下增加，外表面上副切线与 N x T 反向
+            const FVector SideTangent = FVector(-Normal.Y, Normal.X, 0.0f).GetSafeNormal();
+            const FProcMeshTangent Tangent(SideTangent, true);
+
+            CurrentRingIndices.Add(GetOrAddVertex(FinalPos, Normal, UV, Tangent));
         }
 
         Rings.Add(CurrentRingIndices);
@@ -302,37 +387,37 @@ void FFrustumBuilder::GenerateSides()
 
 void FFrustumBuilder::GenerateBevels()
 {
-    const float TopBevelHeight = CalculateBevelHeight(Frustum.TopRadius);
-    const float BottomBevelHeight = CalculateBevelHeight(Frustum.BottomRadius);
-    const float MinRadius = FMath::Min(Frustum.TopRadius, Frustum.BottomRadius);
-    const float BevelR = FMath::Min(Frustum.BevelRadius, MinRadius);
-    const int32 Segments = Frustum.BevelSegments;
+    const float TopBevelHeight = CalculateBevelHeight(Params.TopRadius);
+    const float BottomBevelHeight = CalculateBevelHeight(Params.BottomRadius);
+    const float MinRadius = FMath::Min(Params.TopRadius, Params.BottomRadius);
+    const float BevelR = FMath::Min(Params.BevelRadius, MinRadius);
+    const int32 Segments = Params.BevelSegments;
 
     const float BevelArcLength = (PI * BevelR) * 0.5f;
     const float V_Step = BevelArcLength / Segments;
 
-    float UVReferenceRadius = FMath::Max(Frustum.TopRadius, Frustum.BottomRadius);
+    float UVReferenceRadius = FMath::Max(Params.TopRadius, Params.BottomRadius);
 
-    const float RadiusDiff = Frustum.TopRadius - Frustum.BottomRadius;
-    const float SideLength = FMath::Sqrt(RadiusDiff * RadiusDiff + Frustum.Height * Frustum.Height);
+    const float RadiusDiff = Params.TopRadius - Params.BottomRadius;
+    const float SideLength = FMath::Sqrt(RadiusDiff * RadiusDiff + Params.Height * Params.Height);
 
     float WallTopZ, WallTopR;
     if (SideLength > KINDA_SMALL_NUMBER)
     {
-        const float HeightDir = Frustum.Height / SideLength;
+        const float HeightDir = Params.Height / SideLength;
         const float RadiusDir = RadiusDiff / SideLength;
-        WallTopZ = Frustum.Height - TopBevelHeight * HeightDir;
-        WallTopR = Frustum.TopRadius - TopBevelHeight * RadiusDir;
+        WallTopZ = Params.Height - TopBevelHeight * HeightDir;
+        WallTopR = Params.TopRadius - TopBevelHeight * RadiusDir;
     }
     else
     {
-        WallTopZ = Frustum.Height - TopBevelHeight;
-        WallTopR = Frustum.TopRadius - TopBevelHeight;
+        WallTopZ = Params.Height - TopBevelHeight;
+        WallTopR = Params.TopRadius - TopBevelHeight;
     }
 
     {
         TArray<int32> PreviousTopRing = TopSideRing;
-        float CapTopR = Frustum.TopRadius - TopBevelHeight;
+        float CapTopR = Params.TopRadius - TopBevelHeight;
 
         float CurrentV_Top = (PI * TopBevelHeight) * 0.5f;
 
@@ -350,7 +435,7 @@ void FFrustumBuilder::GenerateBevels()
             FRingContext Ctx;
             Ctx.Z = CurrentZ;
             Ctx.Radius = CurrentR;
-            Ctx.Sides = Frustum.TopSides;
+            Ctx.Sides = Params.TopSides;
 
             TArray<int32> CurrentRing = CreateBevelRing(Ctx, CurrentV_Top, Alpha, true, UVReferenceRadius);
 
@@ -372,17 +457,17 @@ void FFrustumBuilder::GenerateBevels()
         float WallBotZ, WallBotR;
         if (SideLength > KINDA_SMALL_NUMBER)
         {
-            const float HeightDir = Frustum.Height / SideLength;
+            const float HeightDir = Params.Height / SideLength;
             const float RadiusDir = RadiusDiff / SideLength;
             WallBotZ = BottomBevelHeight * HeightDir;
-            WallBotR = Frustum.BottomRadius + BottomBevelHeight * RadiusDir;
+            WallBotR = Params.BottomRadius + BottomBevelHeight * RadiusDir;
         }
         else
         {
             WallBotZ = BottomBevelHeight;
-            WallBotR = Frustum.BottomRadius + BottomBevelHeight;
+            WallBotR = Params.BottomRadius + BottomBevelHeight;
         }
-        float CapBotR = Frustum.BottomRadius - BottomBevelHeight;
+        float CapBotR = Params.BottomRadius - BottomBevelHeight;
 
         const float TopBevelArc = (PI * TopBevelHeight) * 0.5f;
 
@@ -406,7 +491,7 @@ void FFrustumBuilder::GenerateBevels()
             FRingContext Ctx;
             Ctx.Z = CurrentZ;
             Ctx.Radius = CurrentR;
-            Ctx.Sides = Frustum.BottomSides;
+            Ctx.Sides = Params.BottomSides;
 
             TArray<int32> CurrentRing = CreateBevelRing(Ctx, CurrentV_Bottom, Alpha, false, UVReferenceRadius);
 
@@ -425,17 +510,17 @@ void FFrustumBuilder::GenerateBevels()
 
 float FFrustumBuilder::CalculateBevelHeight(float Radius) const
 {
-    return FMath::Min(Frustum.BevelRadius, Radius);
+    return FMath::Min(Params.BevelRadius, Radius);
 }
 
 void FFrustumBuilder::GenerateCaps()
 {
-    if (TopCapRing.Num() >= 3 && Frustum.TopRadius > KINDA_SMALL_NUMBER)
+    if (TopCapRing.Num() >= 3 && Params.TopRadius > KINDA_SMALL_NUMBER)
     {
-        CreateCapDisk(Frustum.Height, TopCapRing, true);
+        CreateCapDisk(Params.Height, TopCapRing, true);
     }
 
-    if (BottomCapRing.Num() >= 3 && Frustum.BottomRadius > KINDA_SMALL_NUMBER)
+    if (BottomCapRing.Num() >= 3 && Params.BottomRadius > KINDA_SMALL_NUMBER)
     {
         CreateCapDisk(0.0f, BottomCapRing, false);
     }
@@ -444,16 +529,17 @@ void FFrustumBuilder::GenerateCaps()
 void FFrustumBuilder::CreateCapDisk(float Z, const TArray<int32>& BoundaryRing, bool bIsTop)
 {
     FVector CenterPos(0.0f, 0.0f, Z);
-    if (FMath::Abs(Frustum.BendAmount) > KINDA_SMALL_NUMBER)
+    if (FMath::Abs(Params.BendAmount) > KINDA_SMALL_NUMBER)
     {
-        float H = Z / Frustum.Height;
+        float H = Z / Params.Height;
         CenterPos = ApplyBend(CenterPos, 0.0f, H);
     }
 
     FVector Normal(0.0f, 0.0f, bIsTop ? 1.0f : -1.0f);
+    const FProcMeshTangent Tangent = MakeTangent(Normal, FVector::ForwardVector, FVector::RightVector);
 
     FVector2D CenterUV(CenterPos.X * ModelGenConstants::GLOBAL_UV_SCALE, CenterPos.Y * ModelGenConstants::GLOBAL_UV_SCALE);
-    int32 CenterIndex = AddVertex(CenterPos, Normal, CenterUV);
+    int32 CenterIndex = AddVertex(CenterPos, Normal, CenterUV, Tangent);
 
     TArray<int32> CapVertices;
     CapVertices.Reserve(BoundaryRing.Num());
@@ -463,7 +549,7 @@ void FFrustumBuilder::CreateCapDisk(float Z, const TArray<int32>& BoundaryRing,
         FVector Pos = GetPosByIndex(SrcIdx);
         FVector2D UV(Pos.X * ModelGenConstants::GLOBAL_UV_SCALE, Pos.Y * ModelGenConstants::GLOBAL_UV_SCALE);
 
-        CapVertices.Add(GetOrAddVertex(Pos, Normal, UV));
+        CapVertices.Add(GetOrAddVertex(Pos, Normal, UV, Tangent));
     }
 
     for (int32 i = 0; i < CapVertices.Num() - 1; ++i)
@@ -481,7 +567,7 @@ void FFrustumBuilder::CreateCapDisk(float Z, const TArray<int32>& BoundaryRing,
 
 void FFrustumBuilder::GenerateCutPlanes()
 {
-    if (Frustum.ArcAngle >= 360.0f - 0.01f)
+    if (Params.ArcAngle >= 360.0f - 0.01f)
     {
         return;
     }
@@ -526,6 +612,11 @@ void FFrustumBuilder::CreateCutPlaneSurface(float Angle, const TArray<int32>& Pr
     const float NormalAngle = Angle + (bIsStartFace ? -HALF_PI : HALF_PI);
     const FVector PlaneNormal(FMath::Cos(NormalAngle), FMath::Sin(NormalAngle), 0.0f);
 
+    // 与 GetCutUV 一致：U 沿径向（起始面取反），V 沿 Z 向下
+    const FVector RadialDir(FMath::Cos(Angle), FMath::Sin(Angle), 0.0f);
+    const FVector DPosDU = bIsStartFace ? -RadialDir : RadialDir;
+    const FVector DPosDV = -FVector::UpVector;
+
     for (int32 i = 0; i < SortedIndices.Num() - 1; ++i)
     {
         int32 Idx1 = SortedIndices[i];
@@ -549,14 +640,16 @@ void FFrustumBuilder::CreateCutPlaneSurface(float Angle, const TArray<int32>& Pr
         auto GetCutUV = [&](const FVector& P) {
             float R = FVector2D(P.X, P.Y).Size();
             float U = bIsStartFace ? -R : R;
-            float V = Frustum.Height - P.Z;
+            float V = Params.Height - P.Z;
             return FVector2D(U * ModelGenConstants::GLOBAL_UV_SCALE, V * ModelGenConstants::GLOBAL_UV_SCALE);
         };
 
-        int32 V_In1 = AddVertex(P1_Inner, InnerNormal, GetCutUV(P1_Inner));
-        int32 V_Out1 = AddVertex(P1_Outer, N1_Outer, GetCutUV(P1_Outer));
-        int32 V_Out2 = AddVertex(P2_Outer, N2_Outer, GetCutUV(P2_Outer));
-        int32 V_In2 = AddVertex(P2_Inner, InnerNormal, GetCutUV(P2_Inner));
+        const FProcMeshTangent InnerTangent = MakeTangent(InnerNormal, DPosDU, DPosDV);
+
+        int32 V_In1 = AddVertex(P1_Inner, InnerNormal, GetCutUV(P1_Inner), InnerTangent);
+        int32 V_Out1 = AddVertex(P1_Outer, N1_Outer, GetCutUV(P1_Outer), MakeTangent(N1_Outer, DPosDU, DPosDV));
+        int32 V_Out2 = AddVertex(P2_Outer, N2_Outer, GetCutUV(P2_Outer), MakeTangent(N2_Outer, DPosDU, DPosDV));
+        int32 V_In2 = AddVertex(P2_Inner, InnerNormal, GetCutUV(P2_Inner), InnerTangent);
 
         if (bIsStartFace)
         {
@@ -576,7 +669,7 @@ TArray<int32> FFrustumBuilder::CreateVertexRing(const FRingContext& Context, flo
 
 FVector FFrustumBuilder::ApplyBend(const FVector& BasePos, float BaseRadius, float HeightRatio) const
 {
-    if (FMath::Abs(Frustum.BendAmount) < KINDA_SMALL_NUMBER)
+    if (FMath::Abs(Params.BendAmount) < KINDA_SMALL_NUMBER)
     {
         return BasePos;
     }
@@ -588,25 +681,25 @@ FVector FFrustumBuilder::ApplyBend(const FVector& BasePos, float BaseRadius, flo
 
     const float BendFactor = FMath::Sin(HeightRatio * PI);
 
-    float BentRadius = BaseRadius * (1.0f - Frustum.BendAmount * BendFactor);
+    float BentRadius = BaseRadius * (1.0f - Params.BendAmount * BendFactor);
 
     const bool bIsCapRing = (HeightRatio < KINDA_SMALL_NUMBER) || (HeightRatio > (1.0f - KINDA_SMALL_NUMBER));
 
     bool bIsBevelRegion = false;
-    if (bEnableBevel && Frustum.Height > KINDA_SMALL_NUMBER)
+    if (bEnableBevel && Params.Height > KINDA_SMALL_NUMBER)
     {
-        const float TopBevelHeight = CalculateBevelHeight(Frustum.TopRadius);
-        const float BottomBevelHeight = CalculateBevelHeight(Frustum.BottomRadius);
+        const float TopBevelHeight = CalculateBevelHeight(Params.TopRadius);
+        const float BottomBevelHeight = CalculateBevelHeight(Params.BottomRadius);
 
-        const float BottomBevelRatio = BottomBevelHeight / Frustum.Height;
-        const float TopBevelRatio = 1.0f - (TopBevelHeight / Frustum.Height);
+        const float BottomBevelRatio = BottomBevelHeight / Params.Height;
+        const float TopBevelRatio = 1.0f - (TopBevelHeight / Params.Height);
 
         bIsBevelRegion = (HeightRatio <= BottomBevelRatio) || (HeightRatio >= TopBevelRatio);
     }
 
-    if (!bIsCapRing && !bIsBevelRegion && Frustum.MinBendRadius > KINDA_SMALL_NUMBER)
+    if (!bIsCapRing && !bIsBevelRegion && Params.MinBendRadius > KINDA_SMALL_NUMBER)
     {
-        BentRadius = FMath::Max(BentRadius, Frustum.MinBendRadius);
+        BentRadius = FMath::Max(BentRadius, Params.MinBendRadius);
     }
 
     if (FMath::IsNearlyEqual(BentRadius, BaseRadius))
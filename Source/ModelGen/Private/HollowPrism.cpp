@@ -11,7 +11,10 @@ AHollowPrism::AHollowPrism()
 
 void AHollowPrism::GenerateMesh()
 {
-    TryGenerateMeshInternal();
+    if (!TryGenerateMeshInternal())
+    {
+        ClearGeneratedMesh();
+    }
 }
 
 bool AHollowPrism::TryGenerateMeshInternal()
@@ -21,21 +24,19 @@ bool AHollowPrism::TryGenerateMeshInternal()
         return false;
     }
 
-    FHollowPrismBuilder Builder(*this);
-    FModelGenMeshData MeshData;
-
-    if (!Builder.Generate(MeshData))
+    if (RefreshInstancedShape())
     {
-        return false;
+        return true;
     }
 
-    if (!MeshData.IsValid())
-    {
-        return false;
-    }
+    const FHollowPrismParams Params = GetParams();
+    FHollowPrismBuilder Builder(Params);
+    return GenerateAndApplyMesh(Builder, Params);
+}
 
-    MeshData.ToProceduralMesh(GetProceduralMesh(), 0);
-    return true;
+TUniquePtr<FModelGenMeshBuilder> AHollowPrism::CreateMeshBuilder() const
+{
+    return MakeUnique<FHollowPrismBuilder>(GetParams());
 }
 
 void AHollowPrism::RegenerateMeshBlueprint()
@@ -46,71 +47,48 @@ void AHollowPrism::RegenerateMeshBlueprint()
     }
 }
 
+FHollowPrismParams AHollowPrism::GetParams() const
+{
+    FHollowPrismParams Params;
+    Params.InnerRadius = InnerRadius;
+    Params.OuterRadius = OuterRadius;
+    Params.Height = Height;
+    Params.OuterSides = OuterSides;
+    Params.InnerSides = InnerSides;
+    Params.ArcAngle = ArcAngle;
+    Params.BevelRadius = BevelRadius;
+    Params.BevelSegments = BevelSegments;
+    return Params;
+}
+
+FModelGenParamsHash AHollowPrism::GetShapeParamsHash() const
+{
+    return FModelGenParamsHash::Compute(GetParams());
+}
+
 bool AHollowPrism::IsValid() const
 {
-    return InnerRadius > 0.0f && OuterRadius > 0.0f && Height > 0.0f &&
-           InnerRadius < OuterRadius &&
-           InnerSides >= 3 && InnerSides <= 25 && OuterSides >= 3 && OuterSides <= 25 &&
-           ArcAngle > 0.0f && ArcAngle <= 360.0f &&
-           BevelRadius >= 0.0f && BevelSegments >= 0;
+    return GetParams().IsValid();
 }
 
 float AHollowPrism::GetWallThickness() const
 {
-    return OuterRadius - InnerRadius;
+    return GetParams().GetWallThickness();
 }
 
 bool AHollowPrism::IsFullCircle() const
 {
-    return FMath::IsNearlyEqual(ArcAngle, 360.0f, 0.1f);
+    return GetParams().IsFullCircle();
 }
 
 int32 AHollowPrism::CalculateVertexCountEstimate() const
 {
-    if (!IsValid())
-    {
-        return 0;
-    }
-
-    const int32 BaseVertices = InnerSides + OuterSides;
-    
-    int32 BevelVertices = 0;
-    if (BevelRadius > 0.0f && BevelSegments > 0)
-    {
-        BevelVertices = (InnerSides + OuterSides) * BevelSegments * 2;
-    }
-    
-    int32 EndCapVertices = 0;
-    if (!IsFullCircle())
-    {
-        EndCapVertices = InnerSides + OuterSides;
-    }
-
-    return BaseVertices + BevelVertices + EndCapVertices;
+    return GetParams().CalculateVertexCountEstimate();
 }
 
 int32 AHollowPrism::CalculateTriangleCountEstimate() const
 {
-    if (!IsValid())
-    {
-        return 0;
-    }
-
-    const int32 BaseTriangles = InnerSides + OuterSides;
-    
-    int32 BevelTriangles = 0;
-    if (BevelRadius > 0.0f && BevelSegments > 0)
-    {
-        BevelTriangles = (InnerSides + OuterSides) * BevelSegments * 2;
-    }
-    
-    int32 EndCapTriangles = 0;
-    if (!IsFullCircle())
-    {
-        EndCapTriangles = InnerSides + OuterSides;
-    }
-
-    return BaseTriangles + BevelTriangles + EndCapTriangles;
+    return GetParams().CalculateTriangleCountEstimate();
 }
 
 bool AHollowPrism::operator==(const AHollowPrism& Other) const
@@ -1,12 +1,13 @@
 // Copyright (c) 2024. All rights reserved.
 
 #include "HollowPrismBuilder.h"
-#include "HollowPrism.h"
 #include "ModelGenMeshData.h"
+#include "PhysicsEngine/AggregateGeom.h"
 #include "ModelGenConstants.h"
+#include "ModelGenStats.h"
 
-FHollowPrismBuilder::FHollowPrismBuilder(const AHollowPrism& InHollowPrism)
-    : HollowPrism(InHollowPrism)
+FHollowPrismBuilder::FHollowPrismBuilder(const FHollowPrismParams& InParams)
+    : Params(InParams)
 {
     Clear();
 }
@@ -31,7 +32,9 @@ void FHollowPrismBuilder::Clear()
 
 bool FHollowPrismBuilder::Generate(FModelGenMeshData& OutMeshData)
 {
-    if (!HollowPrism.IsValid())
+    MODELGEN_GENERATE_SCOPE(OutMeshData);
+
+    if (!Params.IsValid())
     {
         return false;
     }
@@ -39,13 +42,13 @@ bool FHollowPrismBuilder::Generate(FModelGenMeshData& OutMeshData)
     Clear();
     ReserveMemory();
 
-    const float Thickness = FMath::Abs(HollowPrism.OuterRadius - HollowPrism.InnerRadius);
-    const float MinDimension = FMath::Min(Thickness, HollowPrism.Height);
+    const float Thickness = FMath::Abs(Params.OuterRadius - Params.InnerRadius);
+    const float MinDimension = FMath::Min(Thickness, Params.Height);
 
-    BevelSegments = HollowPrism.BevelSegments;
-    bEnableBevel = (HollowPrism.BevelRadius > KINDA_SMALL_NUMBER) &&
+    BevelSegments = Params.BevelSegments;
+    bEnableBevel = (Params.BevelRadius > KINDA_SMALL_NUMBER) &&
         (BevelSegments > 0) &&
-        (HollowPrism.BevelRadius * 2.0f < MinDimension);
+        (Params.BevelRadius * 2.0f < MinDimension);
 
     PrecomputeMath();
 
@@ -61,28 +64,75 @@ bool FHollowPrismBuilder::Generate(FModelGenMeshData& OutMeshData)
         return false;
     }
 
-    MeshData.CalculateTangents();
+    // 切线已在生成顶点时解析给出，无需再做整网格切线计算
     OutMeshData = MeshData;
     return true;
 }
 
 int32 FHollowPrismBuilder::CalculateVertexCountEstimate() const
 {
-    return HollowPrism.CalculateVertexCountEstimate();
+    return Params.CalculateVertexCountEstimate();
 }
 
 int32 FHollowPrismBuilder::CalculateTriangleCountEstimate() const
 {
-    return HollowPrism.CalculateTriangleCountEstimate();
+    return Params.CalculateTriangleCountEstimate();
+}
+
+bool FHollowPrismBuilder::GenerateSimpleCollision(FKAggregateGeom& OutGeom) const
+{
+    if (!Params.IsValid())
+    {
+        return false;
+    }
+
+    // 每条内侧边对应一个扇区：内侧边界是直线，外侧在扇区内是凸折线，扇区本身即凸体
+    const float ArcRadians = FMath::DegreesToRadians(Params.ArcAngle);
+    const float ArcStart = -ArcRadians / 2.0f;
+    const float SectorStep = ArcRadians / Params.InnerSides;
+
+    for (int32 Sector = 0; Sector < Params.InnerSides; ++Sector)
+    {
+        const float FromAngle = ArcStart + Sector * SectorStep;
+        const float ToAngle = FromAngle + SectorStep;
+
+        TArray<FVector> Points;
+        for (const float Z : { 0.0f, Params.Height })
+        {
+            AppendPolygonArcPoints(Params.OuterRadius, Params.OuterSides, ArcStart, ArcRadians, FromAngle, ToAngle, Z, Points);
+            Points.Add(FVector(Params.InnerRadius * FMath::Cos(FromAngle), Params.InnerRadius * FMath::Sin(FromAngle), Z));
+            Points.Add(FVector(Params.InnerRadius * FMath::Cos(ToAngle), Params.InnerRadius * FMath::Sin(ToAngle), Z));
+        }
+
+        AddConvexElem(OutGeom, MoveTemp(Points));
+    }
+
+    return OutGeom.ConvexElems.Num() > 0;
+}
+
+TUniquePtr<FModelGenMeshBuilder> FHollowPrismBuilder::CreateReducedBuilder(float TessellationScale) const
+{
+    FHollowPrismParams Reduced = Params;
+    Reduced.OuterSides = ScaleSegmentCount(Params.OuterSides, TessellationScale, MinLODSides);
+    Reduced.InnerSides = ScaleSegmentCount(Params.InnerSides, TessellationScale, MinLODSides);
+    Reduced.BevelSegments = ScaleSegmentCount(Params.BevelSegments, TessellationScale, 1);
+
+    if (Reduced.OuterSides == Params.OuterSides && Reduced.InnerSides == Params.InnerSides &&
+        Reduced.BevelSegments == Params.BevelSegments)
+    {
+        return nullptr;
+    }
+
+    return MakeUnique<FHollowPrismBuilder>(Reduced);
 }
 
 void FHollowPrismBuilder::PrecomputeMath()
 {
-    ArcAngleRadians = FMath::DegreesToRadians(HollowPrism.ArcAngle);
+    ArcAngleRadians = FMath::DegreesToRadians(Params.ArcAngle);
     StartAngle = -ArcAngleRadians / 2.0f;
 
     {
-        const int32 Sides = HollowPrism.OuterSides;
+        const int32 Sides = Params.OuterSides;
         OuterAngleCache.SetNum(Sides + 1);
         const float Step = (Sides > 0) ? (ArcAngleRadians / Sides) : 0.0f;
         for (int32 i = 0; i <= Sides; ++i)
@@ -93,7 +143,7 @@ void FHollowPrismBuilder::PrecomputeMath()
     }
 
     {
-        const int32 Sides = HollowPrism.InnerSides;
+        const int32 Sides = Params.InnerSides;
         InnerAngleCache.SetNum(Sides + 1);
         const float Step = (Sides > 0) ? (ArcAngleRadians / Sides) : 0.0f;
         for (int32 i = 0; i <= Sides; ++i)
@@ -108,13 +158,13 @@ void FHollowPrismBuilder::ComputeVerticalProfile(EInnerOuter InnerOuter, TArray<
 {
     OutProfile.Empty();
 
-    const float BevelR = bEnableBevel ? HollowPrism.BevelRadius : 0.0f;
+    const float BevelR = bEnableBevel ? Params.BevelRadius : 0.0f;
     const int32 Segments = bEnableBevel ? BevelSegments : 0;
 
-    const float BaseRadius = (InnerOuter == EInnerOuter::Inner) ? HollowPrism.InnerRadius : HollowPrism.OuterRadius;
+    const float BaseRadius = (InnerOuter == EInnerOuter::Inner) ? Params.InnerRadius : Params.OuterRadius;
     const float Sign = (InnerOuter == EInnerOuter::Inner) ? 1.0f : -1.0f;
 
-    const float TopArcCenterZ = HollowPrism.Height - BevelR;
+    const float TopArcCenterZ = Params.Height - BevelR;
     const float BottomArcCenterZ = BevelR;
     const float ArcCenterR = BaseRadius + (Sign * BevelR);
 
@@ -147,7 +197,7 @@ void FHollowPrismBuilder::ComputeVerticalProfile(EInnerOuter InnerOuter, TArray<
     }
 
     {
-        float WallHeight = HollowPrism.Height - 2.0f * BevelR;
+        float WallHeight = Params.Height - 2.0f * BevelR;
         if (WallHeight > KINDA_SMALL_NUMBER)
         {
             CurrentV += WallHeight;
@@ -192,14 +242,14 @@ void FHollowPrismBuilder::ComputeVerticalProfile(EInnerOuter InnerOuter, TArray<
 void FHollowPrismBuilder::GenerateSideGeometry(EInnerOuter InnerOuter)
 {
     const TArray<FCachedTrig>& AngleCache = (InnerOuter == EInnerOuter::Inner) ? InnerAngleCache : OuterAngleCache;
-    const int32 Sides = (InnerOuter == EInnerOuter::Inner) ? HollowPrism.InnerSides : HollowPrism.OuterSides;
+    const int32 Sides = (InnerOuter == EInnerOuter::Inner) ? Params.InnerSides : Params.OuterSides;
 
     TArray<FVerticalProfilePoint> Profile;
     ComputeVerticalProfile(InnerOuter, Profile);
 
     if (Profile.Num() < 2) return;
 
-    const float ReferenceRadius = (InnerOuter == EInnerOuter::Inner) ? HollowPrism.InnerRadius : HollowPrism.OuterRadius;
+    const float ReferenceRadius = (InnerOuter == EInnerOuter::Inner) ? Params.InnerRadius : Params.OuterRadius;
 
     TArray<TArray<int32>> GridIndices;
     GridIndices.SetNum(Sides + 1);
@@ -227,7 +277,14 @@ void FHollowPrismBuilder::GenerateSideGeometry(EInnerOuter InnerOuter)
 
             FVector2D UV(U * ModelGenConstants::GLOBAL_UV_SCALE, Point.V * ModelGenConstants::GLOBAL_UV_SCALE);
 
-            int32 VertIdx = GetOrAddVertex(Pos, Normal, UV);
+            // U 沿圆周角度增加，V 沿轮廓序号增加，用相邻轮廓点的差分作为 V 方向
+            const FVerticalProfilePoint& PrevPoint = Profile[FMath::Max(p - 1, 0)];
+            const FVerticalProfilePoint& NextPoint = Profile[FMath::Min(p + 1, Profile.Num() - 1)];
+            const float DeltaRadius = NextPoint.Radius - PrevPoint.Radius;
+            const FVector DPosDU(-SinA, CosA, 0.0f);
+            const FVector DPosDV(DeltaRadius * CosA, DeltaRadius * SinA, NextPoint.Z - PrevPoint.Z);
+
+            int32 VertIdx = GetOrAddVertex(Pos, Normal, UV, MakeTangent(Normal, DPosDU, DPosDV));
             GridIndices[s].Add(VertIdx);
 
             if (p == 0)
@@ -285,6 +342,7 @@ void FHollowPrismBuilder::CreateCapDisk(const TArray<int32>& InnerRing, const TA
     if (InnerRing.Num() < 2 || OuterRing.Num() < 2) return;
 
     FVector Normal(0, 0, bIsTop ? 1.0f : -1.0f);
+    const FProcMeshTangent Tangent = MakeTangent(Normal, FVector::ForwardVector, FVector::RightVector);
 
     auto ProcessRing = [&](const TArray<int32>& SrcRing, TArray<int32>& OutRing)
         {
@@ -293,7 +351,7 @@ void FHollowPrismBuilder::CreateCapDisk(const TArray<int32>& InnerRing, const TA
             {
                 FVector Pos = GetPosByIndex(SrcIdx);
                 FVector2D UV(Pos.X * ModelGenConstants::GLOBAL_UV_SCALE, Pos.Y * ModelGenConstants::GLOBAL_UV_SCALE);
-                OutRing.Add(AddVertex(Pos, Normal, UV));
+                OutRing.Add(AddVertex(Pos, Normal, UV, Tangent));
             }
         };
 
@@ -328,7 +386,7 @@ void FHollowPrismBuilder::CreateCapDisk(const TArray<int32>& InnerRing, const TA
 
 void FHollowPrismBuilder::GenerateCutPlanes()
 {
-    if (HollowPrism.IsFullCircle()) return;
+    if (Params.IsFullCircle()) return;
 
     if (StartInnerCapIndices.Num() != StartOuterCapIndices.Num()) return;
 
@@ -343,13 +401,17 @@ void FHollowPrismBuilder::CreateCutPlane(float Angle, const TArray<int32>& Inner
     float NormalAngle = Angle + (bIsStartFace ? -HALF_PI : HALF_PI);
     FVector Normal(FMath::Cos(NormalAngle), FMath::Sin(NormalAngle), 0.0f);
 
+    // U 为负的径向距离，V 沿 Z 向下
+    const FVector RadialDir(FMath::Cos(Angle), FMath::Sin(Angle), 0.0f);
+    const FProcMeshTangent Tangent = MakeTangent(Normal, -RadialDir, -FVector::UpVector);
+
     int32 NumPoints = InnerIndices.Num();
 
     TArray<int32> NewInner, NewOuter;
     NewInner.Reserve(NumPoints);
     NewOuter.Reserve(NumPoints);
 
-    const float Height = HollowPrism.Height;
+    const float Height = Params.Height;
 
     for (int32 i = 0; i < NumPoints; ++i)
     {
@@ -365,8 +427,8 @@ void FHollowPrismBuilder::CreateCutPlane(float Angle, const TArray<int32>& Inner
         FVector2D UV_In(-R_In * ModelGenConstants::GLOBAL_UV_SCALE, V_In * ModelGenConstants::GLOBAL_UV_SCALE);
         FVector2D UV_Out(-R_Out * ModelGenConstants::GLOBAL_UV_SCALE, V_Out * ModelGenConstants::GLOBAL_UV_SCALE);
 
-        NewInner.Add(AddVertex(P_In, Normal, UV_In));
-        NewOuter.Add(AddVertex(P_Out, Normal, UV_Out));
+        NewInner.Add(AddVertex(P_In, Normal, UV_In, Tangent));
+        NewOuter.Add(AddVertex(P_Out, Normal, UV_Out, Tangent));
     }
 
     for (int32 i = 0; i < NumPoints - 1; ++i)
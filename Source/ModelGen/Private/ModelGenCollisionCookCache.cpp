@@ -0,0 +1,337 @@
+// Copyright (c) 2024. All rights reserved.
+
+#include "ModelGenCollisionCookCache.h"
+#include "ModelGenDiskCache.h"
+#include "PhysXIncludes.h"
+#include "PhysXPublicCore.h"
+#include "Interface_CollisionDataProviderCore.h"
+
+namespace
+{
+    enum class ECookedMeshType : uint8
+    {
+        Convex,
+        TriMesh
+    };
+
+    bool IsCookSucceeded(EPhysXCookingResult Result)
+    {
+        return Result == EPhysXCookingResult::Succeeded || Result == EPhysXCookingResult::SucceededWithInflation;
+    }
+
+    // 先查磁盘缓存，未命中时用 Cook 烘焙成字节流并写回磁盘，再由字节流创建 PhysX 网格
+    template <typename TMesh, typename TCookFunc, typename TCreateFunc>
+    TMesh* LoadOrCookFromDisk(const FModelGenParamsHash& Key, TCookFunc Cook, TCreateFunc Create)
+    {
+        FModelGenDiskCache& DiskCache = FModelGenDiskCache::Get();
+
+        TArray<uint8> CookedData;
+        if (!DiskCache.LoadCookedCollision(Key, CookedData))
+        {
+            if (!Cook(CookedData) || CookedData.Num() == 0)
+            {
+                return nullptr;
+            }
+            DiskCache.SaveCookedCollision(Key, CookedData);
+        }
+
+        physx::PxDefaultMemoryInputData Input(CookedData.GetData(), CookedData.Num());
+        return Create(Input);
+    }
+}
+
+FModelGenCollisionCookCache& FModelGenCollisionCookCache::Get()
+{
+    // 与 StaticMesh 缓存一致，不在静态析构阶段释放 PhysX 对象
+    static FModelGenCollisionCookCache* Instance = new FModelGenCollisionCookCache();
+    return *Instance;
+}
+
+FModelGenCollisionCookCache::FModelGenCollisionCookCache()
+{
+}
+
+FModelGenCollisionCookCache::~FModelGenCollisionCookCache()
+{
+    Empty();
+}
+
+FModelGenParamsHash FModelGenCollisionCookCache::MakeKey(
+    uint8 MeshType,
+    FName Format,
+    EPhysXMeshCookFlags CookFlags,
+    const TArray<FVector>& Vertices,
+    const TArray<FTriIndices>* Indices,
+    const TArray<uint16>* MaterialIndices,
+    bool bFlipNormals)
+{
+    TArray<uint8> Bytes;
+    Bytes.Reserve(64 + Vertices.Num() * sizeof(FVector) +
+        (Indices ? Indices->Num() * sizeof(FTriIndices) : 0) +
+        (MaterialIndices ? MaterialIndices->Num() * sizeof(uint16) : 0));
+
+    auto Write = [&Bytes](const void* Data, int32 Size)
+    {
+        Bytes.Append(reinterpret_cast<const uint8*>(Data), Size);
+    };
+
+    const FString FormatString = Format.ToString();
+    const int32 FormatLength = FormatString.Len();
+    const uint32 Flags = static_cast<uint32>(CookFlags);
+    const uint8 bFlip = bFlipNormals ? 1 : 0;
+
+    Write(&MeshType, sizeof(MeshType));
+    Write(&FormatLength, sizeof(FormatLength));
+    Write(*FormatString, FormatLength * sizeof(TCHAR));
+    Write(&Flags, sizeof(Flags));
+    Write(&bFlip, sizeof(bFlip));
+
+    const int32 NumVertices = Vertices.Num();
+    Write(&NumVertices, sizeof(NumVertices));
+    for (const FVector& Vertex : Vertices)
+    {
+        // 加 0 使 -0 归一为 +0
+        const FVector Normalized(Vertex.X + 0.0f, Vertex.Y + 0.0f, Vertex.Z + 0.0f);
+        Write(&Normalized, sizeof(Normalized));
+    }
+
+    if (Indices)
+    {
+        const int32 NumIndices = Indices->Num();
+        Write(&NumIndices, sizeof(NumIndices));
+        Write(Indices->GetData(), NumIndices * sizeof(FTriIndices));
+    }
+
+    if (MaterialIndices)
+    {
+        const int32 NumMaterialIndices = MaterialIndices->Num();
+        Write(&NumMaterialIndices, sizeof(NumMaterialIndices));
+        Write(MaterialIndices->GetData(), NumMaterialIndices * sizeof(uint16));
+    }
+
+    return FModelGenParamsHash::ComputeBytes(Bytes.GetData(), Bytes.Num());
+}
+
+physx::PxConvexMesh* FModelGenCollisionCookCache::FindOrCookConvex(
+    IPhysXCooking* Cooking,
+    FName Format,
+    EPhysXMeshCookFlags CookFlags,
+    const TArray<FVector>& Vertices)
+{
+    if (!Cooking || Vertices.Num() < 4)
+    {
+        return nullptr;
+    }
+
+    const FModelGenParamsHash Key = MakeKey(static_cast<uint8>(ECookedMeshType::Convex),
+        Format, CookFlags, Vertices, nullptr, nullptr, false);
+
+    FEntry Entry;
+    if (FindAndAcquire(Key, Entry))
+    {
+        return Entry.ConvexMesh;
+    }
+
+    physx::PxConvexMesh* NewConvexMesh = nullptr;
+    if (FModelGenDiskCache::Get().IsEnabled())
+    {
+        NewConvexMesh = LoadOrCookFromDisk<physx::PxConvexMesh>(Key,
+            [&](TArray<uint8>& OutData) { return IsCookSucceeded(Cooking->CookConvex(Format, CookFlags, Vertices, OutData)); },
+            [](physx::PxInputStream& Input) { return GPhysXSDK->createConvexMesh(Input); });
+    }
+    else if (!IsCookSucceeded(Cooking->CreateConvex(Format, CookFlags, Vertices, NewConvexMesh)))
+    {
+        return nullptr;
+    }
+
+    if (!NewConvexMesh)
+    {
+        return nullptr;
+    }
+
+    Entry.ConvexMesh = NewConvexMesh;
+    AddAndAcquire(Key, Entry);
+    return Entry.ConvexMesh;
+}
+
+physx::PxTriangleMesh* FModelGenCollisionCookCache::FindOrCookTriMesh(
+    IPhysXCooking* Cooking,
+    FName Format,
+    EPhysXMeshCookFlags CookFlags,
+    const TArray<FVector>& Vertices,
+    const TArray<FTriIndices>& Indices,
+    const TArray<uint16>& MaterialIndices,
+    bool bFlipNormals)
+{
+    if (!Cooking || Vertices.Num() == 0 || Indices.Num() == 0)
+    {
+        return nullptr;
+    }
+
+    const FModelGenParamsHash Key = MakeKey(static_cast<uint8>(ECookedMeshType::TriMesh),
+        Format, CookFlags, Vertices, &Indices, &MaterialIndices, bFlipNormals);
+
+    FEntry Entry;
+    if (FindAndAcquire(Key, Entry))
+    {
+        return Entry.TriMesh;
+    }
+
+    physx::PxTriangleMesh* NewTriMesh = nullptr;
+    if (FModelGenDiskCache::Get().IsEnabled())
+    {
+        NewTriMesh = LoadOrCookFromDisk<physx::PxTriangleMesh>(Key,
+            [&](TArray<uint8>& OutData) { return Cooking->CookTriMesh(Format, CookFlags, Vertices, Indices, MaterialIndices, bFlipNormals, OutData); },
+            [](physx::PxInputStream& Input) { return GPhysXSDK->createTriangleMesh(Input); });
+    }
+    else if (!Cooking->CreateTriMesh(Format, CookFlags, Vertices, Indices, MaterialIndices, bFlipNormals, NewTriMesh))
+    {
+        return nullptr;
+    }
+
+    if (!NewTriMesh)
+    {
+        return nullptr;
+    }
+
+    Entry.TriMesh = NewTriMesh;
+    AddAndAcquire(Key, Entry);
+    return Entry.TriMesh;
+}
+
+void FModelGenCollisionCookCache::AcquireMesh(const FEntry& Entry)
+{
+    if (Entry.ConvexMesh)
+    {
+        Entry.ConvexMesh->acquireReference();
+    }
+    if (Entry.TriMesh)
+    {
+        Entry.TriMesh->acquireReference();
+    }
+}
+
+void FModelGenCollisionCookCache::ReleaseMesh(const FEntry& Entry)
+{
+    // 使用中的形状和 BodySetup 各自持有引用，这里只放掉缓存自己的那一次
+    if (Entry.ConvexMesh)
+    {
+        Entry.ConvexMesh->release();
+    }
+    if (Entry.TriMesh)
+    {
+        Entry.TriMesh->release();
+    }
+}
+
+bool FModelGenCollisionCookCache::FindAndAcquire(const FModelGenParamsHash& Key, FEntry& OutEntry)
+{
+    FScopeLock ScopeLock(&Lock);
+
+    FEntry* Entry = Entries.Find(Key);
+    if (!Entry)
+    {
+        ++MissCount;
+        return false;
+    }
+
+    LruList.RemoveNode(Entry->LruNode, false);
+    LruList.AddHead(Entry->LruNode);
+
+    AcquireMesh(*Entry);
+    OutEntry = *Entry;
+
+    ++HitCount;
+    return true;
+}
+
+void FModelGenCollisionCookCache::AddAndAcquire(const FModelGenParamsHash& Key, FEntry& InOutEntry)
+{
+    FScopeLock ScopeLock(&Lock);
+
+    if (FEntry* Existing = Entries.Find(Key))
+    {
+        ReleaseMesh(InOutEntry);
+        AcquireMesh(*Existing);
+        InOutEntry = *Existing;
+        return;
+    }
+
+    LruList.AddHead(Key);
+
+    FEntry& Entry = Entries.Add(Key, InOutEntry);
+    Entry.LruNode = LruList.GetHead();
+
+    // 新烘焙的网格自带一次引用归缓存所有，再为调用方加一次
+    AcquireMesh(Entry);
+    InOutEntry = Entry;
+
+    EvictToBudget();
+}
+
+void FModelGenCollisionCookCache::Empty()
+{
+    FScopeLock ScopeLock(&Lock);
+
+    for (const TPair<FModelGenParamsHash, FEntry>& Pair : Entries)
+    {
+        ReleaseMesh(Pair.Value);
+    }
+
+    Entries.Empty();
+    LruList.Empty();
+    HitCount = 0;
+    MissCount = 0;
+    EvictionCount = 0;
+}
+
+void FModelGenCollisionCookCache::SetMaxEntries(int32 InMaxEntries)
+{
+    FScopeLock ScopeLock(&Lock);
+
+    MaxEntries = FMath::Max(InMaxEntries, 0);
+    EvictToBudget();
+}
+
+int32 FModelGenCollisionCookCache::GetMaxEntries() const
+{
+    FScopeLock ScopeLock(&Lock);
+    return MaxEntries;
+}
+
+int32 FModelGenCollisionCookCache::Num() const
+{
+    FScopeLock ScopeLock(&Lock);
+    return Entries.Num();
+}
+
+FModelGenCollisionCookCacheStats FModelGenCollisionCookCache::GetStats() const
+{
+    FScopeLock ScopeLock(&Lock);
+
+    FModelGenCollisionCookCacheStats Stats;
+    Stats.NumEntries = Entries.Num();
+    Stats.HitCount = HitCount;
+    Stats.MissCount = MissCount;
+    Stats.EvictionCount = EvictionCount;
+    return Stats;
+}
+
+void FModelGenCollisionCookCache::RemoveEntry(const FModelGenParamsHash& Key)
+{
+    FEntry Entry;
+    if (Entries.RemoveAndCopyValue(Key, Entry))
+    {
+        LruList.RemoveNode(Entry.LruNode);
+        ReleaseMesh(Entry);
+    }
+}
+
+void FModelGenCollisionCookCache::EvictToBudget()
+{
+    while (Entries.Num() > MaxEntries && LruList.GetTail())
+    {
+        RemoveEntry(LruList.GetTail()->GetValue());
+        ++EvictionCount;
+    }
+}
@@ -2,6 +2,20 @@
 #include "ProceduralMeshComponent.h"
 #include "PhysicsEngine/BodySetup.h"
 #include "Math/UnrealMathUtility.h"
+#include "Async/ParallelFor.h"
+#include "HAL/IConsoleManager.h"
+
+namespace ModelGenConvexDecomp
+{
+    static TAutoConsoleVariable<int32> CVarParallelHulls(
+        TEXT("ModelGen.ConvexDecomp.Parallel"),
+        1,
+        TEXT("非 0 时叶子凸包在任务图上并行生成；结果顺序与串行一致，置 0 可用于对比"),
+        ECVF_Default);
+
+    // 叶子数少于该值时并行调度开销大于收益
+    static constexpr int32 MinLeavesForParallel = 2;
+}
 
 bool FModelGenConvexDecomp::GenerateConvexHulls(
     UProceduralMeshComponent* ProceduralMeshComponent,
@@ -21,6 +35,31 @@ bool FModelGenConvexDecomp::GenerateConvexHulls(
         return false;
     }
 
+    return GenerateConvexHulls(MeshData, BodySetup, HullCount, MaxHullVerts, HullPrecision);
+}
+
+bool FModelGenConvexDecomp::GenerateConvexHulls(
+    const FMeshData& MeshData,
+    UBodySetup* BodySetup,
+    int32 HullCount,
+    int32 MaxHullVerts,
+    uint32 HullPrecision)
+{
+    if (!BodySetup)
+    {
+        return false;
+    }
+
+    return GenerateConvexHulls(MeshData, BodySetup->AggGeom, HullCount, MaxHullVerts, HullPrecision);
+}
+
+bool FModelGenConvexDecomp::GenerateConvexHulls(
+    const FMeshData& MeshData,
+    FKAggregateGeom& OutGeom,
+    int32 HullCount,
+    int32 MaxHullVerts,
+    uint32 HullPrecision)
+{
     if (MeshData.Vertices.Num() < 4 || MeshData.Indices.Num() < 3)
     {
         return false;
@@ -42,8 +81,11 @@ bool FModelGenConvexDecomp::GenerateConvexHulls(
         AllTriangleIndices.Add(i);
     }
 
+    TArray<TArray<FVector>> LeafPoints;
+    RecursiveDecompose(MeshData, AllTriangleIndices, Params, 0, LeafPoints);
+
     TArray<FKConvexElem> ConvexElems;
-    RecursiveDecompose(MeshData, AllTriangleIndices, Params, 0, ConvexElems);
+    GenerateLeafHulls(LeafPoints, ConvexElems);
 
     if (ConvexElems.Num() < Params.TargetHullCount && ConvexElems.Num() > 0)
     {
@@ -112,16 +154,16 @@ bool FModelGenConvexDecomp::GenerateConvexHulls(
         ConvexElems.SetNum(Params.TargetHullCount);
     }
 
-    BodySetup->AggGeom.ConvexElems.Empty();
+    OutGeom.ConvexElems.Empty();
     for (FKConvexElem& Elem : ConvexElems)
     {
         if (Elem.VertexData.Num() >= 4)
         {
-            BodySetup->AggGeom.ConvexElems.Add(Elem);
+            OutGeom.ConvexElems.Add(Elem);
         }
     }
 
-    const int32 FinalConvexCount = BodySetup->AggGeom.ConvexElems.Num();
+    const int32 FinalConvexCount = OutGeom.ConvexElems.Num();
     if (FinalConvexCount > 0)
     {
         return true;
@@ -158,12 +200,41 @@ bool FModelGenConvexDecomp::ExtractMeshData(UProceduralMeshComponent* Procedural
     return OutMeshData.Vertices.Num() >= 4 && OutMeshData.Indices.Num() >= 3;
 }
 
+void FModelGenConvexDecomp::GenerateLeafHulls(const TArray<TArray<FVector>>& LeafPoints, TArray<FKConvexElem>& OutConvexElems)
+{
+    const int32 NumLeaves = LeafPoints.Num();
+
+    TArray<FKConvexElem> LeafElems;
+    LeafElems.SetNum(NumLeaves);
+
+    TArray<bool> LeafValid;
+    LeafValid.SetNumZeroed(NumLeaves);
+
+    // 每个任务只写自己的槽位；ParallelFor 由空闲工作线程领取剩余叶子，叶子大小不均时也能均衡
+    const bool bForceSingleThread = NumLeaves < ModelGenConvexDecomp::MinLeavesForParallel ||
+        ModelGenConvexDecomp::CVarParallelHulls.GetValueOnAnyThread() == 0;
+
+    ParallelFor(NumLeaves, [&LeafPoints, &LeafElems, &LeafValid](int32 LeafIndex)
+    {
+        LeafValid[LeafIndex] = GenerateConvexHull(LeafPoints[LeafIndex], LeafElems[LeafIndex]);
+    }, bForceSingleThread);
+
+    OutConvexElems.Reserve(OutConvexElems.Num() + NumLeaves);
+    for (int32 LeafIndex = 0; LeafIndex < NumLeaves; ++LeafIndex)
+    {
+        if (LeafValid[LeafIndex])
+        {
+            OutConvexElems.Add(MoveTemp(LeafElems[LeafIndex]));
+        }
+    }
+}
+
 void FModelGenConvexDecomp::RecursiveDecompose(
     const FMeshData& MeshData,
     const TArray<int32>& TriangleIndices,
     const FDecompParams& Params,
     int32 CurrentDepth,
-    TArray<FKConvexElem>& OutConvexElems)
+    TArray<TArray<FVector>>& OutLeafPoints)
 {
     if (TriangleIndices.Num() == 0)
     {
@@ -202,11 +273,7 @@ void FModelGenConvexDecomp::RecursiveDecompose(
 
         if (Points.Num() >= 4)
         {
-            FKConvexElem ConvexElem;
-            if (GenerateConvexHull(Points, ConvexElem))
-            {
-                OutConvexElems.Add(ConvexElem);
-            }
+            OutLeafPoints.Add(MoveTemp(Points));
         }
         return;
     }
@@ -229,17 +296,14 @@ void FModelGenConvexDecomp::RecursiveDecompose(
 
         if (Points.Num() >= 4)
         {
-            FKConvexElem ConvexElem;
-            if (GenerateConvexHull(Points, ConvexElem))
-            {
-                OutConvexElems.Add(ConvexElem);
-            }
+            OutLeafPoints.Add(MoveTemp(Points));
         }
         return;
     }
 
+    // 不少于 4 个点时 GenerateConvexHull 必定成功，叶子数即等于串行建包时已有的凸包数
     if (UniqueVertexIndices.Num() <= Params.MaxHullVertices && 
-        OutConvexElems.Num() >= Params.TargetHullCount)
+        OutLeafPoints.Num() >= Params.TargetHullCount)
     {
         TArray<FVector> Points;
         Points.Reserve(UniqueVertexIndices.Num());
@@ -257,11 +321,7 @@ void FModelGenConvexDecomp::RecursiveDecompose(
 
         if (Points.Num() >= 4)
         {
-            FKConvexElem ConvexElem;
-            if (GenerateConvexHull(Points, ConvexElem))
-            {
-                OutConvexElems.Add(ConvexElem);
-            }
+            OutLeafPoints.Add(MoveTemp(Points));
         }
         return;
     }
@@ -356,7 +416,7 @@ void FModelGenConvexDecomp::RecursiveDecompose(
         }
     }
 
-    const int32 RemainingHulls = Params.TargetHullCount - OutConvexElems.Num();
+    const int32 RemainingHulls = Params.TargetHullCount - OutLeafPoints.Num();
     const int32 DepthFactor = FMath::Max(1, Params.MaxDepth - CurrentDepth);
     const int32 MinTriangles = FMath::Max(4, TriangleIndices.Num() / FMath::Max(10, 20 - RemainingHulls * 2));
 
@@ -391,18 +451,14 @@ void FModelGenConvexDecomp::RecursiveDecompose(
             }
             if (LeftPoints.Num() >= 4)
             {
-                FKConvexElem ConvexElem;
-                if (GenerateConvexHull(LeftPoints, ConvexElem))
-                {
-                    OutConvexElems.Add(ConvexElem);
-                }
+                OutLeafPoints.Add(MoveTemp(LeftPoints));
             }
         }
         else
         {
             if (LeftTriangles.Num() > MinTriangles)
             {
-                RecursiveDecompose(MeshData, LeftTriangles, Params, CurrentDepth + 1, OutConvexElems);
+                RecursiveDecompose(MeshData, LeftTriangles, Params, CurrentDepth + 1, OutLeafPoints);
             }
             else
             {
@@ -431,11 +487,7 @@ void FModelGenConvexDecomp::RecursiveDecompose(
                 }
                 if (LeftPoints.Num() >= 4)
                 {
-                    FKConvexElem ConvexElem;
-                    if (GenerateConvexHull(LeftPoints, ConvexElem))
-                    {
-                        OutConvexElems.Add(ConvexElem);
-                    }
+                    OutLeafPoints.Add(MoveTemp(LeftPoints));
                 }
             }
         }
@@ -472,18 +524,14 @@ void FModelGenConvexDecomp::RecursiveDecompose(
             }
             if (RightPoints.Num() >= 4)
             {
-                FKConvexElem ConvexElem;
-                if (GenerateConvexHull(RightPoints, ConvexElem))
-                {
-                    OutConvexElems.Add(ConvexElem);
-                }
+                OutLeafPoints.Add(MoveTemp(RightPoints));
             }
         }
         else
         {
             if (RightTriangles.Num() > MinTriangles)
             {
-                RecursiveDecompose(MeshData, RightTriangles, Params, CurrentDepth + 1, OutConvexElems);
+                RecursiveDecompose(MeshData, RightTriangles, Params, CurrentDepth + 1, OutLeafPoints);
             }
             else
             {
@@ -512,541 +560,578 @@ void FModelGenConvexDecomp::RecursiveDecompose(
                 }
                 if (RightPoints.Num() >= 4)
                 {
-                    FKConvexElem ConvexElem;
-                    if (GenerateConvexHull(RightPoints, ConvexElem))
-                    {
-                        OutConvexElems.Add(ConvexElem);
-                    }
+                    OutLeafPoints.Add(MoveTemp(RightPoints));
                 }
             }
         }
     }
 }
 
-bool FModelGenConvexDecomp::GenerateConvexHull(const TArray<FVector>& Points, FKConvexElem& OutConvexElem)
+namespace
 {
-    if (Points.Num() < 4)
+    // QuickHull 面：从外侧看顶点逆时针排列，边 i 为 V[i] -> V[(i + 1) % 3]，Neighbor[i] 为共享该边的面
+    struct FHullFace
     {
-        return false;
-    }
+        int32 V[3];
+        int32 Neighbor[3];
 
-    TArray<FVector> UniquePoints;
-    TMap<FIntVector, FVector> QuantizedMap;
-    const float QuantizeScale = 100.0f;
+        // 缓存的平面，点到面的有符号距离为 Dot(Normal, P) - PlaneW
+        FVector Normal;
+        float PlaneW;
 
-    for (const FVector& Point : Points)
-    {
-        FIntVector Quantized(
-            FMath::RoundToInt(Point.X * QuantizeScale),
-            FMath::RoundToInt(Point.Y * QuantizeScale),
-            FMath::RoundToInt(Point.Z * QuantizeScale)
-        );
+        // 外侧点以单链表串联（FQuickHull::PointNext），同时记录最远点
+        int32 OutsideHead;
+        int32 FurthestPoint;
+        float FurthestDistance;
+
+        uint32 VisitEpoch;
+        bool bAlive;
 
-        if (!QuantizedMap.Contains(Quantized))
+        float GetDistance(const FVector& Point) const
         {
-            QuantizedMap.Add(Quantized, Point);
-            UniquePoints.Add(Point);
+            return FVector::DotProduct(Normal, Point) - PlaneW;
         }
-    }
+    };
 
-    if (UniquePoints.Num() < 4)
+    struct FHorizonEdge
     {
-        UniquePoints = Points;
-    }
+        int32 V0;
+        int32 V1;
+        int32 OuterFace;
+    };
 
-    TArray<FFace*> AllFaces; 
-    TArray<FFace*> PendingFaces;
-    FFace* HeadFace = nullptr;
-    TArray<int32> UnassignedPoints;
-    
-    for (int32 i = 0; i < UniquePoints.Num(); ++i)
+    struct FHorizonFrame
     {
-        UnassignedPoints.Add(i);
-    }
+        int32 Face;
+        int32 FirstEdge;
+        int32 Step;
+    };
 
-    if (!BuildInitialTetrahedron(UniquePoints, AllFaces, UnassignedPoints))
+    // 面存放在可复用的池中，邻接关系使用索引；待处理面使用带头指针的队列，已删除的面在出队时跳过
+    class FQuickHull
     {
-        OutConvexElem.VertexData = UniquePoints;
-        OutConvexElem.UpdateElemBox();
-        return UniquePoints.Num() >= 4;
-    }
+    public:
+        explicit FQuickHull(const TArray<FVector>& InPoints)
+            : Points(InPoints)
+        {
+        }
 
-    PartitionOutsideSet(PendingFaces, AllFaces, UniquePoints, UnassignedPoints, HeadFace);
+        bool Build();
 
-    const float Epsilon = 0.0001f;
-    while (PendingFaces.Num() > 0)
-    {
-        FFace* CurrentFace = PendingFaces[0];
-        PendingFaces.RemoveAt(0);
+        void GetHullVertices(TArray<FVector>& OutVertices) const;
 
-        int32 FurthestPointIdx = FindFurthestPoint(UniquePoints, CurrentFace);
-        if (FurthestPointIdx == -1)
-        {
-            continue;
-        }
+    private:
+        const TArray<FVector>& Points;
 
-        CurrentFace->OutsidePoints.Remove(FurthestPointIdx);
+        TArray<FHullFace> Faces;
+        TArray<int32> FreeFaces;
+        TArray<int32> PointNext;
 
-        TArray<FFace*> VisibleFaces;
-        TMap<int32, FBoundaryEdge> BoundaryEdges;
-        FindVisibleFaces(UniquePoints, FurthestPointIdx, CurrentFace, VisibleFaces, BoundaryEdges);
+        TArray<int32> FaceQueue;
+        int32 QueueHead = 0;
 
-        if (VisibleFaces.Num() == 0 || BoundaryEdges.Num() < 3)
-        {
-            continue;
-        }
+        uint32 CurrentEpoch = 0;
+        float Epsilon = KINDA_SMALL_NUMBER;
 
-        TArray<int32> UnassignedPointsForNewFaces;
-        for (FFace* VisFace : VisibleFaces)
-        {
-            UnassignedPointsForNewFaces.Append(VisFace->OutsidePoints);
-            VisFace->OutsidePoints.Empty();
-            
-            PendingFaces.Remove(VisFace);
-        }
+        // 每次加点复用的临时缓冲
+        TArray<FHorizonFrame> HorizonStack;
+        TArray<FHorizonEdge> Horizon;
+        TArray<int32> VisibleFaces;
+        TArray<int32> OrphanPoints;
+        TArray<int32> NewFaces;
 
-        TArray<FFace*> NewFaces;
-        ConstructNewFaces(UniquePoints, FurthestPointIdx, NewFaces, BoundaryEdges, VisibleFaces);
-        
-        AllFaces.Append(NewFaces);
+        int32 AllocateFace(int32 A, int32 B, int32 C);
+        void ReleaseFace(int32 FaceIndex);
 
-        for (FFace* VisFace : VisibleFaces)
-        {
-            AllFaces.Remove(VisFace);
-            delete VisFace;
-        }
+        void AssignPoint(int32 PointIndex, const TArray<int32>& CandidateFaces);
+        void RemovePointFromFace(int32 FaceIndex, int32 PointIndex);
 
-        PartitionOutsideSet(PendingFaces, NewFaces, UniquePoints, UnassignedPointsForNewFaces, HeadFace);
-    }
+        bool BuildInitialSimplex();
+        void ComputeHorizon(const FVector& EyePoint, int32 StartFace);
+        bool AddEyePoint(int32 FaceIndex, int32 EyeIndex);
 
-    TSet<int32> HullVertexIndices;
-    TArray<FFace*> VisitedFaces;
-    
-    if (HeadFace)
-    {
-        TArray<FFace*> Stack;
-        Stack.Add(HeadFace);
-        HeadFace->bVisited = true;
-        VisitedFaces.Add(HeadFace);
+        static int32 FindEdge(const FHullFace& Face, int32 From, int32 To);
+    };
 
-        while (Stack.Num() > 0)
+    int32 FQuickHull::FindEdge(const FHullFace& Face, int32 From, int32 To)
+    {
+        for (int32 Edge = 0; Edge < 3; ++Edge)
         {
-            FFace* Current = Stack.Pop();
-            HullVertexIndices.Add(Current->V0);
-            HullVertexIndices.Add(Current->V1);
-            HullVertexIndices.Add(Current->V2);
-
-            for (int32 i = 0; i < 3; ++i)
+            if (Face.V[Edge] == From && Face.V[(Edge + 1) % 3] == To)
             {
-                if (Current->Neighbor[i] && !Current->Neighbor[i]->bVisited)
-                {
-                    Current->Neighbor[i]->bVisited = true;
-                    VisitedFaces.Add(Current->Neighbor[i]);
-                    Stack.Add(Current->Neighbor[i]);
-                }
+                return Edge;
             }
         }
+        return INDEX_NONE;
     }
 
-    for (FFace* Face : VisitedFaces)
+    int32 FQuickHull::AllocateFace(int32 A, int32 B, int32 C)
     {
-        Face->bVisited = false;
-    }
-
-    OutConvexElem.VertexData.Empty();
-    OutConvexElem.VertexData.Reserve(HullVertexIndices.Num());
-    for (int32 VertIdx : HullVertexIndices)
-    {
-        if (VertIdx < UniquePoints.Num())
+        int32 FaceIndex;
+        if (FreeFaces.Num() > 0)
+        {
+            FaceIndex = FreeFaces.Pop(false);
+        }
+        else
         {
-            OutConvexElem.VertexData.Add(UniquePoints[VertIdx]);
+            FaceIndex = Faces.AddUninitialized();
         }
+
+        FHullFace& Face = Faces[FaceIndex];
+        Face.V[0] = A;
+        Face.V[1] = B;
+        Face.V[2] = C;
+        Face.Neighbor[0] = Face.Neighbor[1] = Face.Neighbor[2] = INDEX_NONE;
+
+        const FVector& P0 = Points[A];
+        const FVector& P1 = Points[B];
+        const FVector& P2 = Points[C];
+        Face.Normal = FVector::CrossProduct(P1 - P0, P2 - P0).GetSafeNormal();
+        Face.PlaneW = FVector::DotProduct(Face.Normal, (P0 + P1 + P2) / 3.0f);
+
+        Face.OutsideHead = INDEX_NONE;
+        Face.FurthestPoint = INDEX_NONE;
+        Face.FurthestDistance = 0.0f;
+        Face.VisitEpoch = 0;
+        Face.bAlive = true;
+
+        return FaceIndex;
     }
 
-    for (FFace* Face : AllFaces)
+    void FQuickHull::ReleaseFace(int32 FaceIndex)
     {
-        delete Face;
+        FHullFace& Face = Faces[FaceIndex];
+        Face.bAlive = false;
+        Face.OutsideHead = INDEX_NONE;
+        Face.FurthestPoint = INDEX_NONE;
+        FreeFaces.Add(FaceIndex);
     }
 
-    if (OutConvexElem.VertexData.Num() > 32)
+    void FQuickHull::AssignPoint(int32 PointIndex, const TArray<int32>& CandidateFaces)
     {
-        FVector Center(0);
-        for (const FVector& P : OutConvexElem.VertexData)
+        const FVector& Point = Points[PointIndex];
+        for (int32 FaceIndex : CandidateFaces)
         {
-            Center += P;
+            FHullFace& Face = Faces[FaceIndex];
+            const float Distance = Face.GetDistance(Point);
+            if (Distance > Epsilon)
+            {
+                PointNext[PointIndex] = Face.OutsideHead;
+                Face.OutsideHead = PointIndex;
+                if (Distance > Face.FurthestDistance || Face.FurthestPoint == INDEX_NONE)
+                {
+                    Face.FurthestDistance = Distance;
+                    Face.FurthestPoint = PointIndex;
+                }
+                return;
+            }
         }
-        Center /= OutConvexElem.VertexData.Num();
-
-        OutConvexElem.VertexData.Sort([&Center](const FVector& A, const FVector& B) {
-            return FVector::DistSquared(A, Center) > FVector::DistSquared(B, Center);
-        });
-        OutConvexElem.VertexData.SetNum(32);
+        // 不在任何新面外侧的点已在凸包内部，直接丢弃
     }
 
-    OutConvexElem.UpdateElemBox();
-    return OutConvexElem.VertexData.Num() >= 4;
-}
-
-bool FModelGenConvexDecomp::IsCollinear(const FVector& P0, const FVector& P1, const FVector& P2, float Epsilon)
-{
-    FVector Normal = FVector::CrossProduct(P1 - P0, P2 - P0);
-    return Normal.SizeSquared() < Epsilon * Epsilon;
-}
+    void FQuickHull::RemovePointFromFace(int32 FaceIndex, int32 PointIndex)
+    {
+        FHullFace& Face = Faces[FaceIndex];
 
-bool FModelGenConvexDecomp::IsCoplanar(const FVector& P0, const FVector& P1, const FVector& P2, const FVector& P3, float Epsilon)
-{
-    FVector Normal = FVector::CrossProduct(P1 - P0, P2 - P0);
-    float Dist = FMath::Abs(FVector::DotProduct(Normal, P3 - P0));
-    return Dist < Epsilon;
-}
+        int32 Remaining = Face.OutsideHead;
+        Face.OutsideHead = INDEX_NONE;
+        Face.FurthestPoint = INDEX_NONE;
+        Face.FurthestDistance = 0.0f;
 
-bool FModelGenConvexDecomp::BuildInitialTetrahedron(
-    const TArray<FVector>& Points,
-    TArray<FFace*>& OutFaces,
-    TArray<int32>& OutUnassignedPoints)
-{
-    if (Points.Num() < 4)
-    {
-        return false;
-    }
+        while (Remaining != INDEX_NONE)
+        {
+            const int32 Current = Remaining;
+            Remaining = PointNext[Current];
+            if (Current == PointIndex)
+            {
+                continue;
+            }
 
-    const float Epsilon = 0.0001f;
+            PointNext[Current] = Face.OutsideHead;
+            Face.OutsideHead = Current;
 
-    int32 P0Idx = 0, P1Idx = 1, P2Idx = Points.Num() - 1;
-    while (P1Idx < P2Idx && IsCollinear(Points[P0Idx], Points[P1Idx], Points[P2Idx], Epsilon))
-    {
-        P1Idx++;
-    }
-    if (P1Idx >= P2Idx)
-    {
-        return false;
+            const float Distance = Face.GetDistance(Points[Current]);
+            if (Face.FurthestPoint == INDEX_NONE || Distance > Face.FurthestDistance)
+            {
+                Face.FurthestDistance = Distance;
+                Face.FurthestPoint = Current;
+            }
+        }
     }
 
-    int32 MinXIdx = 0, MaxXIdx = 0, MinYIdx = 0;
-    for (int32 i = 1; i < Points.Num(); ++i)
+    bool FQuickHull::BuildInitialSimplex()
     {
-        if (Points[i].X < Points[MinXIdx].X) MinXIdx = i;
-        else if (Points[i].X > Points[MaxXIdx].X) MaxXIdx = i;
-        if (Points[i].Y < Points[MinYIdx].Y) MinYIdx = i;
-    }
+        const int32 NumPoints = Points.Num();
 
-    if (!IsCollinear(Points[MinXIdx], Points[MaxXIdx], Points[MinYIdx], Epsilon))
-    {
-        P0Idx = MinXIdx;
-        P1Idx = MaxXIdx;
-        P2Idx = MinYIdx;
-    }
+        int32 MinIndex[3] = { 0, 0, 0 };
+        int32 MaxIndex[3] = { 0, 0, 0 };
+        for (int32 i = 1; i < NumPoints; ++i)
+        {
+            for (int32 Axis = 0; Axis < 3; ++Axis)
+            {
+                if (Points[i][Axis] < Points[MinIndex[Axis]][Axis]) MinIndex[Axis] = i;
+                if (Points[i][Axis] > Points[MaxIndex[Axis]][Axis]) MaxIndex[Axis] = i;
+            }
+        }
 
-    FVector Normal = FVector::CrossProduct(Points[P1Idx] - Points[P0Idx], Points[P2Idx] - Points[P0Idx]);
-    float NormalLen = Normal.Size();
-    if (NormalLen < Epsilon)
-    {
-        return false;
-    }
-    Normal /= NormalLen;
-    float D = -FVector::DotProduct(Normal, Points[P0Idx]);
+        // 容差与坐标量级相关，避免大尺寸网格上的浮点误差产生伪面
+        const FVector MaxAbs(
+            FMath::Max(FMath::Abs(Points[MinIndex[0]].X), FMath::Abs(Points[MaxIndex[0]].X)),
+            FMath::Max(FMath::Abs(Points[MinIndex[1]].Y), FMath::Abs(Points[MaxIndex[1]].Y)),
+            FMath::Max(FMath::Abs(Points[MinIndex[2]].Z), FMath::Abs(Points[MaxIndex[2]].Z)));
+        Epsilon = FMath::Max(3.0f * FLT_EPSILON * (MaxAbs.X + MaxAbs.Y + MaxAbs.Z), KINDA_SMALL_NUMBER);
 
-    float MinDist = 0.0f, MaxDist = 0.0f;
-    int32 MinDistIdx = -1, MaxDistIdx = -1;
-    for (int32 i = 0; i < Points.Num(); ++i)
-    {
-        if (i == P0Idx || i == P1Idx || i == P2Idx) continue;
-        float Dist = FVector::DotProduct(Normal, Points[i]) + D;
-        if (Dist < MinDist)
+        int32 BestAxis = 0;
+        float BestSpan = -1.0f;
+        for (int32 Axis = 0; Axis < 3; ++Axis)
         {
-            MinDist = Dist;
-            MinDistIdx = i;
+            const float Span = Points[MaxIndex[Axis]][Axis] - Points[MinIndex[Axis]][Axis];
+            if (Span > BestSpan)
+            {
+                BestSpan = Span;
+                BestAxis = Axis;
+            }
         }
-        if (Dist > MaxDist)
+
+        int32 I0 = MinIndex[BestAxis];
+        int32 I1 = MaxIndex[BestAxis];
+        if (BestSpan <= Epsilon)
         {
-            MaxDist = Dist;
-            MaxDistIdx = i;
+            return false;
         }
-    }
 
-    int32 P3Idx = MaxDistIdx;
-    if (P3Idx == -1 || IsCoplanar(Points[P0Idx], Points[P1Idx], Points[P2Idx], Points[P3Idx], Epsilon))
-    {
-        if (MinDistIdx != -1)
+        const FVector LineDir = (Points[I1] - Points[I0]).GetSafeNormal();
+        int32 I2 = INDEX_NONE;
+        float BestLineDistSq = Epsilon * Epsilon;
+        for (int32 i = 0; i < NumPoints; ++i)
         {
-            int32 Temp = P0Idx;
-            P0Idx = P2Idx;
-            P2Idx = Temp;
-            P3Idx = MinDistIdx;
-            if (IsCoplanar(Points[P0Idx], Points[P1Idx], Points[P2Idx], Points[P3Idx], Epsilon))
+            const float DistSq = FVector::CrossProduct(Points[i] - Points[I0], LineDir).SizeSquared();
+            if (DistSq > BestLineDistSq)
             {
-                return false;
+                BestLineDistSq = DistSq;
+                I2 = i;
             }
         }
-        else
+        if (I2 == INDEX_NONE)
         {
             return false;
         }
-    }
-
-    FFace* F0 = new FFace(P0Idx, P2Idx, P1Idx);
-    FFace* F1 = new FFace(P0Idx, P1Idx, P3Idx);
-    FFace* F2 = new FFace(P0Idx, P3Idx, P2Idx);
-    FFace* F3 = new FFace(P1Idx, P2Idx, P3Idx);
 
-    F0->Neighbor[0] = F2;
-    F0->Neighbor[1] = F3;
-    F0->Neighbor[2] = F1;
+        const FVector BaseNormal = FVector::CrossProduct(Points[I1] - Points[I0], Points[I2] - Points[I0]).GetSafeNormal();
+        int32 I3 = INDEX_NONE;
+        float BestPlaneDist = Epsilon;
+        for (int32 i = 0; i < NumPoints; ++i)
+        {
+            const float Dist = FMath::Abs(FVector::DotProduct(Points[i] - Points[I0], BaseNormal));
+            if (Dist > BestPlaneDist)
+            {
+                BestPlaneDist = Dist;
+                I3 = i;
+            }
+        }
+        if (I3 == INDEX_NONE)
+        {
+            return false;
+        }
 
-    F1->Neighbor[0] = F0;
-    F1->Neighbor[1] = F3;
-    F1->Neighbor[2] = F2;
+        // 底面法线需背离第四个点
+        if (FVector::DotProduct(Points[I3] - Points[I0], BaseNormal) > 0.0f)
+        {
+            Swap(I1, I2);
+        }
 
-    F2->Neighbor[0] = F1;
-    F2->Neighbor[1] = F3;
-    F2->Neighbor[2] = F0;
+        const int32 SimplexFaces[4] = {
+            AllocateFace(I0, I1, I2),
+            AllocateFace(I1, I0, I3),
+            AllocateFace(I2, I1, I3),
+            AllocateFace(I0, I2, I3)
+        };
 
-    F3->Neighbor[0] = F0;
-    F3->Neighbor[1] = F2;
-    F3->Neighbor[2] = F1;
+        for (int32 FaceIndex : SimplexFaces)
+        {
+            FHullFace& Face = Faces[FaceIndex];
+            for (int32 Edge = 0; Edge < 3; ++Edge)
+            {
+                const int32 From = Face.V[Edge];
+                const int32 To = Face.V[(Edge + 1) % 3];
+                for (int32 OtherIndex : SimplexFaces)
+                {
+                    if (OtherIndex != FaceIndex && FindEdge(Faces[OtherIndex], To, From) != INDEX_NONE)
+                    {
+                        Face.Neighbor[Edge] = OtherIndex;
+                        break;
+                    }
+                }
+            }
+        }
 
-    OutFaces.Add(F0);
-    OutFaces.Add(F1);
-    OutFaces.Add(F2);
-    OutFaces.Add(F3);
+        TArray<int32> InitialFaces;
+        InitialFaces.Append(SimplexFaces, 4);
+        for (int32 i = 0; i < NumPoints; ++i)
+        {
+            if (i != I0 && i != I1 && i != I2 && i != I3)
+            {
+                AssignPoint(i, InitialFaces);
+            }
+        }
 
-    OutUnassignedPoints.Remove(P0Idx);
-    OutUnassignedPoints.Remove(P1Idx);
-    OutUnassignedPoints.Remove(P2Idx);
-    OutUnassignedPoints.Remove(P3Idx);
+        for (int32 FaceIndex : SimplexFaces)
+        {
+            if (Faces[FaceIndex].OutsideHead != INDEX_NONE)
+            {
+                FaceQueue.Add(FaceIndex);
+            }
+        }
 
-    return true;
-}
+        return true;
+    }
 
-int32 FModelGenConvexDecomp::FindFurthestPoint(const TArray<FVector>& Points, FFace* Face)
-{
-    if (!Face || Face->OutsidePoints.Num() == 0)
+    void FQuickHull::ComputeHorizon(const FVector& EyePoint, int32 StartFace)
     {
-        return -1;
-    }
+        // 深度优先遍历可见面；进入邻面时从进入边的下一条边开始，使地平线边按环路顺序输出
+        Horizon.Reset();
+        VisibleFaces.Reset();
+        HorizonStack.Reset();
 
-    float MaxDist = -1.0f;
-    int32 FurthestIdx = -1;
+        Faces[StartFace].VisitEpoch = CurrentEpoch;
+        VisibleFaces.Add(StartFace);
+        HorizonStack.Add({ StartFace, 0, 0 });
 
-    for (int32 PointIdx : Face->OutsidePoints)
-    {
-        if (PointIdx >= Points.Num()) continue;
-        float Dist = Face->GetDistance(Points, Points[PointIdx]);
-        if (Dist > MaxDist)
+        while (HorizonStack.Num() > 0)
         {
-            MaxDist = Dist;
-            FurthestIdx = PointIdx;
-        }
-    }
+            FHorizonFrame& Frame = HorizonStack.Last();
+            if (Frame.Step == 3)
+            {
+                HorizonStack.Pop(false);
+                continue;
+            }
 
-    return FurthestIdx;
-}
+            const int32 FaceIndex = Frame.Face;
+            const int32 Edge = (Frame.FirstEdge + Frame.Step) % 3;
+            ++Frame.Step;
 
-void FModelGenConvexDecomp::FindVisibleFaces(
-    const TArray<FVector>& Points,
-    int32 PointIndex,
-    FFace* StartFace,
-    TArray<FFace*>& OutVisibleFaces,
-    TMap<int32, FBoundaryEdge>& OutBoundaryEdges)
-{
-    OutVisibleFaces.Empty();
-    OutBoundaryEdges.Empty();
+            const FHullFace& Face = Faces[FaceIndex];
+            const int32 NeighborIndex = Face.Neighbor[Edge];
+            FHullFace& Neighbor = Faces[NeighborIndex];
+            if (Neighbor.VisitEpoch == CurrentEpoch)
+            {
+                continue;
+            }
 
-    if (!StartFace) return;
+            const int32 From = Face.V[Edge];
+            const int32 To = Face.V[(Edge + 1) % 3];
 
-    TSet<FFace*> BoundaryFaces;
+            if (Neighbor.GetDistance(EyePoint) > Epsilon)
+            {
+                Neighbor.VisitEpoch = CurrentEpoch;
+                VisibleFaces.Add(NeighborIndex);
 
-    TArray<FFace*> Stack;
-    Stack.Add(StartFace);
-    StartFace->bVisited = true;
-    OutVisibleFaces.Add(StartFace);
+                const int32 EnterEdge = FindEdge(Neighbor, To, From);
+                HorizonStack.Add({ NeighborIndex, (EnterEdge + 1) % 3, 0 });
+            }
+            else
+            {
+                Horizon.Add({ From, To, NeighborIndex });
+            }
+        }
+    }
 
-    while (Stack.Num() > 0)
+    bool FQuickHull::AddEyePoint(int32 FaceIndex, int32 EyeIndex)
     {
-        FFace* Current = Stack.Pop();
+        ++CurrentEpoch;
+        ComputeHorizon(Points[EyeIndex], FaceIndex);
 
-        for (int32 i = 0; i < 3; ++i)
+        // 数值退化时地平线可能不闭合，丢弃该点继续
+        bool bClosedHorizon = Horizon.Num() >= 3;
+        for (int32 i = 0; bClosedHorizon && i < Horizon.Num(); ++i)
         {
-            FFace* Neighbor = Current->Neighbor[i];
-            if (!Neighbor) continue;
-            
-            if (Neighbor->bVisited) continue;
+            bClosedHorizon = Horizon[i].V1 == Horizon[(i + 1) % Horizon.Num()].V0;
+        }
+        if (!bClosedHorizon)
+        {
+            RemovePointFromFace(FaceIndex, EyeIndex);
+            return false;
+        }
 
-            float Dist = Neighbor->GetDistance(Points, Points[PointIndex]);
-            if (Dist > 0.0001f)
-            {
-                Neighbor->bVisited = true;
-                OutVisibleFaces.Add(Neighbor);
-                Stack.Add(Neighbor);
-            }
-            else
+        OrphanPoints.Reset();
+        for (int32 VisibleIndex : VisibleFaces)
+        {
+            for (int32 PointIndex = Faces[VisibleIndex].OutsideHead; PointIndex != INDEX_NONE; PointIndex = PointNext[PointIndex])
             {
-                int32 V0 = Current->V0;
-                int32 V1 = Current->V1;
-                int32 V2 = Current->V2;
-                
-                int32 EdgeV0, EdgeV1;
-                if (i == 0)
-                {
-                    EdgeV0 = V0;
-                    EdgeV1 = V1;
-                }
-                else if (i == 1)
+                if (PointIndex != EyeIndex)
                 {
-                    EdgeV0 = V1;
-                    EdgeV1 = V2;
-                }
-                else
-                {
-                    EdgeV0 = V2;
-                    EdgeV1 = V0;
-                }
-                
-                int32 Key = FMath::Min(EdgeV0, EdgeV1) * 10000 + FMath::Max(EdgeV0, EdgeV1);
-                if (!OutBoundaryEdges.Contains(Key))
-                {
-                    OutBoundaryEdges.Add(Key, FBoundaryEdge(EdgeV0, EdgeV1, Neighbor));
-                    BoundaryFaces.Add(Neighbor);
+                    OrphanPoints.Add(PointIndex);
                 }
             }
+            ReleaseFace(VisibleIndex);
         }
-    }
 
-    for (FFace* Face : OutVisibleFaces)
-    {
-        Face->bVisited = false;
-    }
-    for (FFace* Face : BoundaryFaces)
-    {
-        Face->bVisited = false;
-    }
-}
+        NewFaces.Reset();
+        for (const FHorizonEdge& HorizonEdge : Horizon)
+        {
+            const int32 NewIndex = AllocateFace(HorizonEdge.V0, HorizonEdge.V1, EyeIndex);
+            FHullFace& OuterFace = Faces[HorizonEdge.OuterFace];
+            OuterFace.Neighbor[FindEdge(OuterFace, HorizonEdge.V1, HorizonEdge.V0)] = NewIndex;
+            Faces[NewIndex].Neighbor[0] = HorizonEdge.OuterFace;
+            NewFaces.Add(NewIndex);
+        }
 
-void FModelGenConvexDecomp::ConstructNewFaces(
-    const TArray<FVector>& Points,
-    int32 PointIndex,
-    TArray<FFace*>& OutNewFaces,
-    TMap<int32, FBoundaryEdge>& BoundaryEdges,
-    const TArray<FFace*>& VisibleFaces)
-{
-    OutNewFaces.Empty();
+        const int32 NumNewFaces = NewFaces.Num();
+        for (int32 i = 0; i < NumNewFaces; ++i)
+        {
+            FHullFace& NewFace = Faces[NewFaces[i]];
+            NewFace.Neighbor[1] = NewFaces[(i + 1) % NumNewFaces];
+            NewFace.Neighbor[2] = NewFaces[(i + NumNewFaces - 1) % NumNewFaces];
+        }
 
-    if (BoundaryEdges.Num() < 3) return;
+        for (int32 PointIndex : OrphanPoints)
+        {
+            AssignPoint(PointIndex, NewFaces);
+        }
 
-    TArray<FBoundaryEdge> EdgeList;
-    for (auto& Pair : BoundaryEdges)
-    {
-        EdgeList.Add(Pair.Value);
+        for (int32 NewIndex : NewFaces)
+        {
+            if (Faces[NewIndex].OutsideHead != INDEX_NONE)
+            {
+                FaceQueue.Add(NewIndex);
+            }
+        }
+
+        return true;
     }
 
-    TArray<FBoundaryEdge> OrderedEdges;
-    if (EdgeList.Num() > 0)
+    bool FQuickHull::Build()
     {
-        OrderedEdges.Add(EdgeList[0]);
-        EdgeList.RemoveAt(0);
+        const int32 NumPoints = Points.Num();
+        if (NumPoints < 4)
+        {
+            return false;
+        }
+
+        PointNext.Init(INDEX_NONE, NumPoints);
+        Faces.Reserve(NumPoints * 2);
 
-        while (EdgeList.Num() > 0)
+        if (!BuildInitialSimplex())
         {
-            int32 LastV1 = OrderedEdges.Last().V1;
-            bool bFound = false;
-            for (int32 i = 0; i < EdgeList.Num(); ++i)
+            return false;
+        }
+
+        // 每次迭代至少消耗一个外侧点，迭代次数不会超过点数
+        int32 RemainingIterations = NumPoints;
+        while (QueueHead < FaceQueue.Num() && RemainingIterations > 0)
+        {
+            const int32 FaceIndex = FaceQueue[QueueHead++];
+            const FHullFace& Face = Faces[FaceIndex];
+            if (!Face.bAlive || Face.FurthestPoint == INDEX_NONE)
             {
-                if (EdgeList[i].V0 == LastV1)
-                {
-                    OrderedEdges.Add(EdgeList[i]);
-                    EdgeList.RemoveAt(i);
-                    bFound = true;
-                    break;
-                }
+                continue;
+            }
+
+            --RemainingIterations;
+            const int32 EyeIndex = Face.FurthestPoint;
+            if (!AddEyePoint(FaceIndex, EyeIndex) && Faces[FaceIndex].OutsideHead != INDEX_NONE)
+            {
+                FaceQueue.Add(FaceIndex);
+            }
+
+            // 已出队部分过半时整体前移，避免队列无限增长
+            if (QueueHead > 1024 && QueueHead * 2 > FaceQueue.Num())
+            {
+                FaceQueue.RemoveAt(0, QueueHead, false);
+                QueueHead = 0;
             }
-            if (!bFound) break;
         }
+
+        return true;
     }
 
-    for (const FBoundaryEdge& Edge : OrderedEdges)
+    void FQuickHull::GetHullVertices(TArray<FVector>& OutVertices) const
     {
-        FFace* NewFace = new FFace(PointIndex, Edge.V0, Edge.V1);
-        
-        NewFace->Neighbor[1] = Edge.NeighborFace;
-        if (Edge.NeighborFace)
+        OutVertices.Reset();
+
+        TBitArray<> UsedPoints(false, Points.Num());
+        for (const FHullFace& Face : Faces)
         {
-            for (int32 i = 0; i < 3; ++i)
+            if (!Face.bAlive)
             {
-                FFace* OldNeighbor = Edge.NeighborFace->Neighbor[i];
-                if (!OldNeighbor) continue;
-                
-                bool bSharesEdge = false;
-                if ((OldNeighbor->V0 == Edge.V0 && OldNeighbor->V1 == Edge.V1) ||
-                    (OldNeighbor->V1 == Edge.V0 && OldNeighbor->V2 == Edge.V1) ||
-                    (OldNeighbor->V2 == Edge.V0 && OldNeighbor->V0 == Edge.V1) ||
-                    (OldNeighbor->V0 == Edge.V1 && OldNeighbor->V1 == Edge.V0) ||
-                    (OldNeighbor->V1 == Edge.V1 && OldNeighbor->V2 == Edge.V0) ||
-                    (OldNeighbor->V2 == Edge.V1 && OldNeighbor->V0 == Edge.V0))
-                {
-                    bSharesEdge = true;
-                }
-                
-                if (bSharesEdge)
+                continue;
+            }
+
+            for (int32 Corner = 0; Corner < 3; ++Corner)
+            {
+                const int32 PointIndex = Face.V[Corner];
+                if (!UsedPoints[PointIndex])
                 {
-                    bool bIsVisible = VisibleFaces.Contains(OldNeighbor);
-                    
-                    if (bIsVisible)
-                    {
-                        Edge.NeighborFace->Neighbor[i] = NewFace;
-                        break;
-                    }
+                    UsedPoints[PointIndex] = true;
+                    OutVertices.Add(Points[PointIndex]);
                 }
             }
         }
-
-        OutNewFaces.Add(NewFace);
-    }
-
-    for (int32 i = 0; i < OutNewFaces.Num(); ++i)
-    {
-        int32 PrevIdx = (i - 1 + OutNewFaces.Num()) % OutNewFaces.Num();
-        int32 NextIdx = (i + 1) % OutNewFaces.Num();
-        OutNewFaces[i]->Neighbor[0] = OutNewFaces[PrevIdx];
-        OutNewFaces[i]->Neighbor[2] = OutNewFaces[NextIdx];
     }
 }
 
-void FModelGenConvexDecomp::PartitionOutsideSet(
-    TArray<FFace*>& PendingFaces,
-    TArray<FFace*>& NewFaces,
-    const TArray<FVector>& Points,
-    TArray<int32>& UnassignedPoints,
-    FFace*& HeadFace)
+bool FModelGenConvexDecomp::GenerateConvexHull(const TArray<FVector>& Points, FKConvexElem& OutConvexElem)
 {
-    for (FFace* Face : NewFaces)
+    if (Points.Num() < 4)
     {
-        Face->OutsidePoints.Empty();
-        
-        for (int32 i = UnassignedPoints.Num() - 1; i >= 0; --i)
-        {
-            int32 PointIdx = UnassignedPoints[i];
-            if (PointIdx >= Points.Num()) continue;
-            if (PointIdx == Face->V0 || PointIdx == Face->V1 || PointIdx == Face->V2) continue;
+        return false;
+    }
 
-            float Dist = Face->GetDistance(Points, Points[PointIdx]);
-            if (Dist > 0.0001f)
-            {
-                Face->OutsidePoints.Add(PointIdx);
-                UnassignedPoints.RemoveAt(i);
-            }
-        }
+    TArray<FVector> UniquePoints;
+    UniquePoints.Reserve(Points.Num());
+    TSet<FIntVector> QuantizedSet;
+    QuantizedSet.Reserve(Points.Num());
+    const float QuantizeScale = 100.0f;
 
-        if (Face->OutsidePoints.Num() > 0)
+    for (const FVector& Point : Points)
+    {
+        FIntVector Quantized(
+            FMath::RoundToInt(Point.X * QuantizeScale),
+            FMath::RoundToInt(Point.Y * QuantizeScale),
+            FMath::RoundToInt(Point.Z * QuantizeScale)
+        );
+
+        bool bAlreadyInSet = false;
+        QuantizedSet.Add(Quantized, &bAlreadyInSet);
+        if (!bAlreadyInSet)
         {
-            PendingFaces.Add(Face);
+            UniquePoints.Add(Point);
         }
-        else
+    }
+
+    if (UniquePoints.Num() < 4)
+    {
+        UniquePoints = Points;
+    }
+
+    FQuickHull QuickHull(UniquePoints);
+    if (!QuickHull.Build())
+    {
+        OutConvexElem.VertexData = UniquePoints;
+        OutConvexElem.UpdateElemBox();
+        return UniquePoints.Num() >= 4;
+    }
+
+    QuickHull.GetHullVertices(OutConvexElem.VertexData);
+
+    if (OutConvexElem.VertexData.Num() > 32)
+    {
+        FVector Center(0);
+        for (const FVector& P : OutConvexElem.VertexData)
         {
-            HeadFace = Face;
+            Center += P;
         }
+        Center /= OutConvexElem.VertexData.Num();
+
+        OutConvexElem.VertexData.Sort([&Center](const FVector& A, const FVector& B) {
+            return FVector::DistSquared(A, Center) > FVector::DistSquared(B, Center);
+        });
+        OutConvexElem.VertexData.SetNum(32);
     }
-}
 
+    OutConvexElem.UpdateElemBox();
+    return OutConvexElem.VertexData.Num() >= 4;
+}
 
 FBox FModelGenConvexDecomp::CalculateTriangleBounds(const FMeshData& MeshData, const TArray<int32>& TriangleIndices)
 {
@@ -0,0 +1,626 @@
+// Copyright (c) 2024. All rights reserved.
+
+#include "ModelGenDiskCache.h"
+#include "ModelGenMeshBuilder.h"
+#include "ModelGenMeshData.h"
+#include "ModelGen.h"
+#include "ModelGenStats.h"
+#include "PhysXIncludes.h"
+#include "HAL/FileManager.h"
+#include "HAL/PlatformFilemanager.h"
+#include "Async/MappedFileHandle.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Misc/CommandLine.h"
+#include "Misc/Parse.h"
+#include "Misc/Guid.h"
+#include "Misc/ScopeLock.h"
+
+DECLARE_CYCLE_STAT(TEXT("Disk Cache Read"), STAT_ModelGen_DiskCacheRead, STATGROUP_ModelGen);
+DECLARE_CYCLE_STAT(TEXT("Disk Cache Write"), STAT_ModelGen_DiskCacheWrite, STATGROUP_ModelGen);
+
+namespace
+{
+    constexpr uint32 MeshFileMagic = 0x444D474D;        // "MGMD"
+    constexpr uint32 CollisionFileMagic = 0x4343474D;   // "MGCC"
+
+    // 文件布局变化时递增
+    constexpr uint32 FileFormatVersion = 1;
+
+    constexpr int64 StreamAlignment = 16;
+
+    constexpr int64 DefaultByteBudgetMB = 512;
+
+    // 超过这个天数未被读写的文件在清理时直接删除
+    constexpr double MaxFileAgeDays = 30.0;
+
+    // 超出预算时删到预算的这一比例，避免之后每次写入都触发扫描
+    constexpr double PruneTargetRatio = 0.8;
+
+    // 崩溃遗留的临时文件超过这个时长才删除，以免误删其他进程正在写的文件
+    constexpr double StaleTempFileHours = 1.0;
+
+    struct FFileHeader
+    {
+        uint32 Magic;
+        uint32 FormatVersion;
+        uint32 ContentVersion;
+        uint32 NumStreams;
+        uint64 KeyLow;
+        uint64 KeyHigh;
+        uint64 FileSize;
+    };
+
+    struct FStreamDesc
+    {
+        uint64 Offset;
+        uint32 Count;
+        uint32 ElementSize;
+    };
+
+    enum EMeshStream
+    {
+        MeshStream_Positions,
+        MeshStream_Indices,
+        MeshStream_Normals,
+        MeshStream_UVs,
+        MeshStream_Colors,
+        MeshStream_TangentX,
+        MeshStream_TangentFlip,
+        MeshStream_Count
+    };
+
+    struct FStreamSource
+    {
+        const void* Data;
+        int32 Count;
+        uint32 ElementSize;
+    };
+
+    struct FStreamView
+    {
+        const uint8* Data = nullptr;
+        int32 Count = 0;
+    };
+
+    void BuildFileBuffer(uint32 Magic, uint32 ContentVersion, const FModelGenParamsHash& Key,
+        const TArray<FStreamSource>& Streams, TArray<uint8>& OutBuffer)
+    {
+        const int64 TableEnd = sizeof(FFileHeader) + Streams.Num() * sizeof(FStreamDesc);
+
+        TArray<FStreamDesc> Descs;
+        Descs.SetNumUninitialized(Streams.Num());
+
+        int64 Offset = Align(TableEnd, StreamAlignment);
+        for (int32 StreamIndex = 0; StreamIndex < Streams.Num(); ++StreamIndex)
+        {
+            const FStreamSource& Source = Streams[StreamIndex];
+            Descs[StreamIndex] = { static_cast<uint64>(Offset), static_cast<uint32>(Source.Count), Source.ElementSize };
+            Offset = Align(Offset + static_cast<int64>(Source.Count) * Source.ElementSize, StreamAlignment);
+        }
+
+        OutBuffer.Reset();
+        OutBuffer.AddZeroed(Offset);
+
+        FFileHeader Header;
+        Header.Magic = Magic;
+        Header.FormatVersion = FileFormatVersion;
+        Header.ContentVersion = ContentVersion;
+        Header.NumStreams = Streams.Num();
+        Header.KeyLow = Key.Low;
+        Header.KeyHigh = Key.High;
+        Header.FileSize = Offset;
+
+        FMemory::Memcpy(OutBuffer.GetData(), &Header, sizeof(Header));
+        FMemory::Memcpy(OutBuffer.GetData() + sizeof(Header), Descs.GetData(), Descs.Num() * sizeof(FStreamDesc));
+
+        for (int32 StreamIndex = 0; StreamIndex < Streams.Num(); ++StreamIndex)
+        {
+            const FStreamSource& Source = Streams[StreamIndex];
+            if (Source.Count > 0)
+            {
+                FMemory::Memcpy(OutBuffer.GetData() + Descs[StreamIndex].Offset, Source.Data,
+                    static_cast<int64>(Source.Count) * Source.ElementSize);
+            }
+        }
+    }
+
+    // ExpectedElementSizes 与流表逐项比对，防止结构体布局不同的平台误读
+    bool ParseFileBuffer(const uint8* Data, int64 Size, uint32 Magic, uint32 ContentVersion, const FModelGenParamsHash& Key,
+        const TArray<uint32>& ExpectedElementSizes, TArray<FStreamView>& OutStreams)
+    {
+        if (Size < static_cast<int64>(sizeof(FFileHeader)))
+        {
+            return false;
+        }
+
+        FFileHeader Header;
+        FMemory::Memcpy(&Header, Data, sizeof(Header));
+        if (Header.Magic != Magic ||
+            Header.FormatVersion != FileFormatVersion ||
+            Header.ContentVersion != ContentVersion ||
+            Header.KeyLow != Key.Low ||
+            Header.KeyHigh != Key.High ||
+            Header.FileSize != static_cast<uint64>(Size) ||
+            Header.NumStreams != static_cast<uint32>(ExpectedElementSizes.Num()))
+        {
+            return false;
+        }
+
+        const int64 TableEnd = sizeof(FFileHeader) + Header.NumStreams * sizeof(FStreamDesc);
+        if (Size < TableEnd)
+        {
+            return false;
+        }
+
+        OutStreams.SetNum(Header.NumStreams);
+        for (uint32 StreamIndex = 0; StreamIndex < Header.NumStreams; ++StreamIndex)
+        {
+            FStreamDesc Desc;
+            FMemory::Memcpy(&Desc, Data + sizeof(FFileHeader) + StreamIndex * sizeof(FStreamDesc), sizeof(Desc));
+
+            const uint64 StreamBytes = static_cast<uint64>(Desc.Count) * Desc.ElementSize;
+            if (Desc.ElementSize != ExpectedElementSizes[StreamIndex] ||
+                Desc.Count > static_cast<uint32>(MAX_int32) ||
+                Desc.Offset < static_cast<uint64>(TableEnd) ||
+                Desc.Offset + StreamBytes > static_cast<uint64>(Size))
+            {
+                return false;
+            }
+
+            OutStreams[StreamIndex].Data = Data + Desc.Offset;
+            OutStreams[StreamIndex].Count = static_cast<int32>(Desc.Count);
+        }
+
+        return true;
+    }
+
+    template <typename T>
+    void CopyStream(const FStreamView& Stream, TArray<T>& OutArray)
+    {
+        OutArray.SetNumUninitialized(Stream.Count);
+        if (Stream.Count > 0)
+        {
+            FMemory::Memcpy(OutArray.GetData(), Stream.Data, Stream.Count * sizeof(T));
+        }
+    }
+
+    FModelGenParamsHash MakeMeshFileKey(const FModelGenParamsHash& ParamsHash)
+    {
+        struct FKeyData
+        {
+            uint64 Low;
+            uint64 High;
+            uint32 GeometryVersion;
+            uint32 FormatVersion;
+        };
+
+        const FKeyData Data = { ParamsHash.Low, ParamsHash.High, FModelGenMeshBuilder::GeometryVersion, FileFormatVersion };
+        return FModelGenParamsHash::ComputeBytes(&Data, sizeof(Data));
+    }
+}
+
+FModelGenDiskCache& FModelGenDiskCache::Get()
+{
+    static FModelGenDiskCache* Instance = new FModelGenDiskCache();
+    return *Instance;
+}
+
+FModelGenDiskCache::FModelGenDiskCache()
+    : CacheDir(FPaths::ProjectSavedDir() / TEXT("ModelGenCache"))
+    , bEnabled(WITH_EDITOR && FParse::Param(FCommandLine::Get(), TEXT("ModelGenDiskCache")))
+    , ByteBudget(DefaultByteBudgetMB * 1024 * 1024)
+{
+    int64 BudgetMB = 0;
+    if (FParse::Value(FCommandLine::Get(), TEXT("ModelGenDiskCacheBudgetMB="), BudgetMB) && BudgetMB > 0)
+    {
+        ByteBudget = BudgetMB * 1024 * 1024;
+    }
+}
+
+void FModelGenDiskCache::SetCacheDir(const FString& InCacheDir)
+{
+    Flush();
+
+    FScopeLock PruneScopeLock(&PruneLock);
+    FScopeLock WriteScopeLock(&WriteLock);
+    CacheDir = InCacheDir;
+    CachedBytes = -1;
+}
+
+void FModelGenDiskCache::SetByteBudget(int64 InByteBudget)
+{
+    ByteBudget = FMath::Max<int64>(InByteBudget, 0);
+}
+
+FString FModelGenDiskCache::GetMeshPath(const FModelGenParamsHash& ParamsHash) const
+{
+    return CacheDir / TEXT("Mesh") / MakeMeshFileKey(ParamsHash).ToString() + TEXT(".mgm");
+}
+
+FString FModelGenDiskCache::GetCollisionPath(const FModelGenParamsHash& CookKey) const
+{
+    return CacheDir / TEXT("Collision") / CookKey.ToString() + TEXT(".mgc");
+}
+
+bool FModelGenDiskCache::FindOrGenerate(const FModelGenParamsHash& ParamsHash, FModelGenMeshBuilder& Builder, FModelGenMeshData& OutMeshData, bool bPersist)
+{
+    if (!bEnabled || !ParamsHash.IsValid())
+    {
+        return Builder.Generate(OutMeshData);
+    }
+
+    if (LoadMeshData(ParamsHash, OutMeshData))
+    {
+        return true;
+    }
+
+    if (!Builder.Generate(OutMeshData))
+    {
+        return false;
+    }
+
+    if (bPersist && OutMeshData.IsValid())
+    {
+        SaveMeshData(ParamsHash, OutMeshData);
+    }
+    return true;
+}
+
+bool FModelGenDiskCache::LoadMeshData(const FModelGenParamsHash& ParamsHash, FModelGenMeshData& OutMeshData)
+{
+    SCOPE_CYCLE_COUNTER(STAT_ModelGen_DiskCacheRead);
+
+    const FModelGenParamsHash FileKey = MakeMeshFileKey(ParamsHash);
+
+    const bool bLoaded = ReadFile(GetMeshPath(ParamsHash), [&OutMeshData, &FileKey](const uint8* Data, int64 Size)
+    {
+        static const TArray<uint32> ElementSizes = {
+            sizeof(FVector), sizeof(int32), sizeof(FVector), sizeof(FVector2D), sizeof(FLinearColor), sizeof(FVector), sizeof(uint8)
+        };
+
+        TArray<FStreamView> Streams;
+        if (!ParseFileBuffer(Data, Size, MeshFileMagic, FModelGenMeshBuilder::GeometryVersion, FileKey, ElementSizes, Streams) ||
+            Streams[MeshStream_TangentX].Count != Streams[MeshStream_TangentFlip].Count)
+        {
+            return false;
+        }
+
+        OutMeshData.Clear();
+        CopyStream(Streams[MeshStream_Positions], OutMeshData.Vertices);
+        CopyStream(Streams[MeshStream_Indices], OutMeshData.Triangles);
+        CopyStream(Streams[MeshStream_Normals], OutMeshData.Normals);
+        CopyStream(Streams[MeshStream_UVs], OutMeshData.UVs);
+        CopyStream(Streams[MeshStream_Colors], OutMeshData.VertexColors);
+
+        const FStreamView& TangentX = Streams[MeshStream_TangentX];
+        const uint8* TangentFlip = Streams[MeshStream_TangentFlip].Data;
+        OutMeshData.Tangents.SetNumUninitialized(TangentX.Count);
+        for (int32 Index = 0; Index < TangentX.Count; ++Index)
+        {
+            FVector Tangent;
+            FMemory::Memcpy(&Tangent, TangentX.Data + Index * sizeof(FVector), sizeof(FVector));
+            OutMeshData.Tangents[Index] = FProcMeshTangent(Tangent, TangentFlip[Index] != 0);
+        }
+
+        OutMeshData.VertexCount = OutMeshData.Vertices.Num();
+        OutMeshData.TriangleCount = OutMeshData.Triangles.Num() / 3;
+
+        // 索引越界等内容损坏同样视为无效文件
+        if (!OutMeshData.IsValid())
+        {
+            OutMeshData.Clear();
+            return false;
+        }
+        return true;
+    });
+
+    FScopeLock ScopeLock(&StatsLock);
+    ++(bLoaded ? Stats.MeshHitCount : Stats.MeshMissCount);
+    return bLoaded;
+}
+
+bool FModelGenDiskCache::SaveMeshData(const FModelGenParamsHash& ParamsHash, const FModelGenMeshData& MeshData)
+{
+    SCOPE_CYCLE_COUNTER(STAT_ModelGen_DiskCacheWrite);
+
+    // FProcMeshTangent 含填充字节，拆成方向与翻转标志两条紧凑流
+    TArray<FVector> TangentX;
+    TArray<uint8> TangentFlip;
+    TangentX.Reserve(MeshData.Tangents.Num());
+    TangentFlip.Reserve(MeshData.Tangents.Num());
+    for (const FProcMeshTangent& Tangent : MeshData.Tangents)
+    {
+        TangentX.Add(Tangent.TangentX);
+        TangentFlip.Add(Tangent.bFlipTangentY ? 1 : 0);
+    }
+
+    TArray<FStreamSource> Streams;
+    Streams.SetNum(MeshStream_Count);
+    Streams[MeshStream_Positions] = { MeshData.Vertices.GetData(), MeshData.Vertices.Num(), sizeof(FVector) };
+    Streams[MeshStream_Indices] = { MeshData.Triangles.GetData(), MeshData.Triangles.Num(), sizeof(int32) };
+    Streams[MeshStream_Normals] = { MeshData.Normals.GetData(), MeshData.Normals.Num(), sizeof(FVector) };
+    Streams[MeshStream_UVs] = { MeshData.UVs.GetData(), MeshData.UVs.Num(), sizeof(FVector2D) };
+    Streams[MeshStream_Colors] = { MeshData.VertexColors.GetData(), MeshData.VertexColors.Num(), sizeof(FLinearColor) };
+    Streams[MeshStream_TangentX] = { TangentX.GetData(), TangentX.Num(), sizeof(FVector) };
+    Streams[MeshStream_TangentFlip] = { TangentFlip.GetData(), TangentFlip.Num(), sizeof(uint8) };
+
+    TArray<uint8> Buffer;
+    BuildFileBuffer(MeshFileMagic, FModelGenMeshBuilder::GeometryVersion, MakeMeshFileKey(ParamsHash), Streams, Buffer);
+    QueueWrite(GetMeshPath(ParamsHash), MoveTemp(Buffer));
+    return true;
+}
+
+bool FModelGenDiskCache::LoadCookedCollision(const FModelGenParamsHash& CookKey, TArray<uint8>& OutCookedData)
+{
+    SCOPE_CYCLE_COUNTER(STAT_ModelGen_DiskCacheRead);
+
+    const bool bLoaded = ReadFile(GetCollisionPath(CookKey), [&OutCookedData, &CookKey](const uint8* Data, int64 Size)
+    {
+        static const TArray<uint32> ElementSizes = { sizeof(uint8) };
+
+        TArray<FStreamView> Streams;
+        if (!ParseFileBuffer(Data, Size, CollisionFileMagic, PX_PHYSICS_VERSION, CookKey, ElementSizes, Streams) ||
+            Streams[0].Count == 0)
+        {
+            return false;
+        }
+
+        CopyStream(Streams[0], OutCookedData);
+        return true;
+    });
+
+    FScopeLock ScopeLock(&StatsLock);
+    ++(bLoaded ? Stats.CollisionHitCount : Stats.CollisionMissCount);
+    return bLoaded;
+}
+
+bool FModelGenDiskCache::SaveCookedCollision(const FModelGenParamsHash& CookKey, const TArray<uint8>& CookedData)
+{
+    SCOPE_CYCLE_COUNTER(STAT_ModelGen_DiskCacheWrite);
+
+    TArray<FStreamSource> Streams;
+    Streams.Add({ CookedData.GetData(), CookedData.Num(), sizeof(uint8) });
+
+    TArray<uint8> Buffer;
+    BuildFileBuffer(CollisionFileMagic, PX_PHYSICS_VERSION, CookKey, Streams, Buffer);
+    QueueWrite(GetCollisionPath(CookKey), MoveTemp(Buffer));
+    return true;
+}
+
+bool FModelGenDiskCache::ReadFile(const FString& Path, TFunctionRef<bool(const uint8* Data, int64 Size)> Parse)
+{
+    IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+
+    int64 FileSize = PlatformFile.FileSize(*Path);
+    if (FileSize <= 0)
+    {
+        return false;
+    }
+
+    bool bParsed = false;
+
+    // Region 须先于 Handle 释放
+    TUniquePtr<IMappedFileHandle> MappedHandle(PlatformFile.OpenMapped(*Path));
+    TUniquePtr<IMappedFileRegion> MappedRegion(MappedHandle ? MappedHandle->MapRegion(0, MappedHandle->GetFileSize()) : nullptr);
+    if (MappedRegion)
+    {
+        FileSize = MappedRegion->GetMappedSize();
+        bParsed = Parse(MappedRegion->GetMappedPtr(), FileSize);
+    }
+    else
+    {
+        // 不支持内存映射的平台整体读入
+        TArray<uint8> Buffer;
+        if (!FFileHelper::LoadFileToArray(Buffer, *Path, FILEREAD_Silent))
+        {
+            return false;
+        }
+        FileSize = Buffer.Num();
+        bParsed = Parse(Buffer.GetData(), FileSize);
+    }
+
+    MappedRegion.Reset();
+    MappedHandle.Reset();
+
+    if (!bParsed)
+    {
+        // 版本过期或已损坏，删掉后由调用方重新生成覆盖
+        IFileManager::Get().Delete(*Path, false, false, true);
+
+        FScopeLock ScopeLock(&StatsLock);
+        ++Stats.RejectedCount;
+        return false;
+    }
+
+    // 以修改时间记录最近使用，清理时按它从旧到新删除；访问时间在很多文件系统上并不更新
+    IFileManager::Get().SetTimeStamp(*Path, FDateTime::UtcNow());
+
+    FScopeLock ScopeLock(&StatsLock);
+    Stats.BytesRead += FileSize;
+    return true;
+}
+
+bool FModelGenDiskCache::WriteFile(const FString& Path, const TArray<uint8>& Buffer)
+{
+    IFileManager& FileManager = IFileManager::Get();
+
+    // 写入唯一的临时文件再改名，并发写同一键或读到半个文件都不会发生
+    const FString TempPath = FPaths::GetPath(Path) / FGuid::NewGuid().ToString() + TEXT(".tmp");
+    if (!FFileHelper::SaveArrayToFile(Buffer, *TempPath))
+    {
+        UE_LOG(LogModelGen, Warning, TEXT("ModelGen disk cache: failed to write %s"), *TempPath);
+        return false;
+    }
+
+    if (!FileManager.Move(*Path, *TempPath, true, true, false, true))
+    {
+        // 目标正被其他线程映射时改名会失败，已有文件内容相同，丢弃临时文件即可
+        FileManager.Delete(*TempPath, false, false, true);
+        return false;
+    }
+
+    FScopeLock ScopeLock(&StatsLock);
+    ++Stats.WriteCount;
+    Stats.BytesWritten += Buffer.Num();
+    return true;
+}
+
+void FModelGenDiskCache::QueueWrite(FString&& Path, TArray<uint8>&& Buffer)
+{
+    FGraphEventRef WriteEvent = FFunctionGraphTask::CreateAndDispatchWhenReady(
+        [this, Path = MoveTemp(Path), Buffer = MoveTemp(Buffer)]()
+        {
+            SCOPE_CYCLE_COUNTER(STAT_ModelGen_DiskCacheWrite);
+
+            if (!WriteFile(Path, Buffer))
+            {
+                return;
+            }
+
+            bool bNeedsPrune = false;
+            {
+                FScopeLock ScopeLock(&WriteLock);
+                if (CachedBytes >= 0)
+                {
+                    CachedBytes += Buffer.Num();
+                }
+                // 本次会话第一次写入时扫描一遍目录，顺带清掉上次会话留下的过期文件
+                bNeedsPrune = CachedBytes < 0 || CachedBytes > ByteBudget;
+            }
+
+            if (bNeedsPrune)
+            {
+                Prune();
+            }
+        },
+        TStatId(), nullptr, ENamedThreads::AnyBackgroundThreadNormalTask);
+
+    FScopeLock ScopeLock(&WriteLock);
+    PendingWrites.RemoveAllSwap([](const FGraphEventRef& Event) { return Event->IsComplete(); });
+    PendingWrites.Add(MoveTemp(WriteEvent));
+}
+
+void FModelGenDiskCache::Flush()
+{
+    FGraphEventArray Writes;
+    {
+        FScopeLock ScopeLock(&WriteLock);
+        Writes = MoveTemp(PendingWrites);
+    }
+
+    if (Writes.Num() > 0)
+    {
+        FTaskGraphInterface::Get().WaitUntilTasksComplete(Writes);
+    }
+}
+
+void FModelGenDiskCache::Prune()
+{
+    // 已有线程在扫描时直接返回，它完成后 CachedBytes 即为准确值
+    if (!PruneLock.TryLock())
+    {
+        return;
+    }
+
+    struct FCacheFile
+    {
+        FString Path;
+        FDateTime LastUsed;
+        int64 Size;
+    };
+
+    TArray<FCacheFile> Files;
+    int64 TotalBytes = 0;
+
+    IFileManager& FileManager = IFileManager::Get();
+    const FDateTime Now = FDateTime::UtcNow();
+    const FDateTime ExpireTime = Now - FTimespan::FromDays(MaxFileAgeDays);
+    const FDateTime StaleTempTime = Now - FTimespan::FromHours(StaleTempFileHours);
+    int32 NumPruned = 0;
+
+    FileManager.IterateDirectoryStatRecursively(*CacheDir, [&](const TCHAR* FilenameOrDirectory, const FFileStatData& StatData)
+    {
+        if (StatData.bIsDirectory)
+        {
+            return true;
+        }
+
+        const FString Path = FilenameOrDirectory;
+        const bool bTempFile = Path.EndsWith(TEXT(".tmp"));
+        if ((bTempFile && StatData.ModificationTime < StaleTempTime) || (!bTempFile && StatData.ModificationTime < ExpireTime))
+        {
+            if (FileManager.Delete(*Path, false, false, true))
+            {
+                ++NumPruned;
+                return true;
+            }
+        }
+
+        TotalBytes += StatData.FileSize;
+        if (!bTempFile)
+        {
+            Files.Add({ Path, StatData.ModificationTime, StatData.FileSize });
+        }
+        return true;
+    });
+
+    const int64 Budget = ByteBudget;
+    if (TotalBytes > Budget)
+    {
+        Files.Sort([](const FCacheFile& A, const FCacheFile& B) { return A.LastUsed < B.LastUsed; });
+
+        const int64 TargetBytes = static_cast<int64>(Budget * PruneTargetRatio);
+        for (const FCacheFile& File : Files)
+        {
+            if (TotalBytes <= TargetBytes)
+            {
+                break;
+            }
+
+            // 正被映射读取的文件在部分平台上删除会失败，留到下次清理
+            if (FileManager.Delete(*File.Path, false, false, true))
+            {
+                TotalBytes -= File.Size;
+                ++NumPruned;
+            }
+        }
+    }
+
+    {
+        FScopeLock ScopeLock(&WriteLock);
+        CachedBytes = TotalBytes;
+    }
+
+    if (NumPruned > 0)
+    {
+        UE_LOG(LogModelGen, Verbose, TEXT("ModelGen disk cache: pruned %d files, %lld bytes remain"), NumPruned, TotalBytes);
+
+        FScopeLock ScopeLock(&StatsLock);
+        Stats.PrunedCount += NumPruned;
+    }
+
+    PruneLock.Unlock();
+}
+
+void FModelGenDiskCache::Clear()
+{
+    Flush();
+
+    FScopeLock PruneScopeLock(&PruneLock);
+    IFileManager::Get().DeleteDirectory(*CacheDir, false, true);
+
+    {
+        FScopeLock ScopeLock(&WriteLock);
+        CachedBytes = 0;
+    }
+
+    FScopeLock ScopeLock(&StatsLock);
+    Stats = FModelGenDiskCacheStats();
+}
+
+FModelGenDiskCacheStats FModelGenDiskCache::GetStats() const
+{
+    FScopeLock ScopeLock(&StatsLock);
+    return Stats;
+}
@@ -0,0 +1,327 @@
+// Copyright (c) 2024. All rights reserved.
+
+#include "ModelGenInstancingSubsystem.h"
+#include "Components/HierarchicalInstancedStaticMeshComponent.h"
+#include "Engine/World.h"
+#include "EngineUtils.h"
+#include "ProceduralMeshActor.h"
+#include "ModelGenMeshBuilder.h"
+#include "ModelStrategyFactory.h"
+#include "ModelGenStaticMeshConverter.h"
+
+UModelGenInstancingSubsystem* UModelGenInstancingSubsystem::Get(const UWorld* World)
+{
+    return World ? World->GetSubsystem<UModelGenInstancingSubsystem>() : nullptr;
+}
+
+void UModelGenInstancingSubsystem::Deinitialize()
+{
+    Groups.Empty();
+    GroupIndices.Empty();
+    ActorGroups.Empty();
+    HolderActor = nullptr;
+
+    Super::Deinitialize();
+}
+
+void UModelGenInstancingSubsystem::SetAutoInstancingEnabled(bool bEnabled)
+{
+    bAutoInstancing = bEnabled;
+    if (bAutoInstancing)
+    {
+        InstanceAllShapes();
+    }
+}
+
+int32 UModelGenInstancingSubsystem::InstanceAllShapes()
+{
+    UWorld* World = GetWorld();
+    if (!World)
+    {
+        return 0;
+    }
+
+    int32 NumAdded = 0;
+    for (TActorIterator<AProceduralMeshActor> It(World); It; ++It)
+    {
+        AProceduralMeshActor* Actor = *It;
+        if (!ActorGroups.Contains(Actor) && AddActor(Actor))
+        {
+            ++NumAdded;
+        }
+    }
+
+    return NumAdded;
+}
+
+bool UModelGenInstancingSubsystem::AddActor(AProceduralMeshActor* Actor)
+{
+    if (!Actor || !Actor->bAllowInstancing || Actor->IsPendingKill() || Actor->GetWorld() != GetWorld())
+    {
+        return false;
+    }
+
+    if (ActorGroups.Contains(Actor))
+    {
+        RefreshActor(Actor);
+        return true;
+    }
+
+    const FModelGenParamsHash ParamsHash = Actor->GetShapeParamsHash();
+    if (!ParamsHash.IsValid())
+    {
+        return false;
+    }
+
+    const FModelGenParamsHash Key = MakeGroupKey(ParamsHash, Actor);
+    const int32 GroupIndex = FindOrCreateGroup(Key, Actor);
+    if (GroupIndex == INDEX_NONE)
+    {
+        return false;
+    }
+
+    FModelGenInstanceGroup& Group = Groups[GroupIndex];
+    Group.Actors.Add(Actor);
+    Group.Component->AddInstance(Actor->GetActorTransform());
+    ActorGroups.Add(Actor, Key);
+
+    Actor->SetInstanced(true);
+    return true;
+}
+
+void UModelGenInstancingSubsystem::RemoveActor(AProceduralMeshActor* Actor, bool bRestoreMesh)
+{
+    FModelGenParamsHash Key;
+    if (!Actor || !ActorGroups.RemoveAndCopyValue(Actor, Key))
+    {
+        return;
+    }
+
+    if (const int32* GroupIndex = GroupIndices.Find(Key))
+    {
+        Groups[*GroupIndex].Actors.Remove(Actor);
+        RebuildGroupInstances(*GroupIndex);
+    }
+
+    // 不恢复网格时也要清掉实例化状态，否则之后的生成调用仍被转交给已不存在的实例组
+    Actor->SetInstanced(false, bRestoreMesh);
+}
+
+void UModelGenInstancingSubsystem::RemoveAllActors(bool bRestoreMesh)
+{
+    TArray<TWeakObjectPtr<AProceduralMeshActor>> Actors;
+    ActorGroups.GetKeys(Actors);
+
+    for (int32 GroupIndex = Groups.Num() - 1; GroupIndex >= 0; --GroupIndex)
+    {
+        RemoveGroup(GroupIndex);
+    }
+    ActorGroups.Empty();
+
+    for (const TWeakObjectPtr<AProceduralMeshActor>& Actor : Actors)
+    {
+        if (Actor.IsValid())
+        {
+            Actor->SetInstanced(false, bRestoreMesh);
+        }
+    }
+}
+
+void UModelGenInstancingSubsystem::RefreshActor(AProceduralMeshActor* Actor)
+{
+    const FModelGenParamsHash* OldKey = Actor ? ActorGroups.Find(Actor) : nullptr;
+    if (!OldKey)
+    {
+        return;
+    }
+
+    const FModelGenParamsHash ParamsHash = Actor->GetShapeParamsHash();
+    if (ParamsHash.IsValid() && Actor->bAllowInstancing)
+    {
+        const FModelGenParamsHash NewKey = MakeGroupKey(ParamsHash, Actor);
+        if (NewKey == *OldKey)
+        {
+            // 只有变换变化，拖动或运行时逐帧移动时不必重建整组实例
+            const int32 GroupIndex = GroupIndices.FindChecked(NewKey);
+            FModelGenInstanceGroup& Group = Groups[GroupIndex];
+            const int32 InstanceIndex = Group.Actors.IndexOfByKey(Actor);
+            if (InstanceIndex == INDEX_NONE || !Group.Component->UpdateInstanceTransform(InstanceIndex, Actor->GetActorTransform(), false, true))
+            {
+                RebuildGroupInstances(GroupIndex);
+            }
+            return;
+        }
+    }
+
+    // 参数变化后换组；无法再实例化时恢复自身网格
+    RemoveActor(Actor, false);
+    if (!AddActor(Actor))
+    {
+        Actor->SetInstanced(false, true);
+    }
+}
+
+FModelGenParamsHash UModelGenInstancingSubsystem::MakeGroupKey(const FModelGenParamsHash& ParamsHash, const AProceduralMeshActor* Actor)
+{
+    // 组内共享的 StaticMesh 由这些设置决定，与 UCustomModelFactory 的缓存键取同样的字段
+    FModelGenStaticMeshSettings Settings;
+    Actor->GetSharedStaticMeshSettings(Settings);
+
+    struct FKeyData
+    {
+        uint64 Low;
+        uint64 High;
+        UPTRINT Material;
+        UPTRINT PhysMaterial;
+        int32 LODCount;
+        int32 bCollision;
+    };
+
+    const FKeyData Data = {
+        ParamsHash.Low,
+        ParamsHash.High,
+        reinterpret_cast<UPTRINT>(Settings.SectionMaterials.Num() > 0 ? Settings.SectionMaterials[0] : nullptr),
+        reinterpret_cast<UPTRINT>(Settings.PhysMaterial),
+        Actor->StaticMeshLODCount,
+        Actor->bGenerateCollision ? 1 : 0 };
+    return FModelGenParamsHash::ComputeBytes(&Data, sizeof(Data));
+}
+
+int32 UModelGenInstancingSubsystem::FindOrCreateGroup(const FModelGenParamsHash& Key, AProceduralMeshActor* Actor)
+{
+    if (const int32* ExistingIndex = GroupIndices.Find(Key))
+    {
+        return *ExistingIndex;
+    }
+
+    // 共享网格与 UCustomModelFactory 使用同一个 StaticMesh 缓存，材质、物理材质与 LOD 数取自该 Actor，与 GetOrCreateStaticMesh 得到同一个网格
+    TUniquePtr<FModelGenMeshBuilder> Builder = Actor->CreateMeshBuilder();
+    if (!Builder)
+    {
+        return INDEX_NONE;
+    }
+
+    FModelGenStaticMeshSettings Settings;
+    Actor->GetSharedStaticMeshSettings(Settings);
+
+    UStaticMesh* Mesh = UCustomModelFactory::FindOrCreateStaticMesh(Actor->GetShapeParamsHash(), *Builder, Settings, Actor->StaticMeshLODCount);
+    if (!Mesh)
+    {
+        return INDEX_NONE;
+    }
+
+    UMaterialInterface* Material = Settings.SectionMaterials.Num() > 0 ? Settings.SectionMaterials[0] : nullptr;
+    UHierarchicalInstancedStaticMeshComponent* Component = CreateGroupComponent(Mesh, Material, Actor->bGenerateCollision);
+    if (!Component)
+    {
+        return INDEX_NONE;
+    }
+
+    const int32 GroupIndex = Groups.AddDefaulted();
+    Groups[GroupIndex].Component = Component;
+    Groups[GroupIndex].Key = Key;
+    GroupIndices.Add(Key, GroupIndex);
+    return GroupIndex;
+}
+
+UHierarchicalInstancedStaticMeshComponent* UModelGenInstancingSubsystem::CreateGroupComponent(UStaticMesh* Mesh, UMaterialInterface* Material, bool bCollision)
+{
+    AActor* Holder = GetOrCreateHolderActor();
+    if (!Holder)
+    {
+        return nullptr;
+    }
+
+    UHierarchicalInstancedStaticMeshComponent* Component =
+        NewObject<UHierarchicalInstancedStaticMeshComponent>(Holder, NAME_None, RF_Transient);
+    Component->SetMobility(EComponentMobility::Movable);
+    Component->SetupAttachment(Holder->GetRootComponent());
+    Component->SetStaticMesh(Mesh);
+    Component->SetMaterial(0, Material);
+    Component->SetCollisionEnabled(bCollision ? ECollisionEnabled::QueryAndPhysics : ECollisionEnabled::NoCollision);
+    Component->SetCollisionObjectType(ECollisionChannel::ECC_WorldStatic);
+    Component->RegisterComponent();
+    return Component;
+}
+
+void UModelGenInstancingSubsystem::RebuildGroupInstances(int32 GroupIndex)
+{
+    FModelGenInstanceGroup& Group = Groups[GroupIndex];
+
+    TArray<FTransform> Transforms;
+    Transforms.Reserve(Group.Actors.Num());
+    for (int32 ActorIndex = Group.Actors.Num() - 1; ActorIndex >= 0; --ActorIndex)
+    {
+        const TWeakObjectPtr<AProceduralMeshActor>& Actor = Group.Actors[ActorIndex];
+        if (!Actor.IsValid())
+        {
+            ActorGroups.Remove(Actor);
+            Group.Actors.RemoveAt(ActorIndex, 1, false);
+        }
+    }
+
+    if (Group.Actors.Num() == 0)
+    {
+        RemoveGroup(GroupIndex);
+        return;
+    }
+
+    for (const TWeakObjectPtr<AProceduralMeshActor>& Actor : Group.Actors)
+    {
+        Transforms.Add(Actor->GetActorTransform());
+    }
+
+    Group.Component->ClearInstances();
+    Group.Component->AddInstances(Transforms, false);
+}
+
+void UModelGenInstancingSubsystem::RemoveGroup(int32 GroupIndex)
+{
+    FModelGenInstanceGroup& Group = Groups[GroupIndex];
+    if (Group.Component)
+    {
+        Group.Component->DestroyComponent();
+    }
+
+    GroupIndices.Remove(Group.Key);
+    Groups.RemoveAtSwap(GroupIndex, 1, false);
+
+    // 末尾的组被换到了当前位置
+    if (Groups.IsValidIndex(GroupIndex))
+    {
+        GroupIndices.Add(Groups[GroupIndex].Key, GroupIndex);
+    }
+}
+
+AActor* UModelGenInstancingSubsystem::GetOrCreateHolderActor()
+{
+    if (HolderActor && !HolderActor->IsPendingKill())
+    {
+        return HolderActor;
+    }
+
+    UWorld* World = GetWorld();
+    if (!World)
+    {
+        return nullptr;
+    }
+
+    FActorSpawnParameters SpawnParams;
+    SpawnParams.ObjectFlags |= RF_Transient;
+    HolderActor = World->SpawnActor<AActor>(AActor::StaticClass(), FTransform::Identity, SpawnParams);
+    if (!HolderActor)
+    {
+        return nullptr;
+    }
+
+    USceneComponent* Root = NewObject<USceneComponent>(HolderActor, TEXT("Root"), RF_Transient);
+    Root->SetMobility(EComponentMobility::Static);
+    HolderActor->SetRootComponent(Root);
+    Root->RegisterComponent();
+
+#if WITH_EDITOR
+    HolderActor->SetActorLabel(TEXT("ModelGenInstances"));
+#endif
+
+    return HolderActor;
+}
@@ -1,28 +1,117 @@
 #include "ModelGenMeshBuilder.h"
+#include "Hash/CityHash.h"
+#include "PhysicsEngine/AggregateGeom.h"
+
+namespace
+{
+    FORCEINLINE int64 QuantizeWeldComponent(float Value, float InvTolerance)
+    {
+        return static_cast<int64>(FMath::FloorToDouble(static_cast<double>(Value) * InvTolerance + 0.5));
+    }
+}
+
+FModelGenVertexKey::FModelGenVertexKey(const FVector& Pos, const FVector& Normal, const FVector2D& UV, float InvTolerance)
+{
+    Components[0] = QuantizeWeldComponent(Pos.X, InvTolerance);
+    Components[1] = QuantizeWeldComponent(Pos.Y, InvTolerance);
+    Components[2] = QuantizeWeldComponent(Pos.Z, InvTolerance);
+    Components[3] = QuantizeWeldComponent(Normal.X, InvTolerance);
+    Components[4] = QuantizeWeldComponent(Normal.Y, InvTolerance);
+    Components[5] = QuantizeWeldComponent(Normal.Z, InvTolerance);
+    Components[6] = QuantizeWeldComponent(UV.X, InvTolerance);
+    Components[7] = QuantizeWeldComponent(UV.Y, InvTolerance);
+
+    Hash = CityHash32(reinterpret_cast<const char*>(Components), sizeof(Components));
+}
+
+void FModelGenTopologyRecord::Reset()
+{
+    VertexRefs.Reset();
+    TriangleCalls.Reset();
+    Triangles.Reset();
+    NumVertices = 0;
+}
 
 FModelGenMeshBuilder::FModelGenMeshBuilder()
 {
     Clear();
 }
 
+bool FModelGenMeshBuilder::Regenerate(const FModelGenTopologyRecord& Record, FModelGenMeshData& OutMeshData)
+{
+    if (!Record.IsValid())
+    {
+        return false;
+    }
+
+    TGuardValue<FModelGenTopologyRecord*> RecordGuard(TopologyRecord, nullptr);
+    TGuardValue<const FModelGenTopologyRecord*> ReplayGuard(ReplayRecord, &Record);
+    return Generate(OutMeshData);
+}
+
+int32 FModelGenMeshBuilder::ReplayVertex(const FVector& Pos, const FVector& Normal, const FVector2D& UV, const FProcMeshTangent& Tangent, bool bWelded)
+{
+    if (bReplayMismatch || ReplayVertexCursor >= ReplayRecord->VertexRefs.Num())
+    {
+        bReplayMismatch = true;
+        return 0;
+    }
+
+    const int32 Index = ReplayRecord->VertexRefs[ReplayVertexCursor++];
+    if (Index == ReplayWrittenVertices)
+    {
+        MeshData.Vertices[Index] = Pos;
+        MeshData.Normals[Index] = Normal;
+        MeshData.UVs[Index] = UV;
+        MeshData.Tangents[Index] = Tangent;
+        ++ReplayWrittenVertices;
+        return Index;
+    }
+
+    // 记录中焊接到了已有顶点：新参数下两者须仍落在同一焊接格内
+    const float InvTolerance = 1.0f / WeldTolerance;
+    if (!bWelded || Index > ReplayWrittenVertices ||
+        !(FModelGenVertexKey(Pos, Normal, UV, InvTolerance) == FModelGenVertexKey(MeshData.Vertices[Index], MeshData.Normals[Index], MeshData.UVs[Index], InvTolerance)))
+    {
+        bReplayMismatch = true;
+    }
+    return Index;
+}
+
 int32 FModelGenMeshBuilder::GetOrAddVertex(const FVector& Pos, const FVector& Normal, const FVector2D& UV)
 {
-    FString VertexKey = FString::Printf(TEXT("%.6f,%.6f,%.6f|%.6f,%.6f,%.6f|%.6f,%.6f"),
-        Pos.X, Pos.Y, Pos.Z,
-        Normal.X, Normal.Y, Normal.Z,
-        UV.X, UV.Y);
+    return GetOrAddVertex(Pos, Normal, UV, FProcMeshTangent(FVector::ZeroVector, false));
+}
+
+int32 FModelGenMeshBuilder::GetOrAddVertex(const FVector& Pos, const FVector& Normal, const FVector2D& UV, const FProcMeshTangent& Tangent)
+{
+    if (ReplayRecord)
+    {
+        return ReplayVertex(Pos, Normal, UV, Tangent, true);
+    }
+
+    const FModelGenVertexKey VertexKey(Pos, Normal, UV, 1.0f / WeldTolerance);
 
     if (int32* FoundIndex = UniqueVerticesMap.Find(VertexKey))
     {
+        if (TopologyRecord)
+        {
+            TopologyRecord->VertexRefs.Add(*FoundIndex);
+        }
         return *FoundIndex;
     }
 
-    const int32 NewIndex = AddVertex(Pos, Normal, UV);
+    const int32 NewIndex = AddVertex(Pos, Normal, UV, Tangent);
     UniqueVerticesMap.Add(VertexKey, NewIndex);
 
     return NewIndex;
 }
 
+void FModelGenMeshBuilder::SetWeldTolerance(float InTolerance)
+{
+    WeldTolerance = FMath::Max(InTolerance, SMALL_NUMBER);
+}
+
 FVector FModelGenMeshBuilder::GetPosByIndex(int32 Index) const
 {
     if (Index >= 0 && Index < MeshData.Vertices.Num())
@@ -35,17 +124,53 @@ FVector FModelGenMeshBuilder::GetPosByIndex(int32 Index) const
 
 int32 FModelGenMeshBuilder::AddVertex(const FVector& Pos, const FVector& Normal, const FVector2D& UV)
 {
-    return MeshData.AddVertex(Pos, Normal, UV);
+    return AddVertex(Pos, Normal, UV, FProcMeshTangent(FVector::ZeroVector, false));
+}
+
+int32 FModelGenMeshBuilder::AddVertex(const FVector& Pos, const FVector& Normal, const FVector2D& UV, const FProcMeshTangent& Tangent)
+{
+    if (ReplayRecord)
+    {
+        return ReplayVertex(Pos, Normal, UV, Tangent, false);
+    }
+
+    const int32 Index = MeshData.AddVertex(Pos, Normal, UV, Tangent);
+    if (TopologyRecord)
+    {
+        TopologyRecord->VertexRefs.Add(Index);
+    }
+    return Index;
 }
 
 void FModelGenMeshBuilder::AddTriangle(int32 V0, int32 V1, int32 V2)
 {
+    if (ReplayRecord)
+    {
+        // 索引缓冲已取自记录，这里只核对调用序列
+        const TArray<int32>& Calls = ReplayRecord->TriangleCalls;
+        if (bReplayMismatch || ReplayTriangleCursor + 3 > Calls.Num() ||
+            Calls[ReplayTriangleCursor] != V0 || Calls[ReplayTriangleCursor + 1] != V1 || Calls[ReplayTriangleCursor + 2] != V2)
+        {
+            bReplayMismatch = true;
+            return;
+        }
+        ReplayTriangleCursor += 3;
+        return;
+    }
+
+    if (TopologyRecord)
+    {
+        TopologyRecord->TriangleCalls.Add(V0);
+        TopologyRecord->TriangleCalls.Add(V1);
+        TopologyRecord->TriangleCalls.Add(V2);
+    }
     MeshData.AddTriangle(V0, V1, V2);
 }
 
 void FModelGenMeshBuilder::AddQuad(int32 V0, int32 V1, int32 V2, int32 V3)
 {
-    MeshData.AddQuad(V0, V1, V2, V3);
+    AddTriangle(V0, V1, V2);
+    AddTriangle(V0, V2, V3);
 }
 
 FVector FModelGenMeshBuilder::CalculateTangent(const FVector& Normal) const
@@ -53,15 +178,71 @@ FVector FModelGenMeshBuilder::CalculateTangent(const FVector& Normal) const
     return MeshData.CalculateTangent(Normal);
 }
 
+FProcMeshTangent FModelGenMeshBuilder::MakeTangent(const FVector& Normal, const FVector& DPosDU, const FVector& DPosDV) const
+{
+    FVector TangentX = DPosDU - Normal * (Normal | DPosDU);
+    if (!TangentX.Normalize())
+    {
+        return FProcMeshTangent(CalculateTangent(Normal), false);
+    }
+
+    return FProcMeshTangent(TangentX, ((Normal ^ TangentX) | DPosDV) < 0.0f);
+}
+
 void FModelGenMeshBuilder::Clear()
 {
     MeshData.Clear();
     UniqueVerticesMap.Empty();
+
+    if (TopologyRecord)
+    {
+        TopologyRecord->Reset();
+    }
+
+    if (ReplayRecord)
+    {
+        const int32 NumVertices = ReplayRecord->NumVertices;
+        MeshData.Vertices.SetNumUninitialized(NumVertices);
+        MeshData.Normals.SetNumUninitialized(NumVertices);
+        MeshData.UVs.SetNumUninitialized(NumVertices);
+        MeshData.Tangents.SetNumUninitialized(NumVertices);
+        MeshData.VertexColors.Init(FLinearColor::White, NumVertices);
+        MeshData.Triangles = ReplayRecord->Triangles;
+        MeshData.VertexCount = NumVertices;
+        MeshData.TriangleCount = MeshData.Triangles.Num() / 3;
+
+        ReplayVertexCursor = 0;
+        ReplayTriangleCursor = 0;
+        ReplayWrittenVertices = 0;
+        bReplayMismatch = false;
+    }
 }
 
-bool FModelGenMeshBuilder::ValidateGeneratedData() const
+bool FModelGenMeshBuilder::ValidateGeneratedData()
 {
-    return MeshData.IsValid();
+    if (ReplayRecord)
+    {
+        if (bReplayMismatch ||
+            ReplayVertexCursor != ReplayRecord->VertexRefs.Num() ||
+            ReplayTriangleCursor != ReplayRecord->TriangleCalls.Num() ||
+            ReplayWrittenVertices != ReplayRecord->NumVertices)
+        {
+            return false;
+        }
+        return MeshData.IsValid();
+    }
+
+    if (!MeshData.IsValid())
+    {
+        return false;
+    }
+
+    if (TopologyRecord)
+    {
+        TopologyRecord->Triangles = MeshData.Triangles;
+        TopologyRecord->NumVertices = MeshData.Vertices.Num();
+    }
+    return true;
 }
 
 void FModelGenMeshBuilder::ReserveMemory()
@@ -70,4 +251,107 @@ void FModelGenMeshBuilder::ReserveMemory()
     const int32 EstimatedTriangleCount = CalculateTriangleCountEstimate();
 
     MeshData.Reserve(EstimatedVertexCount, EstimatedTriangleCount);
-}
\ No newline at end of file
+
+    // 重放不查焊接表
+    if (!ReplayRecord)
+    {
+        UniqueVerticesMap.Reserve(EstimatedVertexCount);
+    }
+}
+
+void FModelGenMeshBuilder::AppendPolygonArcPoints(float Radius, int32 Sides, float StartAngle, float ArcAngle,
+    float FromAngle, float ToAngle, float Z, TArray<FVector>& OutPoints)
+{
+    if (Sides <= 0 || ArcAngle <= KINDA_SMALL_NUMBER)
+    {
+        return;
+    }
+
+    const float Step = ArcAngle / Sides;
+    const float Apothem = Radius * FMath::Cos(Step * 0.5f);
+
+    // 射线落在第 Edge 条边上，交点到中心的距离为边心距除以与该边中线夹角的余弦
+    auto PointAtAngle = [&](float Angle)
+    {
+        const int32 Edge = FMath::Clamp(FMath::FloorToInt((Angle - StartAngle) / Step), 0, Sides - 1);
+        const float MidAngle = StartAngle + (Edge + 0.5f) * Step;
+        const float Distance = Apothem / FMath::Max(FMath::Cos(Angle - MidAngle), KINDA_SMALL_NUMBER);
+        return FVector(Distance * FMath::Cos(Angle), Distance * FMath::Sin(Angle), Z);
+    };
+
+    OutPoints.Add(PointAtAngle(FromAngle));
+
+    const int32 FirstVertex = FMath::Max(FMath::FloorToInt((FromAngle - StartAngle) / Step), 0);
+    for (int32 i = FirstVertex; i <= Sides; ++i)
+    {
+        const float Angle = StartAngle + i * Step;
+        if (Angle <= FromAngle + KINDA_SMALL_NUMBER)
+        {
+            continue;
+        }
+        if (Angle >= ToAngle - KINDA_SMALL_NUMBER)
+        {
+            break;
+        }
+        OutPoints.Add(FVector(Radius * FMath::Cos(Angle), Radius * FMath::Sin(Angle), Z));
+    }
+
+    OutPoints.Add(PointAtAngle(ToAngle));
+}
+
+void FModelGenMeshBuilder::AddConvexElem(FKAggregateGeom& OutGeom, TArray<FVector>&& Points)
+{
+    if (Points.Num() < 4)
+    {
+        return;
+    }
+
+    FKConvexElem& ConvexElem = OutGeom.ConvexElems.AddDefaulted_GetRef();
+    ConvexElem.VertexData = MoveTemp(Points);
+    ConvexElem.UpdateElemBox();
+}
+
+void FModelGenMeshBuilder::GenerateLODs(int32 BaseTriangleCount, int32 MaxLODs, TArray<FModelGenMeshData>& OutLODs) const
+{
+    OutLODs.Reset();
+
+    int32 PreviousTriangles = BaseTriangleCount;
+    float TessellationScale = 1.0f;
+
+    for (int32 LODIndex = 1; LODIndex < MaxLODs; ++LODIndex)
+    {
+        TessellationScale *= 0.5f;
+
+        TUniquePtr<FModelGenMeshBuilder> ReducedBuilder = CreateReducedBuilder(TessellationScale);
+        if (!ReducedBuilder)
+        {
+            break;
+        }
+
+        FModelGenMeshData LODData;
+        if (!ReducedBuilder->Generate(LODData) || !LODData.IsValid())
+        {
+            break;
+        }
+
+        // 三角形减少不到四分之一的一级 LOD 只增加切换而没有收益，各分段数此时也已接近下限
+        const int32 NumTriangles = LODData.Triangles.Num() / 3;
+        if (NumTriangles * 4 > PreviousTriangles * 3)
+        {
+            break;
+        }
+
+        PreviousTriangles = NumTriangles;
+        OutLODs.Add(MoveTemp(LODData));
+    }
+}
+
+int32 FModelGenMeshBuilder::ScaleSegmentCount(int32 Count, float Scale, int32 MinCount)
+{
+    if (Count <= MinCount)
+    {
+        return Count;
+    }
+
+    return FMath::Clamp(FMath::RoundToInt(Count * Scale), MinCount, Count);
+}
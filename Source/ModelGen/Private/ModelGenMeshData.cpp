@@ -1,6 +1,59 @@
 #include "ModelGenMeshData.h"
 #include "ProceduralMeshComponent.h"
 #include "KismetProceduralMeshLibrary.h"
+#include "HAL/IConsoleManager.h"
+#include "ModelGen.h"
+#include "ModelGenStats.h"
+
+#if !UE_BUILD_SHIPPING
+namespace ModelGenTangents
+{
+    static TAutoConsoleVariable<int32> CVarValidateTangents(
+        TEXT("ModelGen.ValidateTangents"),
+        0,
+        TEXT("非 0 时，每次 CalculateTangents 后与 UKismetProceduralMeshLibrary::CalculateTangentsForMesh 的结果比对并输出偏差"),
+        ECVF_Default);
+
+    // Kismet 会合并位置重合的顶点再平滑，UV 接缝和硬边处出现偏差属正常
+    static void CompareWithKismet(const FModelGenMeshData& MeshData)
+    {
+        TArray<FVector> KismetNormals;
+        TArray<FProcMeshTangent> KismetTangents;
+        UKismetProceduralMeshLibrary::CalculateTangentsForMesh(
+            MeshData.Vertices, MeshData.Triangles, MeshData.UVs, KismetNormals, KismetTangents);
+
+        if (KismetTangents.Num() != MeshData.Tangents.Num())
+        {
+            UE_LOG(LogModelGen, Warning, TEXT("Tangent check: vertex count mismatch (%d vs Kismet %d)"),
+                MeshData.Tangents.Num(), KismetTangents.Num());
+            return;
+        }
+
+        float MinDot = 1.0f;
+        int32 WorstVertex = INDEX_NONE;
+        int32 FlipMismatches = 0;
+
+        for (int32 i = 0; i < KismetTangents.Num(); ++i)
+        {
+            const float Dot = MeshData.Tangents[i].TangentX | KismetTangents[i].TangentX;
+            if (Dot < MinDot)
+            {
+                MinDot = Dot;
+                WorstVertex = i;
+            }
+
+            if (MeshData.Tangents[i].bFlipTangentY != KismetTangents[i].bFlipTangentY)
+            {
+                ++FlipMismatches;
+            }
+        }
+
+        const float MaxAngleDeg = FMath::RadiansToDegrees(FMath::Acos(FMath::Clamp(MinDot, -1.0f, 1.0f)));
+        UE_LOG(LogModelGen, Log, TEXT("Tangent check: %d vertices, max TangentX deviation %.2f deg (vertex %d), %d bFlipTangentY mismatches"),
+            KismetTangents.Num(), MaxAngleDeg, WorstVertex, FlipMismatches);
+    }
+}
+#endif
 
 void FModelGenMeshData::Clear()
 {
@@ -27,6 +80,16 @@ void FModelGenMeshData::Reserve(int32 InVertexCount, int32 InTriangleCount)
     Triangles.Reserve(InTriangleCount * 3);
 }
 
+SIZE_T FModelGenMeshData::GetAllocatedSize() const
+{
+    return Vertices.GetAllocatedSize() +
+        Triangles.GetAllocatedSize() +
+        Normals.GetAllocatedSize() +
+        UVs.GetAllocatedSize() +
+        VertexColors.GetAllocatedSize() +
+        Tangents.GetAllocatedSize();
+}
+
 bool FModelGenMeshData::IsValid() const
 {
     const bool bHasBasicGeometry = Vertices.Num() > 0 && Triangles.Num() > 0;
@@ -52,6 +115,12 @@ bool FModelGenMeshData::IsValid() const
 
 int32 FModelGenMeshData::AddVertex(const FVector& Position, const FVector& Normal,
     const FVector2D& UV, const FLinearColor& Color)
+{
+    return AddVertex(Position, Normal, UV, FProcMeshTangent(FVector::ZeroVector, false), Color);
+}
+
+int32 FModelGenMeshData::AddVertex(const FVector& Position, const FVector& Normal,
+    const FVector2D& UV, const FProcMeshTangent& Tangent, const FLinearColor& Color)
 {
     const int32 Index = Vertices.Num();
 
@@ -59,7 +128,7 @@ int32 FModelGenMeshData::AddVertex(const FVector& Position, const FVector& Norma
     Normals.Add(Normal);
     UVs.Add(UV);
     VertexColors.Add(Color);
-    Tangents.Add(FProcMeshTangent(FVector::ZeroVector, false));
+    Tangents.Add(Tangent);
 
     VertexCount = Vertices.Num();
     return Index;
@@ -130,35 +199,248 @@ void FModelGenMeshData::ToProceduralMesh(UProceduralMeshComponent* MeshComponent
         return;
     }
 
+    MODELGEN_STAGE_SCOPE(ToProceduralMesh);
+    SET_MEMORY_STAT(STAT_ModelGen_UploadedMeshMemory, GetAllocatedSize());
+
     bool bCreateCollision = MeshComponent->GetCollisionEnabled() != ECollisionEnabled::NoCollision;
+
+    // 拓扑未变（仅半径、高度、弯曲等连续参数变化）时只更新顶点数据，复用已有缓冲与碰撞网格
+    if (HasSameTopology(MeshComponent->GetProcMeshSection(SectionIndex), bCreateCollision))
+    {
+        MeshComponent->UpdateMeshSection_LinearColor(SectionIndex, Vertices, Normals, UVs, VertexColors, Tangents);
+        return;
+    }
+
     MeshComponent->CreateMeshSection_LinearColor(SectionIndex, Vertices, Triangles, Normals, UVs, VertexColors, Tangents, bCreateCollision);
 }
 
+bool FModelGenMeshData::UpdateProceduralMeshVertices(UProceduralMeshComponent* MeshComponent, int32 SectionIndex) const
+{
+    if (!MeshComponent)
+    {
+        return false;
+    }
+
+    const FProcMeshSection* Section = MeshComponent->GetProcMeshSection(SectionIndex);
+    const bool bCreateCollision = MeshComponent->GetCollisionEnabled() != ECollisionEnabled::NoCollision;
+    if (!Section || Section->bEnableCollision != bCreateCollision ||
+        Section->ProcVertexBuffer.Num() != Vertices.Num() || Section->ProcIndexBuffer.Num() != Triangles.Num())
+    {
+        return false;
+    }
+
+    MODELGEN_STAGE_SCOPE(ToProceduralMesh);
+    SET_MEMORY_STAT(STAT_ModelGen_UploadedMeshMemory, GetAllocatedSize());
+
+    MeshComponent->UpdateMeshSection_LinearColor(SectionIndex, Vertices, Normals, UVs, VertexColors, Tangents);
+    return true;
+}
+
+bool FModelGenMeshData::HasSameTopology(const FProcMeshSection* Section, bool bCreateCollision) const
+{
+    if (!Section || Section->bEnableCollision != bCreateCollision)
+    {
+        return false;
+    }
+
+    if (Section->ProcVertexBuffer.Num() != Vertices.Num() || Section->ProcIndexBuffer.Num() != Triangles.Num())
+    {
+        return false;
+    }
+
+    static_assert(sizeof(uint32) == sizeof(int32), "Index buffer element size mismatch");
+    return FMemory::Memcmp(Section->ProcIndexBuffer.GetData(), Triangles.GetData(), Triangles.Num() * sizeof(int32)) == 0;
+}
+
+void FModelGenMeshData::SplitByTriangleBudget(int32 MaxTriangles, TArray<FModelGenMeshData>& OutChunks) const
+{
+    OutChunks.Reset();
+
+    const int32 NumTriangles = Triangles.Num() / 3;
+    if (NumTriangles == 0)
+    {
+        return;
+    }
+
+    if (MaxTriangles <= 0 || NumTriangles <= MaxTriangles)
+    {
+        OutChunks.Add(*this);
+        return;
+    }
+
+    TArray<FVector> Centroids;
+    TArray<int32> Order;
+    Centroids.SetNumUninitialized(NumTriangles);
+    Order.SetNumUninitialized(NumTriangles);
+
+    for (int32 TriIdx = 0; TriIdx < NumTriangles; ++TriIdx)
+    {
+        Centroids[TriIdx] = (Vertices[Triangles[TriIdx * 3]] + Vertices[Triangles[TriIdx * 3 + 1]] + Vertices[Triangles[TriIdx * 3 + 2]]) / 3.0f;
+        Order[TriIdx] = TriIdx;
+    }
+
+    const bool bHasNormals = Normals.Num() == Vertices.Num();
+    const bool bHasUVs = UVs.Num() == Vertices.Num();
+    const bool bHasColors = VertexColors.Num() == Vertices.Num();
+    const bool bHasTangents = Tangents.Num() == Vertices.Num();
+
+    TArray<int32> Remap;
+    Remap.Init(INDEX_NONE, Vertices.Num());
+
+    // 区间以 [Begin, End) 表示；先处理左半再处理右半，分块顺序与空间位置一致
+    TArray<TPair<int32, int32>, TInlineAllocator<64>> Ranges;
+    Ranges.Emplace(0, NumTriangles);
+
+    while (Ranges.Num() > 0)
+    {
+        const TPair<int32, int32> Range = Ranges.Pop(false);
+        const int32 Begin = Range.Key;
+        const int32 Count = Range.Value - Begin;
+
+        if (Count > MaxTriangles)
+        {
+            FBox Bounds(ForceInit);
+            for (int32 i = Begin; i < Range.Value; ++i)
+            {
+                Bounds += Centroids[Order[i]];
+            }
+
+            const FVector Size = Bounds.GetSize();
+            const int32 Axis = (Size.X >= Size.Y && Size.X >= Size.Z) ? 0 : (Size.Y >= Size.Z ? 1 : 2);
+
+            Sort(Order.GetData() + Begin, Count, [&Centroids, Axis](int32 A, int32 B)
+            {
+                return Centroids[A][Axis] < Centroids[B][Axis];
+            });
+
+            const int32 Mid = Begin + Count / 2;
+            Ranges.Emplace(Mid, Range.Value);
+            Ranges.Emplace(Begin, Mid);
+            continue;
+        }
+
+        FModelGenMeshData& Chunk = OutChunks.AddDefaulted_GetRef();
+        Chunk.Triangles.Reserve(Count * 3);
+
+        for (int32 i = Begin; i < Range.Value; ++i)
+        {
+            for (int32 Corner = 0; Corner < 3; ++Corner)
+            {
+                const int32 SourceIndex = Triangles[Order[i] * 3 + Corner];
+                int32& ChunkIndex = Remap[SourceIndex];
+                if (ChunkIndex == INDEX_NONE)
+                {
+                    ChunkIndex = Chunk.Vertices.Add(Vertices[SourceIndex]);
+                    if (bHasNormals) Chunk.Normals.Add(Normals[SourceIndex]);
+                    if (bHasUVs) Chunk.UVs.Add(UVs[SourceIndex]);
+                    if (bHasColors) Chunk.VertexColors.Add(VertexColors[SourceIndex]);
+                    if (bHasTangents) Chunk.Tangents.Add(Tangents[SourceIndex]);
+                }
+                Chunk.Triangles.Add(ChunkIndex);
+            }
+        }
+
+        // 只复位本块用到的顶点，避免每块都重置整张映射表
+        for (int32 i = Begin; i < Range.Value; ++i)
+        {
+            Remap[Triangles[Order[i] * 3]] = INDEX_NONE;
+            Remap[Triangles[Order[i] * 3 + 1]] = INDEX_NONE;
+            Remap[Triangles[Order[i] * 3 + 2]] = INDEX_NONE;
+        }
+
+        Chunk.VertexCount = Chunk.Vertices.Num();
+        Chunk.TriangleCount = Chunk.Triangles.Num() / 3;
+    }
+}
+
 void FModelGenMeshData::CalculateTangents()
 {
-    if (Vertices.Num() == 0 || Triangles.Num() == 0 || UVs.Num() != Vertices.Num())
+    MODELGEN_STAGE_SCOPE(CalculateTangents);
+
+    const int32 NumVertices = Vertices.Num();
+    if (NumVertices == 0 || Triangles.Num() == 0 || UVs.Num() != NumVertices || Normals.Num() != NumVertices)
     {
         return;
     }
 
-    TArray<FVector> OriginalNormals = Normals;
-    
-    TArray<FVector> OutNormals;
-    TArray<FProcMeshTangent> OutTangents;
-    
-    OutNormals.SetNum(Vertices.Num());
-    OutTangents.SetNum(Vertices.Num());
-    
-    UKismetProceduralMeshLibrary::CalculateTangentsForMesh(
-        Vertices, 
-        Triangles, 
-        UVs, 
-        OutNormals, 
-        OutTangents
-    );
-    
-    Normals = MoveTemp(OriginalNormals);
-    Tangents = MoveTemp(OutTangents);
+    // 逐面按 UV 梯度求切线/副切线并累加到顶点，只按索引共享顶点，不做位置合并
+    TArray<FVector> TangentSumX;
+    TArray<FVector> TangentSumY;
+    TangentSumX.SetNumZeroed(NumVertices);
+    TangentSumY.SetNumZeroed(NumVertices);
+
+    for (int32 TriIdx = 0; TriIdx + 2 < Triangles.Num(); TriIdx += 3)
+    {
+        const int32 I0 = Triangles[TriIdx];
+        const int32 I1 = Triangles[TriIdx + 1];
+        const int32 I2 = Triangles[TriIdx + 2];
+
+        const FVector Edge1 = Vertices[I1] - Vertices[I0];
+        const FVector Edge2 = Vertices[I2] - Vertices[I0];
+        const FVector TriNormal = (Edge2 ^ Edge1).GetSafeNormal();
+
+        const FVector2D DeltaUV1 = UVs[I1] - UVs[I0];
+        const FVector2D DeltaUV2 = UVs[I2] - UVs[I0];
+        const float Det = DeltaUV1.X * DeltaUV2.Y - DeltaUV2.X * DeltaUV1.Y;
+
+        if (TriNormal.IsZero() || FMath::Abs(Det) <= SMALL_NUMBER)
+        {
+            continue;
+        }
+
+        const float InvDet = 1.0f / Det;
+        FVector FaceTangentX = (Edge1 * DeltaUV2.Y - Edge2 * DeltaUV1.Y) * InvDet;
+        FVector FaceTangentY = (Edge2 * DeltaUV1.X - Edge1 * DeltaUV2.X) * InvDet;
+
+        // 与 Kismet 相同：面切线先对面法线正交化，每个面等权累加
+        FaceTangentX -= TriNormal * (TriNormal | FaceTangentX);
+        FaceTangentX.Normalize();
+
+        FaceTangentY -= FaceTangentX * (FaceTangentX | FaceTangentY);
+        FaceTangentY -= TriNormal * (TriNormal | FaceTangentY);
+        FaceTangentY.Normalize();
+
+        TangentSumX[I0] += FaceTangentX;
+        TangentSumX[I1] += FaceTangentX;
+        TangentSumX[I2] += FaceTangentX;
+        TangentSumY[I0] += FaceTangentY;
+        TangentSumY[I1] += FaceTangentY;
+        TangentSumY[I2] += FaceTangentY;
+    }
+
+    Tangents.SetNum(NumVertices);
+
+    // 逐顶点：对生成器给出的（已归一化的）法线做 Gram-Schmidt，并由 (N x T) · B 决定副切线翻转
+    for (int32 VertIdx = 0; VertIdx < NumVertices; ++VertIdx)
+    {
+        const VectorRegister Normal = VectorLoadFloat3_W0(&Normals[VertIdx]);
+        const VectorRegister SumY = VectorLoadFloat3_W0(&TangentSumY[VertIdx]);
+        VectorRegister TangentX = VectorLoadFloat3_W0(&TangentSumX[VertIdx]);
+
+        TangentX = VectorSubtract(TangentX, VectorMultiply(Normal, VectorDot3(Normal, TangentX)));
+        const VectorRegister LengthSq = VectorDot3(TangentX, TangentX);
+
+        if (VectorGetComponent(LengthSq, 0) <= KINDA_SMALL_NUMBER)
+        {
+            // 没有有效 UV 梯度（退化 UV 或孤立顶点）时回退到由法线构造的切线
+            Tangents[VertIdx] = FProcMeshTangent(CalculateTangent(Normals[VertIdx]), false);
+            continue;
+        }
+
+        TangentX = VectorMultiply(TangentX, VectorReciprocalSqrtAccurate(LengthSq));
+        const VectorRegister Handedness = VectorDot3(VectorCross(Normal, TangentX), SumY);
+
+        FVector OutTangentX;
+        VectorStoreFloat3(TangentX, &OutTangentX);
+        Tangents[VertIdx] = FProcMeshTangent(OutTangentX, VectorGetComponent(Handedness, 0) < 0.0f);
+    }
+
+#if !UE_BUILD_SHIPPING
+    if (ModelGenTangents::CVarValidateTangents.GetValueOnAnyThread() != 0)
+    {
+        ModelGenTangents::CompareWithKismet(*this);
+    }
+#endif
 }
 
 FVector FModelGenMeshData::CalculateTangent(const FVector& Normal) const
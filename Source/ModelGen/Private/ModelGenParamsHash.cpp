@@ -0,0 +1,207 @@
+// Copyright (c) 2024. All rights reserved.
+
+#include "ModelGenParamsHash.h"
+#include "Misc/SecureHash.h"
+#include "UObject/Class.h"
+#include "UObject/UnrealType.h"
+#include "UObject/EnumProperty.h"
+
+namespace
+{
+    // 按字段类型写入规范化字节流，保证相同取值得到相同字节
+    class FParamsHashWriter
+    {
+    public:
+        TArray<uint8> Bytes;
+
+        // 为 true 时浮点字段只写字段名不写取值
+        bool bSkipContinuous = false;
+
+        template <typename T>
+        void Write(const T& Value)
+        {
+            Bytes.Append(reinterpret_cast<const uint8*>(&Value), sizeof(T));
+        }
+
+        void WriteFloat(float Value)
+        {
+            uint32 Bits = 0;
+            if (FMath::IsNaN(Value))
+            {
+                Bits = 0x7FC00000u;
+            }
+            else if (Value != 0.0f) // +0 与 -0 视为相同
+            {
+                FMemory::Memcpy(&Bits, &Value, sizeof(Bits));
+            }
+            Write(Bits);
+        }
+
+        void WriteDouble(double Value)
+        {
+            uint64 Bits = 0;
+            if (FMath::IsNaN(Value))
+            {
+                Bits = 0x7FF8000000000000ull;
+            }
+            else if (Value != 0.0)
+            {
+                FMemory::Memcpy(&Bits, &Value, sizeof(Bits));
+            }
+            Write(Bits);
+        }
+
+        void WriteString(const FString& Value)
+        {
+            Write(static_cast<int32>(Value.Len()));
+            for (TCHAR Char : Value)
+            {
+                Write(static_cast<uint16>(Char));
+            }
+        }
+
+        void WriteStruct(const UScriptStruct* Struct, const void* Data);
+
+    private:
+        void WriteValue(const FProperty* Property, const void* Value);
+    };
+
+    void FParamsHashWriter::WriteStruct(const UScriptStruct* Struct, const void* Data)
+    {
+        WriteString(Struct->GetName());
+
+        for (TFieldIterator<FProperty> It(Struct); It; ++It)
+        {
+            const FProperty* Property = *It;
+            if (Property->HasAnyPropertyFlags(CPF_Transient))
+            {
+                continue;
+            }
+
+            WriteString(Property->GetName());
+            for (int32 ArrayIdx = 0; ArrayIdx < Property->ArrayDim; ++ArrayIdx)
+            {
+                WriteValue(Property, Property->ContainerPtrToValuePtr<void>(Data, ArrayIdx));
+            }
+        }
+    }
+
+    void FParamsHashWriter::WriteValue(const FProperty* Property, const void* Value)
+    {
+        if (const FFloatProperty* FloatProp = CastField<FFloatProperty>(Property))
+        {
+            if (!bSkipContinuous)
+            {
+                WriteFloat(FloatProp->GetPropertyValue(Value));
+            }
+        }
+        else if (const FDoubleProperty* DoubleProp = CastField<FDoubleProperty>(Property))
+        {
+            if (!bSkipContinuous)
+            {
+                WriteDouble(DoubleProp->GetPropertyValue(Value));
+            }
+        }
+        else if (const FBoolProperty* BoolProp = CastField<FBoolProperty>(Property))
+        {
+            Write(static_cast<uint8>(BoolProp->GetPropertyValue(Value) ? 1 : 0));
+        }
+        else if (const FEnumProperty* EnumProp = CastField<FEnumProperty>(Property))
+        {
+            Write(EnumProp->GetUnderlyingProperty()->GetSignedIntPropertyValue(Value));
+        }
+        else if (const FNumericProperty* NumericProp = CastField<FNumericProperty>(Property))
+        {
+            Write(NumericProp->GetSignedIntPropertyValue(Value));
+        }
+        else if (const FStrProperty* StrProp = CastField<FStrProperty>(Property))
+        {
+            WriteString(StrProp->GetPropertyValue(Value));
+        }
+        else if (const FNameProperty* NameProp = CastField<FNameProperty>(Property))
+        {
+            WriteString(NameProp->GetPropertyValue(Value).ToString());
+        }
+        else if (const FStructProperty* StructProp = CastField<FStructProperty>(Property))
+        {
+            WriteStruct(StructProp->Struct, Value);
+        }
+        else if (const FArrayProperty* ArrayProp = CastField<FArrayProperty>(Property))
+        {
+            FScriptArrayHelper ArrayHelper(ArrayProp, Value);
+            Write(static_cast<int32>(ArrayHelper.Num()));
+            for (int32 i = 0; i < ArrayHelper.Num(); ++i)
+            {
+                WriteValue(ArrayProp->Inner, ArrayHelper.GetRawPtr(i));
+            }
+        }
+        else if (const FObjectPropertyBase* ObjectProp = CastField<FObjectPropertyBase>(Property))
+        {
+            const UObject* Object = ObjectProp->GetObjectPropertyValue(Value);
+            WriteString(Object ? Object->GetPathName() : FString());
+        }
+        else
+        {
+            // 其余类型按导出文本参与哈希
+            FString Text;
+            Property->ExportTextItem(Text, Value, nullptr, nullptr, PPF_None);
+            WriteString(Text);
+        }
+    }
+}
+
+FString FModelGenParamsHash::ToString() const
+{
+    return FString::Printf(TEXT("%016llx%016llx"), High, Low);
+}
+
+FModelGenParamsHash FModelGenParamsHash::Compute(const UScriptStruct* Struct, const void* Data)
+{
+    FModelGenParamsHash Result;
+    if (!Struct || !Data)
+    {
+        return Result;
+    }
+
+    FParamsHashWriter Writer;
+    Writer.WriteStruct(Struct, Data);
+
+    return ComputeBytes(Writer.Bytes.GetData(), Writer.Bytes.Num());
+}
+
+FModelGenParamsHash FModelGenParamsHash::ComputeDiscrete(const UScriptStruct* Struct, const void* Data)
+{
+    FModelGenParamsHash Result;
+    if (!Struct || !Data)
+    {
+        return Result;
+    }
+
+    FParamsHashWriter Writer;
+    Writer.bSkipContinuous = true;
+    Writer.WriteStruct(Struct, Data);
+
+    return ComputeBytes(Writer.Bytes.GetData(), Writer.Bytes.Num());
+}
+
+FModelGenParamsHash FModelGenParamsHash::ComputeBytes(const void* Data, int64 NumBytes)
+{
+    FModelGenParamsHash Result;
+    if (!Data || NumBytes <= 0)
+    {
+        return Result;
+    }
+
+    // 引擎的 CityHash 只有 64 位版本，两个种子得到的两半都由同一个 64 位中间值导出；
+    // 改取 SHA1 摘要的前 128 位，长度按 uint64 传入，不会截断
+    FSHA1 Sha;
+    Sha.Update(static_cast<const uint8*>(Data), static_cast<uint64>(NumBytes));
+    Sha.Final();
+
+    uint8 Digest[FSHA1::DigestSize];
+    Sha.GetHash(Digest);
+
+    FMemory::Memcpy(&Result.Low, Digest, sizeof(uint64));
+    FMemory::Memcpy(&Result.High, Digest + sizeof(uint64), sizeof(uint64));
+    return Result;
+}
@@ -0,0 +1,305 @@
+// Copyright (c) 2024. All rights reserved.
+
+#include "ModelGenShapeParams.h"
+
+bool FFrustumParams::IsValid() const
+{
+    return TopRadius > 0.0f && BottomRadius > 0.0f && Height > 0.0f &&
+           TopSides >= 3 && TopSides <= 25 && BottomSides >= 3 && BottomSides <= 25 && HeightSegments >= 0 && HeightSegments <= 12 &&
+           BevelRadius >= 0.0f &&
+           MinBendRadius >= 0.0f && ArcAngle > 0.0f && ArcAngle <= 360.0f;
+}
+
+int32 FFrustumParams::CalculateVertexCountEstimate() const
+{
+    if (!IsValid()) return 0;
+
+    const int32 MaxSides = FMath::Max(TopSides, BottomSides);
+    const int32 BaseVertices = TopSides + BottomSides + 2; // 加中心点
+    const int32 SideVertices = (HeightSegments + 1) * MaxSides; // 包括顶部和底部
+
+    int32 BevelVertices = 0;
+    if (BevelRadius > 0.0f && BevelSegments > 0)
+    {
+        BevelVertices = (TopSides + BottomSides) * (BevelSegments + 1) * 2; // 顶部和底部倒角，每个有 (Segments + 1) 环
+    }
+
+    return BaseVertices + SideVertices + BevelVertices;
+}
+
+int32 FFrustumParams::CalculateTriangleCountEstimate() const
+{
+    if (!IsValid()) return 0;
+
+    const int32 MaxSides = FMath::Max(TopSides, BottomSides);
+    const int32 BaseTriangles = TopSides + BottomSides;
+    const int32 SideTriangles = HeightSegments * MaxSides * 2;
+
+    int32 BevelTriangles = 0;
+    if (BevelRadius > 0.0f && BevelSegments > 0)
+    {
+        BevelTriangles = (TopSides + BottomSides) * BevelSegments * 2 * 2; // 每个倒角部分有 Segments 个 quad
+    }
+
+    return BaseTriangles + SideTriangles + BevelTriangles;
+}
+
+bool FSphereParams::IsValid() const
+{
+    return Radius > KINDA_SMALL_NUMBER &&
+        Sides >= 4 && Sides <= 64 &&
+        HorizontalCut >= 0.0f && HorizontalCut < 1.0f &&
+        VerticalCut > KINDA_SMALL_NUMBER && VerticalCut <= 1.0f;
+}
+
+int32 FSphereParams::CalculateVertexCountEstimate() const
+{
+    const int32 NumRings = FMath::Max(2, Sides / 2);
+    const int32 GridVerts = (NumRings + 1) * (Sides + 1);
+    const int32 CapVerts = Sides * 4; // 粗略估算顶部和侧面切口的顶点
+    return GridVerts + CapVerts;
+}
+
+int32 FSphereParams::CalculateTriangleCountEstimate() const
+{
+    const int32 NumRings = FMath::Max(2, Sides / 2);
+    const int32 GridTris = NumRings * Sides * 2;
+    const int32 CapTris = Sides * 4;
+    return GridTris + CapTris;
+}
+
+bool FHollowPrismParams::IsValid() const
+{
+    return InnerRadius > 0.0f && OuterRadius > 0.0f && Height > 0.0f &&
+           InnerRadius < OuterRadius &&
+           InnerSides >= 3 && InnerSides <= 25 && OuterSides >= 3 && OuterSides <= 25 &&
+           ArcAngle > 0.0f && ArcAngle <= 360.0f &&
+           BevelRadius >= 0.0f && BevelSegments >= 0;
+}
+
+int32 FHollowPrismParams::CalculateVertexCountEstimate() const
+{
+    if (!IsValid())
+    {
+        return 0;
+    }
+
+    const int32 BaseVertices = InnerSides + OuterSides;
+
+    int32 BevelVertices = 0;
+    if (BevelRadius > 0.0f && BevelSegments > 0)
+    {
+        BevelVertices = (InnerSides + OuterSides) * BevelSegments * 2;
+    }
+
+    int32 EndCapVertices = 0;
+    if (!IsFullCircle())
+    {
+        EndCapVertices = InnerSides + OuterSides;
+    }
+
+    return BaseVertices + BevelVertices + EndCapVertices;
+}
+
+int32 FHollowPrismParams::CalculateTriangleCountEstimate() const
+{
+    if (!IsValid())
+    {
+        return 0;
+    }
+
+    const int32 BaseTriangles = InnerSides + OuterSides;
+
+    int32 BevelTriangles = 0;
+    if (BevelRadius > 0.0f && BevelSegments > 0)
+    {
+        BevelTriangles = (InnerSides + OuterSides) * BevelSegments * 2;
+    }
+
+    int32 EndCapTriangles = 0;
+    if (!IsFullCircle())
+    {
+        EndCapTriangles = InnerSides + OuterSides;
+    }
+
+    return BaseTriangles + BevelTriangles + EndCapTriangles;
+}
+
+bool FPolygonTorusParams::IsValid() const
+{
+    return MajorRadius > 0.0f &&
+           MinorRadius > 0.0f && MinorRadius <= MajorRadius * 0.9f &&
+           MajorSegments >= 3 && MajorSegments <= 25 &&
+           MinorSegments >= 3 && MinorSegments <= 25 &&
+           TorusAngle >= 0.0f && TorusAngle <= 360.0f;
+}
+
+int32 FPolygonTorusParams::CalculateVertexCountEstimate() const
+{
+    const int32 BaseVertexCount = MajorSegments * MinorSegments;
+    const int32 CapVertexCount = (TorusAngle < 360.0f - KINDA_SMALL_NUMBER) ? MinorSegments * 2 : 0;
+
+    return BaseVertexCount + CapVertexCount;
+}
+
+int32 FPolygonTorusParams::CalculateTriangleCountEstimate() const
+{
+    const int32 BaseTriangleCount = MajorSegments * MinorSegments * 2;
+    const int32 CapTriangleCount = (TorusAngle < 360.0f - KINDA_SMALL_NUMBER) ? MinorSegments * 2 : 0;
+
+    return BaseTriangleCount + CapTriangleCount;
+}
+
+bool FPyramidParams::IsValid() const
+{
+    return BaseRadius > 0.0f && Height > 0.0f &&
+           Sides >= 3 && Sides <= 25 &&
+           BevelRadius >= 0.0f && BevelRadius < Height;
+}
+
+float FPyramidParams::GetBevelTopRadius() const
+{
+    if (BevelRadius <= 0.0f)
+    {
+        return BaseRadius;
+    }
+
+    const float ScaleFactor = 1.0f - (BevelRadius / Height);
+    return FMath::Max(0.0f, BaseRadius * ScaleFactor);
+}
+
+int32 FPyramidParams::CalculateVertexCountEstimate() const
+{
+    const int32 BaseVertexCount = Sides;
+    const int32 BevelVertexCount = (BevelRadius > 0.0f) ? Sides * 2 : 0;
+    const int32 PyramidVertexCount = Sides + 1;
+
+    return BaseVertexCount + BevelVertexCount + PyramidVertexCount;
+}
+
+int32 FPyramidParams::CalculateTriangleCountEstimate() const
+{
+    const int32 BaseTriangleCount = Sides - 2;
+    const int32 BevelTriangleCount = (BevelRadius > 0.0f) ? Sides * 2 : 0;
+    const int32 PyramidTriangleCount = Sides;
+
+    return BaseTriangleCount + BevelTriangleCount + PyramidTriangleCount;
+}
+
+bool FBevelCubeParams::IsValid() const
+{
+    return Size.X > 0.0f && Size.Y > 0.0f && Size.Z > 0.0f &&
+        BevelRadius >= 0.0f &&
+        BevelSegments >= 0 && BevelSegments <= 10;
+}
+
+int32 FBevelCubeParams::GetVertexCount() const
+{
+    if (BevelSegments == 0)
+    {
+        return 24;
+    }
+    return 24 + 24 * (BevelSegments + 1) + 4 * (BevelSegments + 1) * (BevelSegments + 1);
+}
+
+int32 FBevelCubeParams::GetTriangleCount() const
+{
+    if (BevelSegments == 0)
+    {
+        return 12;
+    }
+    return 12 + 24 * BevelSegments + 8 * BevelSegments * BevelSegments;
+}
+
+void FEditableSurfaceParams::BuildSplineCurves(int32 ReparamStepsPerSegment)
+{
+    SplineCurves.Position.Points.Reset();
+    SplineCurves.Rotation.Points.Reset();
+    SplineCurves.Scale.Points.Reset();
+
+    if (Waypoints.Num() < 2)
+    {
+        SplineCurves.UpdateSpline(false, false, ReparamStepsPerSegment);
+        return;
+    }
+
+    auto GetActualWidth = [&](float WPWidth) -> float {
+        return (WPWidth > 0.0f) ? WPWidth : SurfaceWidth;
+    };
+
+    auto AddPoint = [&](const FVector& Position, float Width)
+    {
+        const float InputKey = static_cast<float>(SplineCurves.Position.Points.Num());
+        SplineCurves.Position.Points.Emplace(InputKey, Position, FVector::ZeroVector, FVector::ZeroVector, CIM_CurveAuto);
+        SplineCurves.Rotation.Points.Emplace(InputKey, FQuat::Identity, FQuat::Identity, FQuat::Identity, CIM_CurveAuto);
+        SplineCurves.Scale.Points.Emplace(InputKey, FVector(1.0f, Width, 1.0f), FVector::ZeroVector, FVector::ZeroVector, CIM_CurveAuto);
+    };
+
+    if (CurveType == ESurfaceCurveType::Standard)
+    {
+        for (const FSurfaceWaypoint& Waypoint : Waypoints)
+        {
+            AddPoint(Waypoint.Position, GetActualWidth(Waypoint.Width));
+        }
+    }
+    else
+    {
+        AddPoint(Waypoints[0].Position, GetActualWidth(Waypoints[0].Width));
+
+        for (int32 i = 0; i < Waypoints.Num() - 1; ++i)
+        {
+            const FSurfaceWaypoint& P0 = Waypoints[i];
+            const FSurfaceWaypoint& P1 = Waypoints[i + 1];
+
+            const float MidWidth = (GetActualWidth(P0.Width) + GetActualWidth(P1.Width)) * 0.5f;
+            AddPoint((P0.Position + P1.Position) * 0.5f, MidWidth);
+        }
+
+        AddPoint(Waypoints.Last().Position, GetActualWidth(Waypoints.Last().Width));
+    }
+
+    SplineCurves.UpdateSpline(false, false, ReparamStepsPerSegment);
+}
+
+FTransform FEditableSurfaceParams::GetTransformAtDistance(float Distance) const
+{
+    // 与 USplineComponent::GetTransformAtDistanceAlongSpline(Local) 的求值方式一致
+    const float InputKey = SplineCurves.ReparamTable.Eval(Distance, 0.0f);
+
+    const FVector Location = SplineCurves.Position.Eval(InputKey, FVector::ZeroVector);
+
+    FQuat Quat = SplineCurves.Rotation.Eval(InputKey, FQuat::Identity);
+    Quat.Normalize();
+
+    const FVector Direction = SplineCurves.Position.EvalDerivative(InputKey, FVector::ZeroVector).GetSafeNormal();
+    const FVector UpVector = Quat.RotateVector(DefaultUpVector);
+    const FQuat Rotation = FRotationMatrix::MakeFromXZ(Direction, UpVector).ToQuat();
+
+    return FTransform(Rotation, Location);
+}
+
+float FEditableSurfaceParams::GetDistanceAtSplinePoint(int32 PointIndex) const
+{
+    // 与 USplineComponent::GetDistanceAlongSplineAtSplinePoint 一致，每段的重参数化步数由表长反推
+    const int32 NumSegments = GetNumSplinePoints() - 1;
+    const TArray<FInterpCurvePoint<float>>& ReparamPoints = SplineCurves.ReparamTable.Points;
+    if (NumSegments < 1 || ReparamPoints.Num() < 2)
+    {
+        return 0.0f;
+    }
+
+    const int32 StepsPerSegment = FMath::Max(1, (ReparamPoints.Num() - 1) / NumSegments);
+    const int32 ReparamIndex = FMath::Clamp(PointIndex, 0, NumSegments) * StepsPerSegment;
+    return ReparamPoints[FMath::Min(ReparamIndex, ReparamPoints.Num() - 1)].InVal;
+}
+
+FVector FEditableSurfaceParams::GetScaleAtDistance(float Distance) const
+{
+    const float InputKey = SplineCurves.ReparamTable.Eval(Distance, 0.0f);
+    return SplineCurves.Scale.Eval(InputKey, FVector(1.0f));
+}
+
+bool FEditableSurfaceParams::IsValid() const
+{
+    return Waypoints.Num() >= 2 && GetNumSplinePoints() >= 2;
+}
@@ -0,0 +1,222 @@
+// Copyright (c) 2024. All rights reserved.
+
+#include "ModelGenStaticMeshCache.h"
+#include "Engine/StaticMesh.h"
+#include "StaticMeshResources.h"
+#include "PhysicsEngine/BodySetup.h"
+#include "ModelGenStats.h"
+
+FModelGenStaticMeshCache& FModelGenStaticMeshCache::Get()
+{
+    // 有意不在静态析构阶段销毁：此时 GC 引用收集器可能已经释放
+    static FModelGenStaticMeshCache* Instance = new FModelGenStaticMeshCache();
+    return *Instance;
+}
+
+FModelGenStaticMeshCache::FModelGenStaticMeshCache()
+{
+}
+
+FModelGenStaticMeshCache::~FModelGenStaticMeshCache()
+{
+    Empty();
+}
+
+bool FModelGenStaticMeshCache::IsMeshUsable(const UStaticMesh* Mesh)
+{
+    return IsValid(Mesh) &&
+        !Mesh->HasAnyFlags(RF_BeginDestroyed | RF_FinishDestroyed) &&
+        Mesh->RenderData != nullptr &&
+        Mesh->RenderData->IsInitialized();
+}
+
+int64 FModelGenStaticMeshCache::CalculateMeshBytes(const UStaticMesh* Mesh)
+{
+    if (!Mesh)
+    {
+        return 0;
+    }
+
+    FResourceSizeEx ResourceSize(EResourceSizeMode::EstimatedTotal);
+
+    if (Mesh->RenderData)
+    {
+        Mesh->RenderData->GetResourceSizeEx(ResourceSize);
+    }
+
+    if (Mesh->BodySetup)
+    {
+        Mesh->BodySetup->GetResourceSizeEx(ResourceSize);
+    }
+
+    return static_cast<int64>(ResourceSize.GetTotalMemoryBytes());
+}
+
+UStaticMesh* FModelGenStaticMeshCache::Find(const FModelGenParamsHash& Key)
+{
+    FScopeLock ScopeLock(&Lock);
+
+    FEntry* Entry = Entries.Find(Key);
+    if (!Entry)
+    {
+        ++MissCount;
+        return nullptr;
+    }
+
+    if (!IsMeshUsable(Entry->Mesh))
+    {
+        RemoveEntry(Key);
+        ++MissCount;
+        return nullptr;
+    }
+
+    LruList.RemoveNode(Entry->LruNode, false);
+    LruList.AddHead(Entry->LruNode);
+
+    ++HitCount;
+    return Entry->Mesh;
+}
+
+void FModelGenStaticMeshCache::Add(const FModelGenParamsHash& Key, UStaticMesh* Mesh)
+{
+    if (!Key.IsValid() || !Mesh)
+    {
+        return;
+    }
+
+    FScopeLock ScopeLock(&Lock);
+
+    RemoveEntry(Key);
+
+    LruList.AddHead(Key);
+
+    FEntry& Entry = Entries.Add(Key);
+    Entry.Mesh = Mesh;
+    Entry.SizeBytes = CalculateMeshBytes(Mesh);
+    Entry.LruNode = LruList.GetHead();
+
+    TotalBytes += Entry.SizeBytes;
+
+    EvictToBudget(Key);
+    SET_MEMORY_STAT(STAT_ModelGen_StaticMeshCacheMemory, TotalBytes);
+}
+
+void FModelGenStaticMeshCache::Remove(const FModelGenParamsHash& Key)
+{
+    FScopeLock ScopeLock(&Lock);
+    RemoveEntry(Key);
+}
+
+void FModelGenStaticMeshCache::Empty()
+{
+    FScopeLock ScopeLock(&Lock);
+
+    Entries.Empty();
+    LruList.Empty();
+    TotalBytes = 0;
+    SET_MEMORY_STAT(STAT_ModelGen_StaticMeshCacheMemory, 0);
+    HitCount = 0;
+    MissCount = 0;
+    EvictionCount = 0;
+}
+
+int32 FModelGenStaticMeshCache::RemoveInvalidEntries()
+{
+    FScopeLock ScopeLock(&Lock);
+
+    TArray<FModelGenParamsHash> KeysToRemove;
+    for (const TPair<FModelGenParamsHash, FEntry>& Pair : Entries)
+    {
+        if (!IsMeshUsable(Pair.Value.Mesh))
+        {
+            KeysToRemove.Add(Pair.Key);
+        }
+    }
+
+    for (const FModelGenParamsHash& Key : KeysToRemove)
+    {
+        RemoveEntry(Key);
+    }
+
+    return KeysToRemove.Num();
+}
+
+void FModelGenStaticMeshCache::SetBudgetBytes(int64 InBudgetBytes)
+{
+    FScopeLock ScopeLock(&Lock);
+
+    BudgetBytes = FMath::Max<int64>(InBudgetBytes, 0);
+    EvictToBudget(FModelGenParamsHash());
+}
+
+int64 FModelGenStaticMeshCache::GetBudgetBytes() const
+{
+    FScopeLock ScopeLock(&Lock);
+    return BudgetBytes;
+}
+
+int32 FModelGenStaticMeshCache::Num() const
+{
+    FScopeLock ScopeLock(&Lock);
+    return Entries.Num();
+}
+
+FModelGenStaticMeshCacheStats FModelGenStaticMeshCache::GetStats() const
+{
+    FScopeLock ScopeLock(&Lock);
+
+    FModelGenStaticMeshCacheStats Stats;
+    Stats.NumEntries = Entries.Num();
+    Stats.TotalBytes = TotalBytes;
+    Stats.BudgetBytes = BudgetBytes;
+    Stats.HitCount = HitCount;
+    Stats.MissCount = MissCount;
+    Stats.EvictionCount = EvictionCount;
+
+    const int32 TotalRequests = HitCount + MissCount;
+    Stats.HitRate = TotalRequests > 0 ? static_cast<float>(HitCount) / TotalRequests : 0.0f;
+
+    return Stats;
+}
+
+void FModelGenStaticMeshCache::RemoveEntry(const FModelGenParamsHash& Key)
+{
+    FEntry Entry;
+    if (Entries.RemoveAndCopyValue(Key, Entry))
+    {
+        TotalBytes -= Entry.SizeBytes;
+        LruList.RemoveNode(Entry.LruNode);
+        SET_MEMORY_STAT(STAT_ModelGen_StaticMeshCacheMemory, TotalBytes);
+    }
+}
+
+void FModelGenStaticMeshCache::EvictToBudget(const FModelGenParamsHash& KeepKey)
+{
+    // 从最久未使用的一端淘汰，刚加入的条目即使单独超出预算也保留
+    while (TotalBytes > BudgetBytes && LruList.GetTail())
+    {
+        const FModelGenParamsHash OldestKey = LruList.GetTail()->GetValue();
+        if (OldestKey == KeepKey)
+        {
+            break;
+        }
+
+        RemoveEntry(OldestKey);
+        ++EvictionCount;
+    }
+}
+
+void FModelGenStaticMeshCache::AddReferencedObjects(FReferenceCollector& Collector)
+{
+    FScopeLock ScopeLock(&Lock);
+
+    for (TPair<FModelGenParamsHash, FEntry>& Pair : Entries)
+    {
+        Collector.AddReferencedObject(Pair.Value.Mesh);
+    }
+}
+
+FString FModelGenStaticMeshCache::GetReferencerName() const
+{
+    return TEXT("FModelGenStaticMeshCache");
+}
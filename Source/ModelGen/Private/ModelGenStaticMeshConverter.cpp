@@ -0,0 +1,927 @@
+// Copyright (c) 2024. All rights reserved.
+
+#include "ModelGenStaticMeshConverter.h"
+
+#include "Engine/StaticMesh.h"
+#include "Materials/MaterialInterface.h"
+#include "MeshDescription.h"
+#include "MeshDescriptionBuilder.h"
+#include "PhysicsEngine/BodySetup.h"
+#include "PhysicsEngine/PhysicsSettings.h"
+#include "PhysicalMaterials/PhysicalMaterial.h"
+#include "ProceduralMeshComponent.h"
+#include "Rendering/PositionVertexBuffer.h"
+#include "StaticMeshAttributes.h"
+#include "StaticMeshResources.h"
+#include "HAL/PlatformProperties.h"
+#include "Interface_CollisionDataProviderCore.h"
+#include "IPhysXCookingModule.h"
+#include "IPhysXCooking.h"
+#include "PhysicsPublicCore.h"
+#include "ModelGenConvexDecomp.h"
+#include "ModelGenCollisionCookCache.h"
+#include "ModelGenStats.h"
+#include "Async/Async.h"
+#include "PhysXIncludes.h"
+
+namespace
+{
+    // 顶点位置的焊接键：哈希只计算一次，TMap<FVector> 默认对整个向量做 CRC，开销明显更高
+    struct FPositionWeldKey
+    {
+        FVector Position;
+        uint32 Hash;
+
+        explicit FPositionWeldKey(const FVector& InPosition)
+            // 加 0 使 -0 归一为 +0，保证相等的位置哈希一致
+            : Position(InPosition.X + 0.0f, InPosition.Y + 0.0f, InPosition.Z + 0.0f)
+        {
+            uint32 Bits[3];
+            FMemory::Memcpy(Bits, &Position, sizeof(Bits));
+            Hash = HashCombine(HashCombine(Bits[0], Bits[1]), Bits[2]);
+        }
+
+        bool operator==(const FPositionWeldKey& Other) const
+        {
+            return Position == Other.Position;
+        }
+
+        friend uint32 GetTypeHash(const FPositionWeldKey& Key)
+        {
+            return Key.Hash;
+        }
+    };
+
+    // 碰撞只需要位置：合并 UV 接缝、硬边处拆开的重复顶点，减少烘焙量并让相同几何得到相同的缓存键
+    void WeldTriMeshVertices(TArray<FVector>& InOutVertices, TArray<FTriIndices>& InOutIndices)
+    {
+        TMap<FPositionWeldKey, int32> WeldedIndexMap;
+        WeldedIndexMap.Reserve(InOutVertices.Num());
+
+        TArray<FVector> WeldedVertices;
+        WeldedVertices.Reserve(InOutVertices.Num());
+
+        TArray<int32> Remap;
+        Remap.SetNumUninitialized(InOutVertices.Num());
+
+        for (int32 VertIdx = 0; VertIdx < InOutVertices.Num(); ++VertIdx)
+        {
+            const FPositionWeldKey Key(InOutVertices[VertIdx]);
+            if (const int32* Existing = WeldedIndexMap.FindByHash(Key.Hash, Key))
+            {
+                Remap[VertIdx] = *Existing;
+            }
+            else
+            {
+                Remap[VertIdx] = WeldedVertices.Add(Key.Position);
+                WeldedIndexMap.AddByHash(Key.Hash, Key, Remap[VertIdx]);
+            }
+        }
+
+        if (WeldedVertices.Num() == InOutVertices.Num())
+        {
+            return;
+        }
+
+        for (FTriIndices& Tri : InOutIndices)
+        {
+            Tri.v0 = Remap[Tri.v0];
+            Tri.v1 = Remap[Tri.v1];
+            Tri.v2 = Remap[Tri.v2];
+        }
+
+        InOutVertices = MoveTemp(WeldedVertices);
+    }
+}
+
+UStaticMesh* FModelGenStaticMeshConverter::CreateStaticMesh(TArrayView<const FModelGenMeshData> Sections, const FModelGenStaticMeshSettings& Settings,
+    TArrayView<const FModelGenMeshData> LODMeshes)
+{
+    check(IsInGameThread());
+
+    if (Sections.Num() == 0)
+    {
+        return nullptr;
+    }
+
+    UStaticMesh* StaticMesh = CreateStaticMeshObject(Sections.Num(), Settings);
+    if (!StaticMesh)
+    {
+        return nullptr;
+    }
+
+    if (!BuildStaticMeshGeometry(Sections, LODMeshes, StaticMesh))
+    {
+        return nullptr;
+    }
+
+    InitializeStaticMeshRenderData(StaticMesh);
+    SetupBodySetupAndCollision(Sections, StaticMesh, Settings);
+    StaticMesh->CreateNavCollision(true);
+
+    return StaticMesh;
+}
+
+UStaticMesh* FModelGenStaticMeshConverter::CreateStaticMesh(const FModelGenMeshData& MeshData, const FModelGenStaticMeshSettings& Settings,
+    TArrayView<const FModelGenMeshData> LODMeshes)
+{
+    return CreateStaticMesh(MakeArrayView(&MeshData, 1), Settings, LODMeshes);
+}
+
+void FModelGenStaticMeshConverter::ExtractSectionsFromProceduralMesh(const UProceduralMeshComponent* ProceduralMeshComponent, TArray<FModelGenMeshData>& OutSections)
+{
+    OutSections.Reset();
+
+    if (!ProceduralMeshComponent)
+    {
+        return;
+    }
+
+    const int32 NumSections = ProceduralMeshComponent->GetNumSections();
+    OutSections.SetNum(NumSections);
+
+    for (int32 SectionIdx = 0; SectionIdx < NumSections; ++SectionIdx)
+    {
+        // GetProcMeshSection 未声明为 const
+        FProcMeshSection* SectionData = const_cast<UProceduralMeshComponent*>(ProceduralMeshComponent)->GetProcMeshSection(SectionIdx);
+        if (!SectionData)
+        {
+            continue;
+        }
+
+        FModelGenMeshData& Section = OutSections[SectionIdx];
+        const int32 NumVertices = SectionData->ProcVertexBuffer.Num();
+
+        Section.Vertices.Reserve(NumVertices);
+        Section.Normals.Reserve(NumVertices);
+        Section.UVs.Reserve(NumVertices);
+        Section.VertexColors.Reserve(NumVertices);
+        Section.Tangents.Reserve(NumVertices);
+
+        for (const FProcMeshVertex& ProcVertex : SectionData->ProcVertexBuffer)
+        {
+            Section.Vertices.Add(ProcVertex.Position);
+            Section.Normals.Add(ProcVertex.Normal);
+            Section.UVs.Add(ProcVertex.UV0);
+            Section.VertexColors.Add(FLinearColor(ProcVertex.Color));
+            Section.Tangents.Add(ProcVertex.Tangent);
+        }
+
+        Section.Triangles.Reserve(SectionData->ProcIndexBuffer.Num());
+        for (uint32 Index : SectionData->ProcIndexBuffer)
+        {
+            Section.Triangles.Add(static_cast<int32>(Index));
+        }
+
+        Section.VertexCount = Section.Vertices.Num();
+        Section.TriangleCount = Section.Triangles.Num() / 3;
+    }
+}
+
+UStaticMesh* FModelGenStaticMeshConverter::CreateStaticMeshObject(int32 NumSections, const FModelGenStaticMeshSettings& Settings)
+{
+    UStaticMesh* StaticMesh = NewObject<UStaticMesh>(
+        GetTransientPackage(), NAME_None, RF_Public | RF_Transient);
+
+    if (!StaticMesh)
+    {
+        return nullptr;
+    }
+
+    StaticMesh->SetFlags(RF_Public | RF_Transient);
+    StaticMesh->NeverStream = true;
+    StaticMesh->LightMapResolution = 64;
+    StaticMesh->LightMapCoordinateIndex = 0;
+    StaticMesh->LightmapUVDensity = 512.0f;
+    StaticMesh->LODForCollision = 0;
+    StaticMesh->bAllowCPUAccess = true;
+    StaticMesh->bIsBuiltAtRuntime = true;
+    StaticMesh->bGenerateMeshDistanceField = false;
+    StaticMesh->bHasNavigationData = false;
+    StaticMesh->bSupportPhysicalMaterialMasks = false;
+    StaticMesh->bSupportUniformlyDistributedSampling = false;
+    StaticMesh->LpvBiasMultiplier = 1.0f;
+
+    for (int32 SectionIdx = 0; SectionIdx < NumSections; ++SectionIdx)
+    {
+        UMaterialInterface* SectionMaterial = Settings.SectionMaterials.IsValidIndex(SectionIdx) ? Settings.SectionMaterials[SectionIdx] : nullptr;
+        FName MaterialSlotName = FName(*FString::Printf(TEXT("MaterialSlot_%d"), SectionIdx));
+        FStaticMaterial NewStaticMaterial(SectionMaterial, MaterialSlotName);
+        NewStaticMaterial.UVChannelData = FMeshUVChannelInfo(1024.f);
+        StaticMesh->StaticMaterials.Add(NewStaticMaterial);
+    }
+
+    return StaticMesh;
+}
+
+bool FModelGenStaticMeshConverter::BuildMeshDescription(TArrayView<const FModelGenMeshData> Sections, FMeshDescription& OutMeshDescription, UStaticMesh* StaticMesh)
+{
+    MODELGEN_STAGE_SCOPE(BuildMeshDescription);
+
+    FStaticMeshAttributes Attributes(OutMeshDescription);
+    Attributes.Register();
+
+    TPolygonGroupAttributesRef<FName> PolygonGroupMaterialSlotNames =
+        Attributes.GetPolygonGroupMaterialSlotNames();
+
+    int32 TotalVertices = 0;
+    int32 TotalTriangles = 0;
+    for (const FModelGenMeshData& Section : Sections)
+    {
+        TotalVertices += Section.Vertices.Num();
+        TotalTriangles += Section.Triangles.Num() / 3;
+    }
+
+    OutMeshDescription.ReserveNewVertices(TotalVertices);
+    OutMeshDescription.ReserveNewVertexInstances(TotalVertices);
+    OutMeshDescription.ReserveNewTriangles(TotalTriangles);
+    OutMeshDescription.ReserveNewPolygons(TotalTriangles);
+    OutMeshDescription.ReserveNewEdges(TotalTriangles * 3 / 2);
+    OutMeshDescription.ReserveNewPolygonGroups(Sections.Num());
+
+    FMeshDescriptionBuilder MeshDescBuilder;
+    MeshDescBuilder.SetMeshDescription(&OutMeshDescription);
+    MeshDescBuilder.EnablePolyGroups();
+    MeshDescBuilder.SetNumUVLayers(2);
+
+    // 生成器的顶点已按位置/法线/UV 焊接，这里只按位置合并出 MeshDescription 的顶点，每个生成器顶点对应一个顶点实例
+    TMap<FPositionWeldKey, FVertexID> VertexMap;
+    VertexMap.Reserve(TotalVertices);
+
+    TArray<FVertexInstanceID> VertexInstanceIDs;
+
+    for (int32 SectionIdx = 0; SectionIdx < Sections.Num(); ++SectionIdx)
+    {
+        const FModelGenMeshData& Section = Sections[SectionIdx];
+        const int32 NumVertices = Section.Vertices.Num();
+        if (NumVertices < 3 || Section.Triangles.Num() < 3)
+        {
+            continue;
+        }
+
+        // 外部拼装的数据可能没有切线，在副本上补算；生成器输出的切线直接沿用
+        const FModelGenMeshData* SourceData = &Section;
+        FModelGenMeshData SectionWithTangents;
+        if (Section.Tangents.Num() != NumVertices)
+        {
+            SectionWithTangents = Section;
+            SectionWithTangents.CalculateTangents();
+            SourceData = &SectionWithTangents;
+        }
+
+        const bool bHasNormals = SourceData->Normals.Num() == NumVertices;
+        const bool bHasUVs = SourceData->UVs.Num() == NumVertices;
+        const bool bHasColors = SourceData->VertexColors.Num() == NumVertices;
+        const bool bHasTangents = SourceData->Tangents.Num() == NumVertices;
+
+        FName MaterialSlotName = StaticMesh->StaticMaterials[SectionIdx].MaterialSlotName;
+        const FPolygonGroupID PolygonGroup = MeshDescBuilder.AppendPolygonGroup();
+        PolygonGroupMaterialSlotNames.Set(PolygonGroup, MaterialSlotName);
+
+        VertexInstanceIDs.Reset(NumVertices);
+
+        for (int32 VertIdx = 0; VertIdx < NumVertices; ++VertIdx)
+        {
+            const FVector& Position = SourceData->Vertices[VertIdx];
+            const FPositionWeldKey WeldKey(Position);
+
+            FVertexID VertexID;
+            if (const FVertexID* FoundID = VertexMap.FindByHash(WeldKey.Hash, WeldKey))
+            {
+                VertexID = *FoundID;
+            }
+            else
+            {
+                VertexID = MeshDescBuilder.AppendVertex(Position);
+                VertexMap.AddByHash(WeldKey.Hash, WeldKey, VertexID);
+            }
+
+            const FVector Normal = bHasNormals ? SourceData->Normals[VertIdx] : FVector::ZeroVector;
+            const FVector2D UV = bHasUVs ? SourceData->UVs[VertIdx] : FVector2D::ZeroVector;
+            const FLinearColor Color = bHasColors ? SourceData->VertexColors[VertIdx] : FLinearColor::White;
+
+            FVertexInstanceID InstanceID = MeshDescBuilder.AppendInstance(VertexID);
+            MeshDescBuilder.SetInstanceUV(InstanceID, UV, 0);
+            MeshDescBuilder.SetInstanceUV(InstanceID, UV, 1);
+            MeshDescBuilder.SetInstanceColor(InstanceID, FVector4(Color));
+
+            if (bHasTangents)
+            {
+                const FProcMeshTangent& Tangent = SourceData->Tangents[VertIdx];
+                MeshDescBuilder.SetInstanceTangentSpace(InstanceID, Normal, Tangent.TangentX, Tangent.bFlipTangentY);
+            }
+            else
+            {
+                MeshDescBuilder.SetInstanceTangentSpace(InstanceID, Normal, SourceData->CalculateTangent(Normal), false);
+            }
+
+            VertexInstanceIDs.Add(InstanceID);
+        }
+
+        for (int32 i = 0; i + 2 < SourceData->Triangles.Num(); i += 3)
+        {
+            const int32 Index1 = SourceData->Triangles[i + 0];
+            const int32 Index2 = SourceData->Triangles[i + 1];
+            const int32 Index3 = SourceData->Triangles[i + 2];
+
+            if (!VertexInstanceIDs.IsValidIndex(Index1) ||
+                !VertexInstanceIDs.IsValidIndex(Index2) ||
+                !VertexInstanceIDs.IsValidIndex(Index3))
+            {
+                continue;
+            }
+
+            MeshDescBuilder.AppendTriangle(VertexInstanceIDs[Index1], VertexInstanceIDs[Index2], VertexInstanceIDs[Index3], PolygonGroup);
+        }
+    }
+
+    return OutMeshDescription.Vertices().Num() > 0;
+}
+
+bool FModelGenStaticMeshConverter::BuildStaticMeshGeometry(TArrayView<const FModelGenMeshData> Sections, TArrayView<const FModelGenMeshData> LODMeshes, UStaticMesh* StaticMesh)
+{
+    if (!StaticMesh)
+    {
+        return false;
+    }
+
+    const int32 NumLODs = FMath::Min(1 + LODMeshes.Num(), MAX_STATIC_MESH_LODS);
+
+    TArray<FMeshDescription> MeshDescriptions;
+    MeshDescriptions.SetNum(NumLODs);
+
+    if (!BuildMeshDescription(Sections, MeshDescriptions[0], StaticMesh))
+    {
+        return false;
+    }
+
+    TArray<const FMeshDescription*> MeshDescPtrs;
+    MeshDescPtrs.Emplace(&MeshDescriptions[0]);
+
+    // 某级 LOD 构建失败时丢弃它及之后的各级，已有的各级仍然可用
+    for (int32 LODIndex = 1; LODIndex < NumLODs; ++LODIndex)
+    {
+        if (!BuildMeshDescription(MakeArrayView(&LODMeshes[LODIndex - 1], 1), MeshDescriptions[LODIndex], StaticMesh))
+        {
+            break;
+        }
+        MeshDescPtrs.Emplace(&MeshDescriptions[LODIndex]);
+    }
+
+    UStaticMesh::FBuildMeshDescriptionsParams BuildParams;
+    BuildParams.bUseHashAsGuid = true;
+    BuildParams.bMarkPackageDirty = true;
+    BuildParams.bBuildSimpleCollision = false;
+    BuildParams.bCommitMeshDescription = true;
+
+    {
+        MODELGEN_STAGE_SCOPE(BuildStaticMesh);
+        StaticMesh->BuildFromMeshDescriptions(MeshDescPtrs, BuildParams);
+    }
+
+    return true;
+}
+
+bool FModelGenStaticMeshConverter::InitializeStaticMeshRenderData(UStaticMesh* StaticMesh)
+{
+    if (!StaticMesh || !StaticMesh->RenderData || StaticMesh->RenderData->LODResources.Num() < 1)
+    {
+        return false;
+    }
+
+    StaticMesh->NeverStream = true;
+    StaticMesh->bIgnoreStreamingMipBias = true;
+    StaticMesh->LightMapCoordinateIndex = 0;
+
+    SetupLODScreenSizes(StaticMesh);
+
+    StaticMesh->CalculateExtendedBounds();
+    if (StaticMesh->ExtendedBounds.SphereRadius < 10.0f)
+    {
+        StaticMesh->ExtendedBounds = FBoxSphereBounds(FVector::ZeroVector, FVector(500.0f), 1000.0f);
+        if (StaticMesh->RenderData) StaticMesh->RenderData->Bounds = StaticMesh->ExtendedBounds;
+    }
+
+    const float ForcedUVDensity = 1024.0f;
+    for (FStaticMaterial& Mat : StaticMesh->StaticMaterials)
+    {
+        Mat.UVChannelData.LocalUVDensities[0] = ForcedUVDensity;
+        Mat.UVChannelData.LocalUVDensities[1] = ForcedUVDensity;
+        Mat.UVChannelData.LocalUVDensities[2] = ForcedUVDensity;
+        Mat.UVChannelData.LocalUVDensities[3] = ForcedUVDensity;
+    }
+
+    for (FStaticMeshLODResources& LODResources : StaticMesh->RenderData->LODResources)
+    {
+        LODResources.bHasColorVertexData = true;
+    }
+
+    StaticMesh->InitResources();
+
+    StaticMesh->bForceMiplevelsToBeResident = true;
+    StaticMesh->SetForceMipLevelsToBeResident(30.0f, 0);
+
+    return true;
+}
+
+void FModelGenStaticMeshConverter::SetupLODScreenSizes(UStaticMesh* StaticMesh)
+{
+    FStaticMeshRenderData* RenderData = StaticMesh->RenderData.Get();
+    const int32 NumLODs = RenderData->LODResources.Num();
+
+    for (int32 LODIndex = 0; LODIndex < MAX_STATIC_MESH_LODS; ++LODIndex)
+    {
+        RenderData->ScreenSize[LODIndex].Default = 0.0f;
+    }
+
+    if (NumLODs < 2)
+    {
+        return;
+    }
+
+    // 切换点按三角形比例的平方根下降：细分减半、三角形约为四分之一时，切换的屏幕尺寸也减半
+    const float BaseTriangles = FMath::Max<float>(RenderData->LODResources[0].GetNumTriangles(), 1.0f);
+    RenderData->ScreenSize[0].Default = 1.0f;
+
+    for (int32 LODIndex = 1; LODIndex < NumLODs; ++LODIndex)
+    {
+        const float TriangleRatio = RenderData->LODResources[LODIndex].GetNumTriangles() / BaseTriangles;
+        const float ScreenSize = FMath::Sqrt(TriangleRatio);
+        RenderData->ScreenSize[LODIndex].Default = FMath::Min(ScreenSize, RenderData->ScreenSize[LODIndex - 1].Default * 0.75f);
+    }
+}
+
+void FModelGenStaticMeshConverter::SetupBodySetupProperties(UBodySetup* BodySetup, const FModelGenStaticMeshSettings& Settings)
+{
+    if (!BodySetup)
+    {
+        return;
+    }
+
+    // 有解析简单碰撞时物理模拟用它，复杂查询仍走三角网格；只有凸分解结果时沿用三角网格兼作简单碰撞
+    const bool bHasAnalyticCollision = Settings.bGenerateSimpleCollision && Settings.SimpleCollision.GetElementCount() > 0;
+    if (bHasAnalyticCollision)
+    {
+        BodySetup->CollisionTraceFlag = Settings.bGenerateComplexCollision ? CTF_UseDefault : CTF_UseSimpleAsComplex;
+    }
+    else
+    {
+        BodySetup->CollisionTraceFlag = CTF_UseComplexAsSimple;
+    }
+    BodySetup->bDoubleSidedGeometry = false;
+    BodySetup->bMeshCollideAll = true;
+
+    if (Settings.PhysMaterial)
+    {
+        BodySetup->PhysMaterial = Settings.PhysMaterial;
+    }
+
+    BodySetup->DefaultInstance.SetCollisionProfileName(TEXT("BlockAll"));
+    BodySetup->DefaultInstance.SetEnableGravity(false);
+    BodySetup->DefaultInstance.bUseCCD = false;
+}
+
+void FModelGenStaticMeshConverter::BuildDecompMeshData(TArrayView<const FModelGenMeshData> Sections, FMeshData& OutMeshData)
+{
+    OutMeshData.Vertices.Reset();
+    OutMeshData.Indices.Reset();
+
+    for (const FModelGenMeshData& Section : Sections)
+    {
+        const int32 FirstVertexIndex = OutMeshData.Vertices.Num();
+        OutMeshData.Vertices.Append(Section.Vertices);
+
+        for (int32 Index : Section.Triangles)
+        {
+            OutMeshData.Indices.Add(FirstVertexIndex + Index);
+        }
+    }
+}
+
+bool FModelGenStaticMeshConverter::AddBoundsBoxElem(const FBox& Bounds, FKAggregateGeom& OutGeom)
+{
+    if (!Bounds.IsValid)
+    {
+        return false;
+    }
+
+    const FVector Extent = Bounds.GetExtent();
+    if (Extent.X <= 0.0f || Extent.Y <= 0.0f || Extent.Z <= 0.0f)
+    {
+        return false;
+    }
+
+    FKBoxElem BoxElem;
+    BoxElem.Center = Bounds.GetCenter();
+    BoxElem.X = Extent.X * 2.0f;
+    BoxElem.Y = Extent.Y * 2.0f;
+    BoxElem.Z = Extent.Z * 2.0f;
+    OutGeom.BoxElems.Add(BoxElem);
+    return true;
+}
+
+bool FModelGenStaticMeshConverter::GenerateSimpleCollision(const FMeshData& DecompMeshData, const FModelGenStaticMeshSettings& Settings, FKAggregateGeom& OutGeom)
+{
+    if (Settings.SimpleCollision.GetElementCount() > 0)
+    {
+        OutGeom = Settings.SimpleCollision;
+        return true;
+    }
+
+    MODELGEN_STAGE_SCOPE(ConvexDecomposition);
+
+    const int32 HullCount = 8;
+    const int32 MaxHullVerts = 16;
+    const uint32 HullPrecision = 100000;
+
+    const bool bSuccess = FModelGenConvexDecomp::GenerateConvexHulls(
+        DecompMeshData,
+        OutGeom,
+        HullCount,
+        MaxHullVerts,
+        HullPrecision);
+
+    if (bSuccess && OutGeom.ConvexElems.Num() > 0)
+    {
+        return true;
+    }
+
+    return AddBoundsBoxElem(FBox(DecompMeshData.Vertices), OutGeom);
+}
+
+void FModelGenStaticMeshConverter::CookConvexElems(TArray<FKConvexElem>& ConvexElems, IPhysXCooking* PhysXCooking, TArray<physx::PxConvexMesh*>& OutConvexMeshes)
+{
+    OutConvexMeshes.Reset();
+    OutConvexMeshes.AddZeroed(ConvexElems.Num());
+
+    if (!PhysXCooking)
+    {
+        return;
+    }
+
+    for (int32 ElemIdx = 0; ElemIdx < ConvexElems.Num(); ++ElemIdx)
+    {
+        FKConvexElem& ConvexElem = ConvexElems[ElemIdx];
+        if (ConvexElem.VertexData.Num() < 4)
+        {
+            continue;
+        }
+
+        bool bHasValidVertices = true;
+        for (const FVector& Vert : ConvexElem.VertexData)
+        {
+            if (Vert.ContainsNaN() ||
+                !FMath::IsFinite(Vert.X) ||
+                !FMath::IsFinite(Vert.Y) ||
+                !FMath::IsFinite(Vert.Z))
+            {
+                bHasValidVertices = false;
+                break;
+            }
+        }
+
+        if (!bHasValidVertices)
+        {
+            continue;
+        }
+
+        // 确保 ElemBox 有效，且顶点已处于 Identity 变换下
+        ConvexElem.UpdateElemBox();
+        if (!ConvexElem.GetTransform().IsValid())
+        {
+            ConvexElem.SetTransform(FTransform::Identity);
+        }
+        ConvexElem.BakeTransformToVerts();
+
+        // 相同顶点的凸包（同一形状参数、重复生成）直接复用已烘焙的网格
+        OutConvexMeshes[ElemIdx] = FModelGenCollisionCookCache::Get().FindOrCookConvex(
+            PhysXCooking,
+            FName(FPlatformProperties::GetPhysicsFormat()),
+            EPhysXMeshCookFlags::Default,
+            ConvexElem.VertexData);
+    }
+}
+
+int32 FModelGenStaticMeshConverter::CreateConvexMeshesManually(UBodySetup* BodySetup, IPhysXCookingModule* PhysXCookingModule)
+{
+    if (!BodySetup || !PhysXCookingModule || !PhysXCookingModule->GetPhysXCooking())
+    {
+        return 0;
+    }
+
+    if (BodySetup->AggGeom.GetElementCount() == 0)
+    {
+        return 0;
+    }
+
+    BodySetup->bNeverNeedsCookedCollisionData = false;
+    BodySetup->InvalidatePhysicsData();
+
+    TArray<physx::PxConvexMesh*> ConvexMeshes;
+    CookConvexElems(BodySetup->AggGeom.ConvexElems, PhysXCookingModule->GetPhysXCooking(), ConvexMeshes);
+
+    int32 ValidConvexMeshCount = 0;
+    for (int32 ElemIdx = 0; ElemIdx < ConvexMeshes.Num(); ++ElemIdx)
+    {
+        if (ConvexMeshes[ElemIdx])
+        {
+            BodySetup->AggGeom.ConvexElems[ElemIdx].SetConvexMesh(ConvexMeshes[ElemIdx]);
+            ValidConvexMeshCount++;
+        }
+    }
+
+    BodySetup->bCreatedPhysicsMeshes = true;
+
+    return ValidConvexMeshCount;
+}
+
+physx::PxTriangleMesh* FModelGenStaticMeshConverter::CookTriMesh(IPhysXCooking* PhysXCooking, EPhysXMeshCookFlags CookFlags, TArray<FVector>& Vertices, TArray<FTriIndices>& Indices)
+{
+    if (!PhysXCooking || Vertices.Num() == 0 || Indices.Num() == 0)
+    {
+        return nullptr;
+    }
+
+    WeldTriMeshVertices(Vertices, Indices);
+
+    TArray<uint16> MaterialIndices;
+    MaterialIndices.AddZeroed(Indices.Num());
+
+    return FModelGenCollisionCookCache::Get().FindOrCookTriMesh(
+        PhysXCooking,
+        FName(FPlatformProperties::GetPhysicsFormat()),
+        CookFlags,
+        Vertices,
+        Indices,
+        MaterialIndices,
+        true);
+}
+
+bool FModelGenStaticMeshConverter::ExtractTriMeshData(TArrayView<const FModelGenMeshData> Sections, TArray<FVector>& OutVertices, TArray<FTriIndices>& OutIndices)
+{
+    OutVertices.Reset();
+    OutIndices.Reset();
+
+    for (const FModelGenMeshData& Section : Sections)
+    {
+        const int32 SectionVertexOffset = OutVertices.Num();
+        const int32 SectionVertexCount = Section.Vertices.Num();
+        const int32 NumSectionIndices = Section.Triangles.Num();
+
+        OutVertices.Append(Section.Vertices);
+
+        if (NumSectionIndices % 3 != 0 || SectionVertexCount == 0)
+        {
+            continue;
+        }
+
+        for (int32 Idx = 0; Idx + 2 < NumSectionIndices; Idx += 3)
+        {
+            const int32 LocalV0 = Section.Triangles[Idx];
+            const int32 LocalV1 = Section.Triangles[Idx + 1];
+            const int32 LocalV2 = Section.Triangles[Idx + 2];
+
+            if (LocalV0 < 0 || LocalV0 >= SectionVertexCount ||
+                LocalV1 < 0 || LocalV1 >= SectionVertexCount ||
+                LocalV2 < 0 || LocalV2 >= SectionVertexCount)
+            {
+                continue;
+            }
+
+            FTriIndices Tri;
+            Tri.v0 = SectionVertexOffset + LocalV0;
+            Tri.v1 = SectionVertexOffset + LocalV1;
+            Tri.v2 = SectionVertexOffset + LocalV2;
+            OutIndices.Add(Tri);
+        }
+    }
+
+    return OutVertices.Num() > 0 && OutIndices.Num() > 0;
+}
+
+// 从 RenderData 提取 TriMesh 数据，网格数据不可用时的后备
+bool FModelGenStaticMeshConverter::ExtractTriMeshDataFromRenderData(UStaticMesh* StaticMesh, TArray<FVector>& OutVertices, TArray<FTriIndices>& OutIndices)
+{
+    if (!StaticMesh || !StaticMesh->RenderData || StaticMesh->RenderData->LODResources.Num() == 0)
+    {
+        return false;
+    }
+
+    OutVertices.Reset();
+    OutIndices.Reset();
+
+    const FStaticMeshLODResources& LODResource = StaticMesh->RenderData->LODResources[0];
+    const FPositionVertexBuffer& PositionVertexBuffer = LODResource.VertexBuffers.PositionVertexBuffer;
+    const FRawStaticIndexBuffer& IndexBuffer = LODResource.IndexBuffer;
+
+    const int32 NumVertices = PositionVertexBuffer.GetNumVertices();
+    if (NumVertices == 0)
+    {
+        return false;
+    }
+
+    OutVertices.Reserve(NumVertices);
+    for (int32 VertIdx = 0; VertIdx < NumVertices; ++VertIdx)
+    {
+        OutVertices.Add(PositionVertexBuffer.VertexPosition(VertIdx));
+    }
+
+    const int32 NumIndices = IndexBuffer.GetNumIndices();
+    if (NumIndices == 0 || NumIndices % 3 != 0)
+    {
+        return false;
+    }
+
+    OutIndices.Reserve(NumIndices / 3);
+    for (int32 Idx = 0; Idx + 2 < NumIndices; Idx += 3)
+    {
+        const uint32 V0 = IndexBuffer.GetIndex(Idx);
+        const uint32 V1 = IndexBuffer.GetIndex(Idx + 1);
+        const uint32 V2 = IndexBuffer.GetIndex(Idx + 2);
+
+        if (V0 >= static_cast<uint32>(NumVertices) ||
+            V1 >= static_cast<uint32>(NumVertices) ||
+            V2 >= static_cast<uint32>(NumVertices))
+        {
+            continue;
+        }
+
+        FTriIndices Tri;
+        Tri.v0 = V0;
+        Tri.v1 = V1;
+        Tri.v2 = V2;
+        OutIndices.Add(Tri);
+    }
+
+    return OutIndices.Num() > 0;
+}
+
+void FModelGenStaticMeshConverter::SetupBodySetupAndCollision(TArrayView<const FModelGenMeshData> Sections, UStaticMesh* StaticMesh, const FModelGenStaticMeshSettings& Settings)
+{
+    if (!StaticMesh)
+    {
+        return;
+    }
+
+    StaticMesh->CreateBodySetup();
+    UBodySetup* NewBodySetup = StaticMesh->BodySetup;
+    if (!NewBodySetup)
+    {
+        return;
+    }
+
+    SetupBodySetupProperties(NewBodySetup, Settings);
+
+    FMeshData DecompMeshData;
+    if (Settings.bGenerateSimpleCollision && Settings.SimpleCollision.GetElementCount() == 0)
+    {
+        BuildDecompMeshData(Sections, DecompMeshData);
+    }
+
+    TArray<FVector> NewVertices;
+    TArray<FTriIndices> NewIndices;
+    if (Settings.bGenerateComplexCollision && !ExtractTriMeshData(Sections, NewVertices, NewIndices))
+    {
+        ExtractTriMeshDataFromRenderData(StaticMesh, NewVertices, NewIndices);
+    }
+
+    EPhysXMeshCookFlags TriMeshCookFlags = EPhysXMeshCookFlags::Default;
+    if (UPhysicsSettings::Get()->bSuppressFaceRemapTable)
+    {
+        TriMeshCookFlags |= EPhysXMeshCookFlags::SuppressFaceRemapTable;
+    }
+
+    IPhysXCookingModule* PhysXCookingModule = GetPhysXCookingModule();
+    IPhysXCooking* PhysXCooking = PhysXCookingModule ? PhysXCookingModule->GetPhysXCooking() : nullptr;
+
+    if (Settings.bAsyncCollision && PhysXCooking)
+    {
+        LaunchAsyncCollision(StaticMesh, PhysXCooking, TriMeshCookFlags, MoveTemp(DecompMeshData), MoveTemp(NewVertices), MoveTemp(NewIndices), Settings);
+        return;
+    }
+
+    if (Settings.bGenerateSimpleCollision)
+    {
+        GenerateSimpleCollision(DecompMeshData, Settings, NewBodySetup->AggGeom);
+    }
+
+    MODELGEN_STAGE_SCOPE(CollisionCooking);
+
+    if (NewBodySetup->AggGeom.GetElementCount() > 0)
+    {
+        CreateConvexMeshesManually(NewBodySetup, PhysXCookingModule);
+    }
+
+    if (physx::PxTriangleMesh* TriMesh = CookTriMesh(PhysXCooking, TriMeshCookFlags, NewVertices, NewIndices))
+    {
+        NewBodySetup->TriMeshes.Add(TriMesh);
+        NewBodySetup->bCreatedPhysicsMeshes = true;
+    }
+}
+
+void FModelGenStaticMeshConverter::LaunchAsyncCollision(
+    UStaticMesh* StaticMesh,
+    IPhysXCooking* PhysXCooking,
+    EPhysXMeshCookFlags TriMeshCookFlags,
+    FMeshData&& DecompMeshData,
+    TArray<FVector>&& TriVertices,
+    TArray<FTriIndices>&& TriIndices,
+    const FModelGenStaticMeshSettings& Settings)
+{
+    UBodySetup* PlaceholderBodySetup = StaticMesh->BodySetup;
+
+    // 烘焙完成前先用包围盒顶替；盒子无需烘焙，查询也要走简单碰撞才能生效
+    const ECollisionTraceFlag FinalTraceFlag = PlaceholderBodySetup->CollisionTraceFlag;
+    PlaceholderBodySetup->CollisionTraceFlag = CTF_UseSimpleAsComplex;
+    AddBoundsBoxElem(StaticMesh->GetBoundingBox(), PlaceholderBodySetup->AggGeom);
+    PlaceholderBodySetup->bCreatedPhysicsMeshes = true;
+
+    // 后台只用到设置中的非 UObject 字段
+    TWeakObjectPtr<UStaticMesh> WeakMesh(StaticMesh);
+    AsyncTask(ENamedThreads::AnyBackgroundThreadNormalTask,
+        [WeakMesh, PhysXCooking, TriMeshCookFlags, FinalTraceFlag, Settings,
+        DecompMeshData = MoveTemp(DecompMeshData), TriVertices = MoveTemp(TriVertices), TriIndices = MoveTemp(TriIndices)]() mutable
+        {
+            FKAggregateGeom Geom;
+            if (Settings.bGenerateSimpleCollision)
+            {
+                GenerateSimpleCollision(DecompMeshData, Settings, Geom);
+            }
+
+            TArray<physx::PxConvexMesh*> ConvexMeshes;
+            physx::PxTriangleMesh* TriMesh = nullptr;
+            {
+                MODELGEN_STAGE_SCOPE(CollisionCooking);
+                CookConvexElems(Geom.ConvexElems, PhysXCooking, ConvexMeshes);
+                TriMesh = CookTriMesh(PhysXCooking, TriMeshCookFlags, TriVertices, TriIndices);
+            }
+
+            AsyncTask(ENamedThreads::GameThread,
+                [WeakMesh, FinalTraceFlag, OnReady = Settings.OnAsyncCollisionReady, Geom = MoveTemp(Geom), ConvexMeshes = MoveTemp(ConvexMeshes), TriMesh]()
+                {
+                    UStaticMesh* Mesh = WeakMesh.Get();
+                    if (!Mesh)
+                    {
+                        // 网格已被回收，放掉烘焙时为这里增加的引用
+                        for (physx::PxConvexMesh* ConvexMesh : ConvexMeshes)
+                        {
+                            if (ConvexMesh)
+                            {
+                                ConvexMesh->release();
+                            }
+                        }
+                        if (TriMesh)
+                        {
+                            TriMesh->release();
+                        }
+                        return;
+                    }
+
+                    FinishAsyncCollision(Mesh, FinalTraceFlag, Geom, ConvexMeshes, TriMesh);
+
+                    if (OnReady)
+                    {
+                        OnReady(Mesh);
+                    }
+                });
+        });
+}
+
+void FModelGenStaticMeshConverter::FinishAsyncCollision(
+    UStaticMesh* StaticMesh,
+    ECollisionTraceFlag TraceFlag,
+    const FKAggregateGeom& Geom,
+    const TArray<physx::PxConvexMesh*>& ConvexMeshes,
+    physx::PxTriangleMesh* TriMesh)
+{
+    check(IsInGameThread());
+
+    // 新建 BodySetup 一次性替换，使用方在回调中重建物理状态前旧碰撞保持可用
+    UBodySetup* NewBodySetup = NewObject<UBodySetup>(StaticMesh, NAME_None, RF_Transactional);
+    if (StaticMesh->BodySetup)
+    {
+        NewBodySetup->CopyBodyPropertiesFrom(StaticMesh->BodySetup);
+    }
+
+    NewBodySetup->CollisionTraceFlag = TraceFlag;
+    NewBodySetup->AggGeom = Geom;
+    NewBodySetup->bNeverNeedsCookedCollisionData = false;
+
+    for (int32 ElemIdx = 0; ElemIdx < ConvexMeshes.Num() && ElemIdx < NewBodySetup->AggGeom.ConvexElems.Num(); ++ElemIdx)
+    {
+        if (ConvexMeshes[ElemIdx])
+        {
+            NewBodySetup->AggGeom.ConvexElems[ElemIdx].SetConvexMesh(ConvexMeshes[ElemIdx]);
+        }
+    }
+
+    if (TriMesh)
+    {
+        NewBodySetup->TriMeshes.Add(TriMesh);
+    }
+
+    NewBodySetup->bCreatedPhysicsMeshes = true;
+
+    StaticMesh->BodySetup = NewBodySetup;
+    StaticMesh->CreateNavCollision(true);
+}
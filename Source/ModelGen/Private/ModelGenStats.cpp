@@ -0,0 +1,109 @@
+// Copyright (c) 2024. All rights reserved.
+
+#include "ModelGenStats.h"
+#include "ModelGenMeshData.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/ScopeLock.h"
+
+DEFINE_STAT(STAT_ModelGen_Generate);
+DEFINE_STAT(STAT_ModelGen_CalculateTangents);
+DEFINE_STAT(STAT_ModelGen_ToProceduralMesh);
+DEFINE_STAT(STAT_ModelGen_BuildMeshDescription);
+DEFINE_STAT(STAT_ModelGen_BuildStaticMesh);
+DEFINE_STAT(STAT_ModelGen_ConvexDecomposition);
+DEFINE_STAT(STAT_ModelGen_CollisionCooking);
+
+DEFINE_STAT(STAT_ModelGen_GeneratedVertices);
+DEFINE_STAT(STAT_ModelGen_GeneratedTriangles);
+
+DEFINE_STAT(STAT_ModelGen_GeneratedMeshDataMemory);
+DEFINE_STAT(STAT_ModelGen_UploadedMeshMemory);
+DEFINE_STAT(STAT_ModelGen_StaticMeshCacheMemory);
+
+UE_TRACE_CHANNEL_DEFINE(ModelGenChannel);
+
+namespace ModelGenStats
+{
+    static FCriticalSection& GetLock()
+    {
+        static FCriticalSection Lock;
+        return Lock;
+    }
+
+    static FModelGenGenerationStats& GetLastStats()
+    {
+        static FModelGenGenerationStats Stats;
+        return Stats;
+    }
+}
+
+void FModelGenStageRecorder::RecordStage(EModelGenStage Stage, double Seconds)
+{
+    const float Milliseconds = static_cast<float>(Seconds * 1000.0);
+
+    FScopeLock ScopeLock(&ModelGenStats::GetLock());
+    FModelGenGenerationStats& Stats = ModelGenStats::GetLastStats();
+
+    switch (Stage)
+    {
+    case EModelGenStage::Generate:             Stats.GenerateMs = Milliseconds; break;
+    case EModelGenStage::CalculateTangents:    Stats.CalculateTangentsMs = Milliseconds; break;
+    case EModelGenStage::ToProceduralMesh:     Stats.ToProceduralMeshMs = Milliseconds; break;
+    case EModelGenStage::BuildMeshDescription: Stats.BuildMeshDescriptionMs = Milliseconds; break;
+    case EModelGenStage::BuildStaticMesh:      Stats.BuildStaticMeshMs = Milliseconds; break;
+    case EModelGenStage::ConvexDecomposition:  Stats.ConvexDecompositionMs = Milliseconds; break;
+    case EModelGenStage::CollisionCooking:     Stats.CollisionCookingMs = Milliseconds; break;
+    default: break;
+    }
+}
+
+void FModelGenStageRecorder::RecordMesh(const FModelGenMeshData& MeshData)
+{
+    const int32 NumVertices = MeshData.Vertices.Num();
+    const int32 NumTriangles = MeshData.Triangles.Num() / 3;
+    const int64 NumBytes = static_cast<int64>(MeshData.GetAllocatedSize());
+
+    INC_DWORD_STAT_BY(STAT_ModelGen_GeneratedVertices, NumVertices);
+    INC_DWORD_STAT_BY(STAT_ModelGen_GeneratedTriangles, NumTriangles);
+    SET_MEMORY_STAT(STAT_ModelGen_GeneratedMeshDataMemory, NumBytes);
+
+    FScopeLock ScopeLock(&ModelGenStats::GetLock());
+    FModelGenGenerationStats& Stats = ModelGenStats::GetLastStats();
+    Stats.VertexCount = NumVertices;
+    Stats.TriangleCount = NumTriangles;
+    Stats.MeshDataBytes = NumBytes;
+}
+
+FModelGenGenerationStats FModelGenStageRecorder::GetLastStats()
+{
+    FScopeLock ScopeLock(&ModelGenStats::GetLock());
+    return ModelGenStats::GetLastStats();
+}
+
+void FModelGenStageRecorder::Reset()
+{
+    FScopeLock ScopeLock(&ModelGenStats::GetLock());
+    ModelGenStats::GetLastStats() = FModelGenGenerationStats();
+}
+
+FModelGenStageScope::FModelGenStageScope(EModelGenStage InStage)
+    : Stage(InStage)
+    , StartTime(FPlatformTime::Seconds())
+{
+}
+
+FModelGenStageScope::~FModelGenStageScope()
+{
+    FModelGenStageRecorder::RecordStage(Stage, FPlatformTime::Seconds() - StartTime);
+}
+
+FModelGenGenerateScope::FModelGenGenerateScope(const FModelGenMeshData& InMeshData)
+    : FModelGenStageScope(EModelGenStage::Generate)
+    , MeshData(InMeshData)
+{
+}
+
+FModelGenGenerateScope::~FModelGenGenerateScope()
+{
+    FModelGenStageRecorder::RecordMesh(MeshData);
+}
@@ -7,15 +7,43 @@
 #include "HollowPrism.h"
 #include "PolygonTorus.h"
 #include "Engine/World.h"
+#include "ModelGen.h"
+#include "ModelGenStaticMeshCache.h"
+#include "ModelGenStaticMeshConverter.h"
+#include "ModelGenCollisionCookCache.h"
+#include "ModelGenDiskCache.h"
+#include "ModelGenShapeParams.h"
+#include "BevelCubeBuilder.h"
+#include "PyramidBuilder.h"
+#include "FrustumBuilder.h"
+#include "HollowPrismBuilder.h"
+#include "PolygonTorusBuilder.h"
+#include "UObject/UnrealType.h"
+#include "Async/ParallelFor.h"
+#include "HAL/PlatformTime.h"
 
+namespace
+{
+    template <typename TParams, typename TBuilder>
+    UCustomModelFactory::FModelBuilderFactory MakeBuilderFactory()
+    {
+        return [](const TMap<FString, FString>& Parameters, FModelGenParamsHash& OutParamsHash) -> TUniquePtr<FModelGenMeshBuilder>
+        {
+            TParams Params;
+            UCustomModelFactory::ApplyParameters(TParams::StaticStruct(), &Params, Parameters);
+            if (!Params.IsValid())
+            {
+                return nullptr;
+            }
+
+            OutParamsHash = FModelGenParamsHash::Compute(Params);
+            return MakeUnique<TBuilder>(Params);
+        };
+    }
+}
 
 TMap<FString, TSubclassOf<AActor>> UCustomModelFactory::ModelTypeRegistry;
-TMap<FString, UStaticMesh*> UCustomModelFactory::StaticMeshCache;
-int32 UCustomModelFactory::CacheHitCount = 0;
-int32 UCustomModelFactory::CacheMissCount = 0;
-FCriticalSection UCustomModelFactory::CacheLock;
-int32 UCustomModelFactory::CacheAccessCount = 0;
-const int32 UCustomModelFactory::AUTO_CLEANUP_INTERVAL = 50; // 每 50 次访问自动清理一次
+TMap<FString, UCustomModelFactory::FModelBuilderFactory> UCustomModelFactory::BuilderRegistry;
 
 AActor* UCustomModelFactory::CreateModelActorWithParams(const FString& ModelTypeName, const TMap<FString, FString>& Parameters, UWorld* World, const FVector& Location, const FRotator& Rotation)
 {
@@ -66,6 +94,11 @@ void UCustomModelFactory::RegisterModelType(const FString& ModelTypeName, TSubcl
     ModelTypeRegistry.Add(ModelTypeName, ModelClass);
 }
 
+void UCustomModelFactory::RegisterBuilderType(const FString& ModelTypeName, FModelBuilderFactory BuilderFactory)
+{
+    BuilderRegistry.Add(ModelTypeName, MoveTemp(BuilderFactory));
+}
+
 void UCustomModelFactory::InitializeDefaultModelTypes()
 {
     RegisterModelType(TEXT("BevelCube"), ABevelCube::StaticClass());
@@ -73,6 +106,60 @@ void UCustomModelFactory::InitializeDefaultModelTypes()
     RegisterModelType(TEXT("Frustum"), AFrustum::StaticClass());
     RegisterModelType(TEXT("HollowPrism"), AHollowPrism::StaticClass());
     RegisterModelType(TEXT("PolygonTorus"), APolygonTorus::StaticClass());
+
+    RegisterBuilderType(TEXT("BevelCube"), MakeBuilderFactory<FBevelCubeParams, FBevelCubeBuilder>());
+    RegisterBuilderType(TEXT("Pyramid"), MakeBuilderFactory<FPyramidParams, FPyramidBuilder>());
+    RegisterBuilderType(TEXT("Frustum"), MakeBuilderFactory<FFrustumParams, FFrustumBuilder>());
+    RegisterBuilderType(TEXT("HollowPrism"), MakeBuilderFactory<FHollowPrismParams, FHollowPrismBuilder>());
+    RegisterBuilderType(TEXT("PolygonTorus"), MakeBuilderFactory<FPolygonTorusParams, FPolygonTorusBuilder>());
+}
+
+TUniquePtr<FModelGenMeshBuilder> UCustomModelFactory::CreateBuilder(const FString& ModelTypeName, const TMap<FString, FString>& Parameters, FModelGenParamsHash& OutParamsHash)
+{
+    if (ModelTypeRegistry.Num() == 0)
+    {
+        InitializeDefaultModelTypes();
+    }
+
+    OutParamsHash = FModelGenParamsHash();
+
+    const FModelBuilderFactory* BuilderFactory = BuilderRegistry.Find(ModelTypeName);
+    if (!BuilderFactory)
+    {
+        return nullptr;
+    }
+
+    return (*BuilderFactory)(Parameters, OutParamsHash);
+}
+
+int32 UCustomModelFactory::ApplyParameters(const UScriptStruct* Struct, void* Data, const TMap<FString, FString>& Parameters)
+{
+    if (!Struct || !Data)
+    {
+        return 0;
+    }
+
+    int32 NumApplied = 0;
+    for (const TPair<FString, FString>& Parameter : Parameters)
+    {
+        // FName 比较不区分大小写
+        FProperty* Property = FindFProperty<FProperty>(Struct, *Parameter.Key);
+        if (!Property)
+        {
+            UE_LOG(LogModelGen, Warning, TEXT("Unknown parameter '%s' for %s"), *Parameter.Key, *Struct->GetName());
+            continue;
+        }
+
+        if (!Property->ImportText(*Parameter.Value, Property->ContainerPtrToValuePtr<void>(Data), PPF_None, nullptr))
+        {
+            UE_LOG(LogModelGen, Warning, TEXT("Invalid value '%s' for parameter '%s' of %s"), *Parameter.Value, *Parameter.Key, *Struct->GetName());
+            continue;
+        }
+
+        ++NumApplied;
+    }
+
+    return NumApplied;
 }
 
 
@@ -102,87 +189,133 @@ UStaticMesh* UCustomModelFactory::GetOrCreateStaticMesh(AProceduralMeshActor* Pr
         return nullptr;
     }
     
-    FString ModelType = ProceduralActor->GetClass()->GetName();
-    TMap<FString, FString> Parameters;
-    
-    FString CacheKey = GenerateCacheKey(ModelType, Parameters);
-    
-    bool bShouldCleanup = false;
+    // 与生成器路径共用同一个缓存：键由形状参数哈希与 Actor 的材质、LOD 设置共同得到，相同配置共用一个 StaticMesh
+    const FModelGenParamsHash ParamsHash = ProceduralActor->GetShapeParamsHash();
+    TUniquePtr<FModelGenMeshBuilder> Builder = ParamsHash.IsValid() ? ProceduralActor->CreateMeshBuilder() : nullptr;
+    if (!Builder)
     {
-        FScopeLock Lock(&CacheLock);
-        CacheAccessCount++;
-        if (CacheAccessCount >= AUTO_CLEANUP_INTERVAL)
-        {
-            CacheAccessCount = 0;
-            bShouldCleanup = true;
-        }
+        // 调用方（如 CreateModelStaticMeshFromActor）可能随即销毁 Actor，没有人能接收异步碰撞完成的通知
+        ProceduralActor->GenerateMesh();
+        return ProceduralActor->ConvertToStaticMesh(false);
     }
-    
-    if (bShouldCleanup)
+
+    FModelGenStaticMeshSettings Settings;
+    ProceduralActor->GetSharedStaticMeshSettings(Settings);
+    return FindOrCreateStaticMesh(ParamsHash, *Builder, Settings, ProceduralActor->StaticMeshLODCount);
+}
+
+UStaticMesh* UCustomModelFactory::CreateModelStaticMesh(const FString& ModelTypeName, const TMap<FString, FString>& Parameters, UWorld* World)
+{
+    if (ModelTypeRegistry.Num() == 0)
     {
-        CleanupInvalidCache();
+        InitializeDefaultModelTypes();
     }
-    
-    UStaticMesh* CachedMesh = nullptr;
+
+    if (!BuilderRegistry.Contains(ModelTypeName))
     {
-        FScopeLock Lock(&CacheLock);
-        if (UStaticMesh** FoundMesh = StaticMeshCache.Find(CacheKey))
-        {
-            CachedMesh = *FoundMesh;
-        }
+        return CreateModelStaticMeshFromActor(ModelTypeName, Parameters, World);
     }
-    
-    if (CachedMesh != nullptr)
+
+    // 参数 -> 生成器 -> 网格数据 -> StaticMesh，全程不创建 Actor 与组件
+    FModelGenParamsHash CacheKey;
+    TUniquePtr<FModelGenMeshBuilder> Builder = CreateBuilder(ModelTypeName, Parameters, CacheKey);
+    if (!Builder)
     {
-        bool bIsValid = false;
-        
-        if (CachedMesh->IsValidLowLevel() && !CachedMesh->IsUnreachable())
-        {
-            if (IsValid(CachedMesh) && 
-                !CachedMesh->IsPendingKill() &&
-                !CachedMesh->HasAnyFlags(RF_BeginDestroyed | RF_FinishDestroyed))
-            {
-                if (CachedMesh->RenderData != nullptr && 
-                    CachedMesh->RenderData->IsInitialized())
-                {
-                    bIsValid = true;
-                }
-            }
-        }
-        
-        if (bIsValid)
-        {
-            FScopeLock Lock(&CacheLock);
-            CacheHitCount++;
-            return CachedMesh;
-        }
-        else
-        {
-            {
-                FScopeLock Lock(&CacheLock);
-                StaticMeshCache.Remove(CacheKey);
-            }
-        }
+        return nullptr;
     }
-    
+
+    return FindOrCreateStaticMesh(CacheKey, *Builder);
+}
+
+UStaticMesh* UCustomModelFactory::FindOrCreateStaticMesh(const FModelGenParamsHash& ParamsHash, FModelGenMeshBuilder& Builder)
+{
+    FModelGenStaticMeshSettings Settings;
+    int32 LODCount = 1;
+    GetDefaultStaticMeshSettings(Settings, LODCount);
+    return FindOrCreateStaticMesh(ParamsHash, Builder, Settings, LODCount);
+}
+
+UStaticMesh* UCustomModelFactory::FindOrCreateStaticMesh(const FModelGenParamsHash& ParamsHash, FModelGenMeshBuilder& Builder,
+    const FModelGenStaticMeshSettings& Settings, int32 LODCount)
+{
+    const FModelGenParamsHash CacheKey = MakeStaticMeshCacheKey(ParamsHash, Settings, LODCount);
+
+    FModelGenStaticMeshCache& Cache = FModelGenStaticMeshCache::Get();
+    if (UStaticMesh* CachedMesh = Cache.Find(CacheKey))
     {
-        FScopeLock Lock(&CacheLock);
-        CacheMissCount++;
+        return CachedMesh;
     }
-    
-    ProceduralActor->GenerateMesh();
-    
-    UStaticMesh* NewMesh = ProceduralActor->ConvertProceduralMeshToStaticMesh();
+
+    // 磁盘缓存只存几何，仍按参数哈希查找
+    FModelGenMeshData MeshData;
+    if (!FModelGenDiskCache::Get().FindOrGenerate(ParamsHash, Builder, MeshData) || !MeshData.IsValid())
+    {
+        return nullptr;
+    }
+
+    // 缓存中的网格被任意多个组件共享，碰撞必须在返回前烘焙完成，不能留下包围盒占位
+    FModelGenStaticMeshSettings MeshSettings = Settings;
+    MeshSettings.bAsyncCollision = false;
+    MeshSettings.OnAsyncCollisionReady = nullptr;
+    Builder.GenerateSimpleCollision(MeshSettings.SimpleCollision);
+
+    TArray<FModelGenMeshData> LODMeshes;
+    Builder.GenerateLODs(MeshData.Triangles.Num() / 3, LODCount, LODMeshes);
+
+    UStaticMesh* NewMesh = FModelGenStaticMeshConverter::CreateStaticMesh(MeshData, MeshSettings, LODMeshes);
     if (NewMesh)
     {
-        FScopeLock Lock(&CacheLock);
-        StaticMeshCache.Add(CacheKey, NewMesh);
+        Cache.Add(CacheKey, NewMesh);
     }
-    
+
     return NewMesh;
 }
 
-UStaticMesh* UCustomModelFactory::CreateModelStaticMesh(const FString& ModelTypeName, const TMap<FString, FString>& Parameters, UWorld* World)
+FModelGenParamsHash UCustomModelFactory::MakeStaticMeshCacheKey(const FModelGenParamsHash& ParamsHash, const FModelGenStaticMeshSettings& Settings, int32 LODCount)
+{
+    TArray<uint8> Bytes;
+    auto Write = [&Bytes](const void* Data, int32 NumBytes)
+    {
+        Bytes.Append(static_cast<const uint8*>(Data), NumBytes);
+    };
+
+    Write(&ParamsHash.Low, sizeof(uint64));
+    Write(&ParamsHash.High, sizeof(uint64));
+
+    // 材质按对象地址区分，与实例组的分组键一致
+    const int32 NumMaterials = Settings.SectionMaterials.Num();
+    Write(&NumMaterials, sizeof(NumMaterials));
+    for (const UMaterialInterface* Material : Settings.SectionMaterials)
+    {
+        const UPTRINT MaterialPtr = reinterpret_cast<UPTRINT>(Material);
+        Write(&MaterialPtr, sizeof(MaterialPtr));
+    }
+
+    const UPTRINT PhysMaterialPtr = reinterpret_cast<UPTRINT>(Settings.PhysMaterial);
+    Write(&PhysMaterialPtr, sizeof(PhysMaterialPtr));
+
+    // 缓存的网格总是同步烘焙，bAsyncCollision 不参与
+    const uint8 Flags[2] = {
+        Settings.bGenerateSimpleCollision ? uint8(1) : uint8(0),
+        Settings.bGenerateComplexCollision ? uint8(1) : uint8(0)
+    };
+    Write(Flags, sizeof(Flags));
+
+    const int32 ClampedLODCount = FMath::Max(LODCount, 1);
+    Write(&ClampedLODCount, sizeof(ClampedLODCount));
+
+    return FModelGenParamsHash::ComputeBytes(Bytes.GetData(), Bytes.Num());
+}
+
+void UCustomModelFactory::GetDefaultStaticMeshSettings(FModelGenStaticMeshSettings& OutSettings, int32& OutLODCount)
+{
+    // 不经过 Actor 的路径：分段 0 使用 ProceduralMeshActor 的默认材质，LOD 数取其默认值
+    const AProceduralMeshActor* Defaults = GetDefault<AProceduralMeshActor>();
+    OutSettings.SectionMaterials.Add(Defaults->ProceduralDefaultMaterial);
+    OutLODCount = Defaults->StaticMeshLODCount;
+}
+
+UStaticMesh* UCustomModelFactory::CreateModelStaticMeshFromActor(const FString& ModelTypeName, const TMap<FString, FString>& Parameters, UWorld* World)
 {
     if (!World)
     {
@@ -207,102 +340,285 @@ UStaticMesh* UCustomModelFactory::CreateModelStaticMeshWithDefaults(const FStrin
     return CreateModelStaticMesh(ModelTypeName, EmptyParameters, World);
 }
 
-void UCustomModelFactory::ClearCache()
+TArray<UStaticMesh*> UCustomModelFactory::CreateModelStaticMeshesBatch(const TArray<FModelGenBatchRequest>& Requests, UWorld* World, FModelGenBatchStats& OutStats)
 {
-    FScopeLock Lock(&CacheLock);
-    
-    for (auto& Pair : StaticMeshCache)
+    const double StartTime = FPlatformTime::Seconds();
+
+    OutStats = FModelGenBatchStats();
+    OutStats.NumRequests = Requests.Num();
+
+    if (ModelTypeRegistry.Num() == 0)
     {
-        if (IsValid(Pair.Value) && Pair.Value->IsRooted())
-        {
-            Pair.Value->RemoveFromRoot();
-        }
+        InitializeDefaultModelTypes();
     }
-    
-    StaticMeshCache.Empty();
-    CacheHitCount = 0;
-    CacheMissCount = 0;
-}
 
-void UCustomModelFactory::CleanupInvalidCache()
-{
-    FScopeLock Lock(&CacheLock);
-    
-    TArray<FString> KeysToRemove;
-    
-    for (auto It = StaticMeshCache.CreateIterator(); It; ++It)
+    struct FUniqueMesh
     {
-        UStaticMesh* Mesh = It.Value();
-        
-        bool bIsValid = false;
-        bool bShouldRemove = false;
-        
-        if (Mesh == nullptr)
+        FModelGenParamsHash Key;
+        FModelGenParamsHash CacheKey;
+        TUniquePtr<FModelGenMeshBuilder> Builder;
+        FModelGenMeshData MeshData;
+        TArray<FModelGenMeshData> LODMeshes;
+        FKAggregateGeom SimpleCollision;
+        bool bGenerated = false;
+        UStaticMesh* Mesh = nullptr;
+    };
+
+    // 参数解析、去重和缓存查找都在游戏线程完成，工作线程只接触各自的生成器与网格数据
+    TArray<FUniqueMesh> Uniques;
+    TMap<FModelGenParamsHash, int32> KeyToUnique;
+    TArray<int32> RequestToUnique;
+    RequestToUnique.Init(INDEX_NONE, Requests.Num());
+    TArray<int32> ActorRequests;
+
+    FModelGenStaticMeshCache& Cache = FModelGenStaticMeshCache::Get();
+
+    // 与单个创建的路径使用相同的默认设置，两条路径的缓存结果可以互相命中
+    FModelGenStaticMeshSettings DefaultSettings;
+    int32 LODCount = 1;
+    GetDefaultStaticMeshSettings(DefaultSettings, LODCount);
+
+    for (int32 RequestIndex = 0; RequestIndex < Requests.Num(); ++RequestIndex)
+    {
+        const FModelGenBatchRequest& Request = Requests[RequestIndex];
+        if (!BuilderRegistry.Contains(Request.ModelType))
         {
-            bShouldRemove = true;
+            ActorRequests.Add(RequestIndex);
+            continue;
         }
-        else if (!Mesh->IsValidLowLevel())
+
+        FModelGenParamsHash Key;
+        TUniquePtr<FModelGenMeshBuilder> Builder = CreateBuilder(Request.ModelType, Request.Parameters, Key);
+        if (!Builder)
         {
-            bShouldRemove = true;
+            continue;
         }
-        else if (Mesh->IsUnreachable())
+
+        if (const int32* ExistingIndex = KeyToUnique.Find(Key))
         {
-            bShouldRemove = true;
+            RequestToUnique[RequestIndex] = *ExistingIndex;
+            continue;
         }
-        else if (!IsValid(Mesh))
+
+        const int32 UniqueIndex = Uniques.AddDefaulted();
+        KeyToUnique.Add(Key, UniqueIndex);
+        RequestToUnique[RequestIndex] = UniqueIndex;
+
+        FUniqueMesh& Unique = Uniques[UniqueIndex];
+        Unique.Key = Key;
+        Unique.CacheKey = MakeStaticMeshCacheKey(Key, DefaultSettings, LODCount);
+        Unique.Mesh = Cache.Find(Unique.CacheKey);
+        if (Unique.Mesh)
         {
-            bShouldRemove = true;
+            ++OutStats.NumCacheHits;
         }
         else
         {
-            if (Mesh->RenderData == nullptr || !Mesh->RenderData->IsInitialized())
-            {
-                bShouldRemove = true;
-            }
-            else
-            {
-                
-                if (Mesh->IsPendingKill() || Mesh->HasAnyFlags(RF_BeginDestroyed | RF_FinishDestroyed))
-                {
-                    bShouldRemove = true;
-                }
-                else
-                {
-                    bIsValid = true;
-                }
-            }
+            Unique.Builder = MoveTemp(Builder);
         }
-        
-        if (bShouldRemove)
+    }
+
+    TArray<int32> PendingUniques;
+    for (int32 UniqueIndex = 0; UniqueIndex < Uniques.Num(); ++UniqueIndex)
+    {
+        if (Uniques[UniqueIndex].Builder)
         {
-            if (Mesh != nullptr && Mesh->IsValidLowLevel() && Mesh->IsRooted())
-            {
-                Mesh->RemoveFromRoot();
-            }
-            KeysToRemove.Add(It.Key());
+            PendingUniques.Add(UniqueIndex);
         }
     }
-    
-    for (const FString& Key : KeysToRemove)
+
+    const double GenerateStartTime = FPlatformTime::Seconds();
+
+    ParallelFor(PendingUniques.Num(), [&Uniques, &PendingUniques, LODCount](int32 PendingIndex)
     {
-        StaticMeshCache.Remove(Key);
+        FUniqueMesh& Unique = Uniques[PendingUniques[PendingIndex]];
+        Unique.bGenerated = FModelGenDiskCache::Get().FindOrGenerate(Unique.Key, *Unique.Builder, Unique.MeshData) && Unique.MeshData.IsValid();
+        if (Unique.bGenerated)
+        {
+            Unique.Builder->GenerateSimpleCollision(Unique.SimpleCollision);
+            Unique.Builder->GenerateLODs(Unique.MeshData.Triangles.Num() / 3, LODCount, Unique.LODMeshes);
+        }
+    });
+
+    const double FinalizeStartTime = FPlatformTime::Seconds();
+    OutStats.GenerateMs = static_cast<float>((FinalizeStartTime - GenerateStartTime) * 1000.0);
+
+    for (const int32 UniqueIndex : PendingUniques)
+    {
+        FUniqueMesh& Unique = Uniques[UniqueIndex];
+        if (!Unique.bGenerated)
+        {
+            continue;
+        }
+
+        FModelGenStaticMeshSettings Settings = DefaultSettings;
+        Settings.SimpleCollision = MoveTemp(Unique.SimpleCollision);
+
+        Unique.Mesh = FModelGenStaticMeshConverter::CreateStaticMesh(Unique.MeshData, Settings, Unique.LODMeshes);
+        if (Unique.Mesh)
+        {
+            Cache.Add(Unique.CacheKey, Unique.Mesh);
+            ++OutStats.NumGenerated;
+            OutStats.GeneratedTriangles += Unique.MeshData.GetTriangleCount();
+        }
+
+        // 转换完即释放，避免整批网格数据同时驻留
+        Unique.MeshData = FModelGenMeshData();
+        Unique.LODMeshes.Empty();
     }
-    
-    if (KeysToRemove.Num() > 0)
+
+    TArray<UStaticMesh*> Meshes;
+    Meshes.SetNumZeroed(Requests.Num());
+
+    for (int32 RequestIndex = 0; RequestIndex < Requests.Num(); ++RequestIndex)
+    {
+        if (RequestToUnique[RequestIndex] != INDEX_NONE)
+        {
+            Meshes[RequestIndex] = Uniques[RequestToUnique[RequestIndex]].Mesh;
+        }
+    }
+
+    // 没有生成器的类型需要临时 Actor，只能逐个处理
+    TMap<FString, UStaticMesh*> ActorMeshes;
+    for (const int32 RequestIndex : ActorRequests)
     {
+        const FModelGenBatchRequest& Request = Requests[RequestIndex];
+        const FString ActorKey = GenerateCacheKey(Request.ModelType, Request.Parameters);
+        if (UStaticMesh** ExistingMesh = ActorMeshes.Find(ActorKey))
+        {
+            Meshes[RequestIndex] = *ExistingMesh;
+            continue;
+        }
+
+        Meshes[RequestIndex] = CreateModelStaticMeshFromActor(Request.ModelType, Request.Parameters, World);
+        ActorMeshes.Add(ActorKey, Meshes[RequestIndex]);
     }
+
+    const double EndTime = FPlatformTime::Seconds();
+    OutStats.FinalizeMs = static_cast<float>((EndTime - FinalizeStartTime) * 1000.0);
+    OutStats.TotalMs = static_cast<float>((EndTime - StartTime) * 1000.0);
+    OutStats.NumUnique = Uniques.Num() + ActorMeshes.Num();
+    OutStats.MeshesPerSecond = EndTime > StartTime ? static_cast<float>(Requests.Num() / (EndTime - StartTime)) : 0.0f;
+
+    for (UStaticMesh* Mesh : Meshes)
+    {
+        if (!Mesh)
+        {
+            ++OutStats.NumFailed;
+        }
+    }
+
+    UE_LOG(LogModelGen, Log, TEXT("Batch: %d requests, %d unique, %d cache hits, %d generated, %d failed; generate %.2f ms, finalize %.2f ms, %.0f meshes/s"),
+        OutStats.NumRequests,
+        OutStats.NumUnique,
+        OutStats.NumCacheHits,
+        OutStats.NumGenerated,
+        OutStats.NumFailed,
+        OutStats.GenerateMs,
+        OutStats.FinalizeMs,
+        OutStats.MeshesPerSecond);
+
+    return Meshes;
+}
+
+void UCustomModelFactory::ClearCache()
+{
+    FModelGenStaticMeshCache::Get().Empty();
+}
+
+void UCustomModelFactory::CleanupInvalidCache()
+{
+    FModelGenStaticMeshCache::Get().RemoveInvalidEntries();
 }
 
 int32 UCustomModelFactory::GetCacheSize()
 {
-    FScopeLock Lock(&CacheLock);
-    return StaticMeshCache.Num();
+    return FModelGenStaticMeshCache::Get().Num();
+}
+
+FModelGenStaticMeshCacheStats UCustomModelFactory::GetCacheStats()
+{
+    return FModelGenStaticMeshCache::Get().GetStats();
+}
+
+void UCustomModelFactory::SetCacheBudgetMB(float BudgetMB)
+{
+    const int64 BudgetBytes = static_cast<int64>(FMath::Max(BudgetMB, 0.0f) * 1024.0 * 1024.0);
+    FModelGenStaticMeshCache::Get().SetBudgetBytes(BudgetBytes);
+}
+
+void UCustomModelFactory::SetDiskCacheEnabled(bool bEnabled)
+{
+    FModelGenDiskCache::Get().SetEnabled(bEnabled);
+}
+
+void UCustomModelFactory::SetDiskCacheBudgetMB(float BudgetMB)
+{
+    FModelGenDiskCache::Get().SetByteBudget(static_cast<int64>(FMath::Max(BudgetMB, 0.0f) * 1024.0 * 1024.0));
+}
+
+bool UCustomModelFactory::IsDiskCacheEnabled()
+{
+    return FModelGenDiskCache::Get().IsEnabled();
+}
+
+void UCustomModelFactory::ClearDiskCache()
+{
+    FModelGenDiskCache::Get().Clear();
 }
 
 void UCustomModelFactory::LogCacheStats()
 {
-    FScopeLock Lock(&CacheLock);
-    int32 TotalRequests = CacheHitCount + CacheMissCount;
-    float HitRate = TotalRequests > 0 ? (float)CacheHitCount / TotalRequests * 100.0f : 0.0f;
-    
+    const FModelGenStaticMeshCacheStats Stats = GetCacheStats();
+    UE_LOG(LogModelGen, Log, TEXT("StaticMesh cache: %d entries, %.2f / %.2f MB, hits %d, misses %d, evictions %d, hit rate %.1f%%"),
+        Stats.NumEntries,
+        Stats.TotalBytes / (1024.0 * 1024.0),
+        Stats.BudgetBytes / (1024.0 * 1024.0),
+        Stats.HitCount,
+        Stats.MissCount,
+        Stats.EvictionCount,
+        Stats.HitRate * 100.0f);
+
+    const FModelGenCollisionCookCacheStats CookStats = FModelGenCollisionCookCache::Get().GetStats();
+    UE_LOG(LogModelGen, Log, TEXT("Collision cook cache: %d entries, hits %d, misses %d, evictions %d"),
+        CookStats.NumEntries,
+        CookStats.HitCount,
+        CookStats.MissCount,
+        CookStats.EvictionCount);
+
+    FModelGenDiskCache& DiskCache = FModelGenDiskCache::Get();
+    const FModelGenDiskCacheStats DiskStats = DiskCache.GetStats();
+    UE_LOG(LogModelGen, Log, TEXT("Disk cache (%s, %s): mesh hits %d, misses %d; collision hits %d, misses %d; writes %d, rejected %d, pruned %d; read %.2f MB, written %.2f MB"),
+        DiskCache.IsEnabled() ? TEXT("enabled") : TEXT("disabled"),
+        *DiskCache.GetCacheDir(),
+        DiskStats.MeshHitCount,
+        DiskStats.MeshMissCount,
+        DiskStats.CollisionHitCount,
+        DiskStats.CollisionMissCount,
+        DiskStats.WriteCount,
+        DiskStats.RejectedCount,
+        DiskStats.PrunedCount,
+        DiskStats.BytesRead / (1024.0 * 1024.0),
+        DiskStats.BytesWritten / (1024.0 * 1024.0));
+}
+
+FModelGenGenerationStats UCustomModelFactory::GetLastGenerationStats()
+{
+    return FModelGenStageRecorder::GetLastStats();
+}
+
+void UCustomModelFactory::LogGenerationStats()
+{
+    const FModelGenGenerationStats Stats = GetLastGenerationStats();
+    UE_LOG(LogModelGen, Log, TEXT("Last generation: %d verts, %d tris, %.1f KB; Generate %.3f ms (tangents %.3f), ToProceduralMesh %.3f ms, MeshDescription %.3f ms, BuildStaticMesh %.3f ms, ConvexDecomposition %.3f ms, Cooking %.3f ms"),
+        Stats.VertexCount,
+        Stats.TriangleCount,
+        Stats.MeshDataBytes / 1024.0,
+        Stats.GenerateMs,
+        Stats.CalculateTangentsMs,
+        Stats.ToProceduralMeshMs,
+        Stats.BuildMeshDescriptionMs,
+        Stats.BuildStaticMeshMs,
+        Stats.ConvexDecompositionMs,
+        Stats.CollisionCookingMs);
 }
@@ -9,7 +9,10 @@ APolygonTorus::APolygonTorus()
 
 void APolygonTorus::GenerateMesh()
 {
-    TryGenerateMeshInternal();
+    if (!TryGenerateMeshInternal())
+    {
+        ClearGeneratedMesh();
+    }
 }
 
 bool APolygonTorus::TryGenerateMeshInternal()
@@ -19,46 +22,52 @@ bool APolygonTorus::TryGenerateMeshInternal()
         return false;
     }
 
-    FPolygonTorusBuilder Builder(*this);
-    FModelGenMeshData MeshData;
-
-    if (!Builder.Generate(MeshData))
+    if (RefreshInstancedShape())
     {
-        return false;
+        return true;
     }
 
-    if (!MeshData.IsValid())
-    {
-        return false;
-    }
+    const FPolygonTorusParams Params = GetParams();
+    FPolygonTorusBuilder Builder(Params);
+    return GenerateAndApplyMesh(Builder, Params);
+}
 
-    MeshData.ToProceduralMesh(GetProceduralMesh(), 0);
-    return true;
+TUniquePtr<FModelGenMeshBuilder> APolygonTorus::CreateMeshBuilder() const
+{
+    return MakeUnique<FPolygonTorusBuilder>(GetParams());
+}
+
+FPolygonTorusParams APolygonTorus::GetParams() const
+{
+    FPolygonTorusParams Params;
+    Params.MajorRadius = MajorRadius;
+    Params.MinorRadius = MinorRadius;
+    Params.MajorSegments = MajorSegments;
+    Params.MinorSegments = MinorSegments;
+    Params.TorusAngle = TorusAngle;
+    Params.bSmoothCrossSection = bSmoothCrossSection;
+    Params.bSmoothVerticalSection = bSmoothVerticalSection;
+    return Params;
+}
+
+FModelGenParamsHash APolygonTorus::GetShapeParamsHash() const
+{
+    return FModelGenParamsHash::Compute(GetParams());
 }
 
 bool APolygonTorus::IsValid() const
 {
-    return MajorRadius > 0.0f &&
-           MinorRadius > 0.0f && MinorRadius <= MajorRadius * 0.9f &&
-           MajorSegments >= 3 && MajorSegments <= 25 &&
-           MinorSegments >= 3 && MinorSegments <= 25 &&
-           TorusAngle >= 0.0f && TorusAngle <= 360.0f;
+    return GetParams().IsValid();
 }
 
 int32 APolygonTorus::CalculateVertexCountEstimate() const
 {
-    const int32 BaseVertexCount = MajorSegments * MinorSegments;
-    const int32 CapVertexCount = (TorusAngle < 360.0f - KINDA_SMALL_NUMBER) ? MinorSegments * 2 : 0;
-    
-    return BaseVertexCount + CapVertexCount;
+    return GetParams().CalculateVertexCountEstimate();
 }
 
 int32 APolygonTorus::CalculateTriangleCountEstimate() const
 {
-    const int32 BaseTriangleCount = MajorSegments * MinorSegments * 2;
-    const int32 CapTriangleCount = (TorusAngle < 360.0f - KINDA_SMALL_NUMBER) ? MinorSegments * 2 : 0;
-    
-    return BaseTriangleCount + CapTriangleCount;
+    return GetParams().CalculateTriangleCountEstimate();
 }
 
 void APolygonTorus::SetMajorRadius(float NewMajorRadius)
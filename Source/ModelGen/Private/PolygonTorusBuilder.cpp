@@ -1,11 +1,12 @@
 #include "PolygonTorusBuilder.h"
-#include "PolygonTorus.h"
 #include "ModelGenMeshData.h"
+#include "PhysicsEngine/AggregateGeom.h"
 #include "Math/UnrealMathUtility.h"
 #include "ModelGenConstants.h"
+#include "ModelGenStats.h"
 
-FPolygonTorusBuilder::FPolygonTorusBuilder(const APolygonTorus& InPolygonTorus)
-    : PolygonTorus(InPolygonTorus)
+FPolygonTorusBuilder::FPolygonTorusBuilder(const FPolygonTorusParams& InParams)
+    : Params(InParams)
 {
     Clear();
 }
@@ -21,7 +22,9 @@ void FPolygonTorusBuilder::Clear()
 
 bool FPolygonTorusBuilder::Generate(FModelGenMeshData& OutMeshData)
 {
-    if (PolygonTorus.MajorSegments < 3 || PolygonTorus.MinorSegments < 3)
+    MODELGEN_GENERATE_SCOPE(OutMeshData);
+
+    if (Params.MajorSegments < 3 || Params.MinorSegments < 3)
     {
         return false;
     }
@@ -33,7 +36,7 @@ bool FPolygonTorusBuilder::Generate(FModelGenMeshData& OutMeshData)
 
     GenerateTorusSurface();
 
-    if (FMath::Abs(PolygonTorus.TorusAngle) < 360.0f - KINDA_SMALL_NUMBER)
+    if (FMath::Abs(Params.TorusAngle) < 360.0f - KINDA_SMALL_NUMBER)
     {
         GenerateEndCaps();
     }
@@ -43,25 +46,77 @@ bool FPolygonTorusBuilder::Generate(FModelGenMeshData& OutMeshData)
         return false;
     }
 
-    MeshData.CalculateTangents();
+    // 切线已在生成顶点时解析给出，无需再做整网格切线计算
     OutMeshData = MeshData;
     return true;
 }
 
 int32 FPolygonTorusBuilder::CalculateVertexCountEstimate() const
 {
-    return PolygonTorus.MajorSegments * PolygonTorus.MinorSegments * 4;
+    return Params.MajorSegments * Params.MinorSegments * 4;
 }
 
 int32 FPolygonTorusBuilder::CalculateTriangleCountEstimate() const
 {
-    return PolygonTorus.CalculateTriangleCountEstimate();
+    return Params.CalculateTriangleCountEstimate();
+}
+
+bool FPolygonTorusBuilder::GenerateSimpleCollision(FKAggregateGeom& OutGeom) const
+{
+    if (!Params.IsValid())
+    {
+        return false;
+    }
+
+    // 沿主环每段放一个胶囊，截面中心与生成网格一致位于 Z = MinorRadius
+    const float TorusAngleRad = FMath::DegreesToRadians(Params.TorusAngle);
+    const float StartAngle = -TorusAngleRad / 2.0f;
+    const float MajorStep = TorusAngleRad / Params.MajorSegments;
+
+    auto SectionCenter = [&](int32 Index)
+    {
+        const float Angle = StartAngle + Index * MajorStep;
+        return FVector(Params.MajorRadius * FMath::Cos(Angle), Params.MajorRadius * FMath::Sin(Angle), Params.MinorRadius);
+    };
+
+    for (int32 i = 0; i < Params.MajorSegments; ++i)
+    {
+        const FVector Start = SectionCenter(i);
+        const FVector End = SectionCenter(i + 1);
+        const FVector Axis = End - Start;
+        const float Length = Axis.Size();
+        if (Length <= KINDA_SMALL_NUMBER)
+        {
+            continue;
+        }
+
+        FKSphylElem SphylElem(Params.MinorRadius, Length);
+        SphylElem.Center = (Start + End) * 0.5f;
+        SphylElem.Rotation = FRotationMatrix::MakeFromZ(Axis / Length).Rotator();
+        OutGeom.SphylElems.Add(SphylElem);
+    }
+
+    return OutGeom.SphylElems.Num() > 0;
+}
+
+TUniquePtr<FModelGenMeshBuilder> FPolygonTorusBuilder::CreateReducedBuilder(float TessellationScale) const
+{
+    FPolygonTorusParams Reduced = Params;
+    Reduced.MajorSegments = ScaleSegmentCount(Params.MajorSegments, TessellationScale, MinLODSides);
+    Reduced.MinorSegments = ScaleSegmentCount(Params.MinorSegments, TessellationScale, MinLODSides);
+
+    if (Reduced.MajorSegments == Params.MajorSegments && Reduced.MinorSegments == Params.MinorSegments)
+    {
+        return nullptr;
+    }
+
+    return MakeUnique<FPolygonTorusBuilder>(Reduced);
 }
 
 void FPolygonTorusBuilder::PrecomputeMath()
 {
-    const float TorusAngleRad = FMath::DegreesToRadians(PolygonTorus.TorusAngle);
-    const int32 MajorSegs = PolygonTorus.MajorSegments;
+    const float TorusAngleRad = FMath::DegreesToRadians(Params.TorusAngle);
+    const int32 MajorSegs = Params.MajorSegments;
 
     const float StartAngle = -TorusAngleRad / 2.0f;
     const float MajorStep = TorusAngleRad / MajorSegs;
@@ -73,7 +128,7 @@ void FPolygonTorusBuilder::PrecomputeMath()
         FMath::SinCos(&MajorAngleCache[i].Sin, &MajorAngleCache[i].Cos, Angle);
     }
 
-    const int32 MinorSegs = PolygonTorus.MinorSegments;
+    const int32 MinorSegs = Params.MinorSegments;
     const float MinorStep = 2.0f * PI / MinorSegs;
 
     MinorAngleCache.SetNum(MinorSegs + 1);
@@ -86,19 +141,19 @@ void FPolygonTorusBuilder::PrecomputeMath()
 
 void FPolygonTorusBuilder::GenerateTorusSurface()
 {
-    const int32 MajorSegs = PolygonTorus.MajorSegments;
-    const int32 MinorSegs = PolygonTorus.MinorSegments;
-    const float MajorRad = PolygonTorus.MajorRadius;
-    const float MinorRad = PolygonTorus.MinorRadius;
+    const int32 MajorSegs = Params.MajorSegments;
+    const int32 MinorSegs = Params.MinorSegments;
+    const float MajorRad = Params.MajorRadius;
+    const float MinorRad = Params.MinorRadius;
 
-    const bool bSmoothVert = PolygonTorus.bSmoothVerticalSection;
-    const bool bSmoothCross = PolygonTorus.bSmoothCrossSection;
+    const bool bSmoothVert = Params.bSmoothVerticalSection;
+    const bool bSmoothCross = Params.bSmoothCrossSection;
 
     StartCapRingIndices.Reserve(MinorSegs);
     EndCapRingIndices.Reserve(MinorSegs);
 
     float CurrentU = 0.0f;
-    const float MajorArcStep = (FMath::DegreesToRadians(PolygonTorus.TorusAngle) / MajorSegs) * MajorRad;
+    const float MajorArcStep = (FMath::DegreesToRadians(Params.TorusAngle) / MajorSegs) * MajorRad;
 
     const float TotalMinorCircumference = (2.0f * PI) * MinorRad;
 
@@ -177,7 +232,11 @@ void FPolygonTorusBuilder::GenerateTorusSurface()
 
                 FVector2D UV(Corners[k].U * ModelGenConstants::GLOBAL_UV_SCALE, Corners[k].V * ModelGenConstants::GLOBAL_UV_SCALE);
 
-                Indices[k] = GetOrAddVertex(Pos, Normal, UV);
+                // U 沿主圆角度增加；V 随次圆角度递减，取次圆切向的反方向
+                const FVector DPosDU(-MajP.Sin, MajP.Cos, 0.0f);
+                const FVector DPosDV(MinP.Sin * MajP.Cos, MinP.Sin * MajP.Sin, -MinP.Cos);
+
+                Indices[k] = GetOrAddVertex(Pos, Normal, UV, MakeTangent(Normal, DPosDU, DPosDV));
             }
 
             AddQuad(Indices[0], Indices[3], Indices[2], Indices[1]);
@@ -207,16 +266,16 @@ void FPolygonTorusBuilder::CreateCap(const TArray<int32>& RingIndices, bool bIsS
 {
     if (RingIndices.Num() < 3) return;
 
-    const float TorusAngleRad = FMath::DegreesToRadians(PolygonTorus.TorusAngle);
+    const float TorusAngleRad = FMath::DegreesToRadians(Params.TorusAngle);
     const float Angle = bIsStart ? (-TorusAngleRad / 2.0f) : (TorusAngleRad / 2.0f);
 
     float CosA, SinA;
     FMath::SinCos(&SinA, &CosA, Angle);
 
     FVector CenterPos(
-        PolygonTorus.MajorRadius * CosA,
-        PolygonTorus.MajorRadius * SinA,
-        PolygonTorus.MinorRadius
+        Params.MajorRadius * CosA,
+        Params.MajorRadius * SinA,
+        Params.MinorRadius
     );
 
     FVector Normal = bIsStart ?
@@ -227,7 +286,7 @@ void FPolygonTorusBuilder::CreateCap(const TArray<int32>& RingIndices, bool bIsS
         {
             float R_Current = FVector2D(P.X, P.Y).Size();
 
-            float LocalX = R_Current - PolygonTorus.MajorRadius;
+            float LocalX = R_Current - Params.MajorRadius;
             
             if (bIsStart)
             {
@@ -239,6 +298,10 @@ void FPolygonTorusBuilder::CreateCap(const TArray<int32>& RingIndices, bool bIsS
             return FVector2D(LocalX * ModelGenConstants::GLOBAL_UV_SCALE, LocalY * ModelGenConstants::GLOBAL_UV_SCALE);
         };
 
+    // 与 GetCapUV 一致：U 沿径向（起始端取反），V 沿 Z 向下
+    const FVector RadialDir(CosA, SinA, 0.0f);
+    const FProcMeshTangent Tangent = MakeTangent(Normal, bIsStart ? -RadialDir : RadialDir, -FVector::UpVector);
+
     TArray<int32> CapVertices;
     CapVertices.Reserve(RingIndices.Num());
 
@@ -246,11 +309,11 @@ void FPolygonTorusBuilder::CreateCap(const TArray<int32>& RingIndices, bool bIsS
     {
         FVector Pos = GetPosByIndex(Idx);
         FVector2D UV = GetCapUV(Pos);
-        CapVertices.Add(AddVertex(Pos, Normal, UV));
+        CapVertices.Add(AddVertex(Pos, Normal, UV, Tangent));
     }
 
     FVector2D CenterUV = GetCapUV(CenterPos);
-    int32 CenterIdx = AddVertex(CenterPos, Normal, CenterUV);
+    int32 CenterIdx = AddVertex(CenterPos, Normal, CenterUV, Tangent);
 
     const int32 NumVerts = CapVertices.Num();
     for (int32 i = 0; i < NumVerts; ++i)
@@ -1,32 +1,22 @@
 #include "ProceduralMeshActor.h"
 
+#include "Async/Async.h"
+
 #include "AssetRegistry/AssetRegistryModule.h"
 #include "Components/StaticMeshComponent.h"
 #include "Engine/StaticMesh.h"
 #include "Materials/Material.h"
 #include "Materials/MaterialInterface.h"
-#include "MeshDescription.h"
-#include "MeshDescriptionBuilder.h"
 #include "NavCollision.h"
 #include "PhysicsEngine/BodySetup.h"
 #include "PhysicalMaterials/PhysicalMaterial.h"
 #include "ProceduralMeshComponent.h"
-#include "ProceduralMeshConversion.h"
-#include "Rendering/ColorVertexBuffer.h"
-#include "Rendering/PositionVertexBuffer.h"
-#include "Rendering/StaticMeshVertexBuffer.h"
-#include "StaticMeshAttributes.h"
-#include "StaticMeshOperations.h"
-#include "StaticMeshResources.h"
 #include "UObject/ConstructorHelpers.h"
-#include "ModelGenConvexDecomp.h"
-#include "PhysicsEngine/PhysicsSettings.h"
-#include "HAL/PlatformProperties.h"
-#include "Interface_CollisionDataProviderCore.h"
-#include "IPhysXCookingModule.h"
-#include "IPhysXCooking.h"
-#include "PhysicsPublicCore.h"
-#include "Modules/ModuleManager.h"
+#include "ModelGenMeshBuilder.h"
+#include "ModelGenMeshData.h"
+#include "ModelGenDiskCache.h"
+#include "ModelGenStaticMeshConverter.h"
+#include "ModelGenInstancingSubsystem.h"
 
 AProceduralMeshActor::AProceduralMeshActor()
 {
@@ -69,942 +59,735 @@ void AProceduralMeshActor::OnConstruction(const FTransform& Transform)
 {
     Super::OnConstruction(Transform);
 
-    if (ProceduralMeshComponent && IsValid())
+    // 实例化期间移动或改参数只需更新所在的实例组
+    if (RefreshInstancedShape())
     {
-        ProceduralMeshComponent->ClearAllMeshSections();
+        return;
+    }
+
+    // 参数无效时不保留上一次的网格
+    if (!IsValid())
+    {
+        ClearGeneratedMesh();
+        return;
+    }
+
+    if (ProceduralMeshComponent)
+    {
+        ProceduralMeshComponent->bUseAsyncCooking = bUseAsyncCooking;
         ProceduralMeshComponent->SetCollisionEnabled(
             bGenerateCollision ? ECollisionEnabled::QueryAndPhysics : ECollisionEnabled::NoCollision);
         ProceduralMeshComponent->SetCollisionObjectType(ECollisionChannel::ECC_WorldStatic);
-        GenerateMesh();
+
+        // 不清空已有分段：离散参数不变时只原位更新顶点流，异步模式下也可保留旧网格直到新结果就绪；多余分段在写入时清掉
+        if (bAsyncMeshGeneration)
+        {
+            GenerateMeshAsync();
+        }
+        else
+        {
+            GenerateMesh();
+        }
         ProceduralMeshComponent->SetVisibility(true);
+
+        for (UProceduralMeshComponent* ChunkComponent : ChunkMeshComponents)
+        {
+            SyncChunkComponentSettings(ChunkComponent);
+        }
     }
 }
 
-void AProceduralMeshActor::SetPMCCollisionEnabled(bool bEnable)
+void AProceduralMeshActor::BeginPlay()
 {
-    bGenerateCollision = bEnable;
-    if (ProceduralMeshComponent)
+    Super::BeginPlay();
+
+    UModelGenInstancingSubsystem* Instancing = UModelGenInstancingSubsystem::Get(GetWorld());
+    if (Instancing && Instancing->IsAutoInstancingEnabled())
     {
-        ProceduralMeshComponent->SetCollisionEnabled(
-            bGenerateCollision ? ECollisionEnabled::QueryAndPhysics
-            : ECollisionEnabled::NoCollision);
+        Instancing->AddActor(this);
     }
 }
 
-void AProceduralMeshActor::GeneratePMCollisionData()
+void AProceduralMeshActor::EndPlay(const EEndPlayReason::Type EndPlayReason)
 {
-    if (!ProceduralMeshComponent || ProceduralMeshComponent->GetCollisionEnabled() == ECollisionEnabled::NoCollision)
-    {
-        return;
-    }
-
-    if (!ProceduralMeshComponent->ProcMeshBodySetup)
+    if (bInstanced)
     {
-        ProceduralMeshComponent->ProcMeshBodySetup = NewObject<UBodySetup>(
-            ProceduralMeshComponent, 
-            UBodySetup::StaticClass(), 
-            NAME_None, 
-            RF_Transactional);
-        
-        if (!ProceduralMeshComponent->ProcMeshBodySetup)
+        if (UModelGenInstancingSubsystem* Instancing = UModelGenInstancingSubsystem::Get(GetWorld()))
         {
-            return;
+            Instancing->RemoveActor(this, false);
         }
     }
-    
-    if (!ProceduralMeshComponent->ProcMeshBodySetup)
+
+    if (RootComponent)
     {
-        return;
+        RootComponent->TransformUpdated.Remove(RootTransformUpdatedHandle);
     }
+    RootTransformUpdatedHandle.Reset();
+
+    Super::EndPlay(EndPlayReason);
+}
+
+#if WITH_EDITOR
+void AProceduralMeshActor::PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent)
+{
+    // Super 会重新执行构造脚本；拖动滑条期间的 Interactive 通知不写盘，松手后的最后一次重建才写入磁盘缓存
+    TGuardValue<bool> CommitGuard(bCommittingEdit, PropertyChangedEvent.ChangeType != EPropertyChangeType::Interactive);
+    Super::PostEditChangeProperty(PropertyChangedEvent);
+}
+#endif
+
+TUniquePtr<FModelGenMeshBuilder> AProceduralMeshActor::CreateMeshBuilder() const
+{
+    return nullptr;
+}
 
-    UBodySetup* PMCBodySetup = ProceduralMeshComponent->ProcMeshBodySetup;
-    int32 CurrentElementCount = PMCBodySetup->AggGeom.GetElementCount();
-    
-    if (CurrentElementCount == 0)
+void AProceduralMeshActor::SetInstanced(bool bInInstanced, bool bRegenerate)
+{
+    if (bInstanced != bInInstanced)
     {
-        const int32 NumSections = ProceduralMeshComponent->GetNumSections();
-        if (NumSections == 0)
-        {
-            return;
-        }
-        FBox BoundingBox(ForceInitToZero);
-        bool bHasVertices = false;
-        
-        for (int32 SectionIdx = 0; SectionIdx < NumSections; ++SectionIdx)
+        bInstanced = bInInstanced;
+
+        if (RootComponent)
         {
-            FProcMeshSection* SectionData = ProceduralMeshComponent->GetProcMeshSection(SectionIdx);
-            if (SectionData && SectionData->ProcVertexBuffer.Num() > 0)
+            RootComponent->TransformUpdated.Remove(RootTransformUpdatedHandle);
+            RootTransformUpdatedHandle.Reset();
+            if (bInstanced)
             {
-                for (const FProcMeshVertex& Vertex : SectionData->ProcVertexBuffer)
-                {
-                    BoundingBox += Vertex.Position;
-                    bHasVertices = true;
-                }
+                RootTransformUpdatedHandle = RootComponent->TransformUpdated.AddUObject(this, &AProceduralMeshActor::OnRootTransformUpdated);
             }
         }
-        
-        if (bHasVertices && BoundingBox.IsValid)
+
+        if (bInstanced)
         {
-            FVector Center = BoundingBox.GetCenter();
-            FVector Extent = BoundingBox.GetExtent();
-            
-            if (Extent.X > 0.0f && Extent.Y > 0.0f && Extent.Z > 0.0f)
+            ClearGeneratedMesh();
+            if (StaticMeshComponent)
             {
-                FKBoxElem BoxElem;
-                BoxElem.Center = Center;
-                BoxElem.X = Extent.X * 2.0f;
-                BoxElem.Y = Extent.Y * 2.0f;
-                BoxElem.Z = Extent.Z * 2.0f;
-                
-                PMCBodySetup->AggGeom.BoxElems.Add(BoxElem);
-                PMCBodySetup->CreatePhysicsMeshes();
+                StaticMeshComponent->SetStaticMesh(nullptr);
             }
         }
     }
+
+    if (bInstanced || !bRegenerate)
+    {
+        return;
+    }
+
+    if (bAsyncMeshGeneration)
+    {
+        GenerateMeshAsync();
+    }
+    else
+    {
+        GenerateMesh();
+    }
 }
 
-void AProceduralMeshActor::SetProceduralMeshVisibility(bool bVisible)
+bool AProceduralMeshActor::RefreshInstancedShape()
+{
+    if (!bInstanced)
+    {
+        return false;
+    }
+
+    if (UModelGenInstancingSubsystem* Instancing = UModelGenInstancingSubsystem::Get(GetWorld()))
+    {
+        Instancing->RefreshActor(this);
+    }
+    return true;
+}
+
+void AProceduralMeshActor::OnRootTransformUpdated(USceneComponent* UpdatedComponent, EUpdateTransformFlags UpdateTransformFlags, ETeleportType Teleport)
+{
+    RefreshInstancedShape();
+}
+
+void AProceduralMeshActor::ApplyMeshData(FModelGenMeshData&& MeshData, TSharedPtr<FModelGenMeshBuilder> SourceBuilder)
+{
+    // 实例化期间参数变化只转交给实例组，不占用自身组件；各形状的生成入口已先行跳过，这里兜住其余调用方
+    if (RefreshInstancedShape())
+    {
+        return;
+    }
+
+    // 同步生成的结果比任何在途任务都新
+    CancelAsyncMeshGeneration();
+
+    // 整体结果只占分块 0，之前的分块组件不再需要
+    SetNumMeshChunks(1);
+
+    MeshData.ToProceduralMesh(GetProceduralMesh(), 0);
+    ClearSectionsFrom(GetProceduralMesh(), 1);
+    LastMeshData = MakeShared<FModelGenMeshData>(MoveTemp(MeshData));
+    LastMeshBuilder = SourceBuilder.IsValid() ? MoveTemp(SourceBuilder) : TSharedPtr<FModelGenMeshBuilder>(CreateMeshBuilder().Release());
+    LastTopology.Reset();
+}
+
+bool AProceduralMeshActor::GenerateAndApplyMesh(FModelGenMeshBuilder& Builder, const FModelGenParamsHash& ParamsHash, const FModelGenParamsHash& TopologyKey)
+{
+    UProceduralMeshComponent* MeshComponent = GetProceduralMesh();
+    if (!MeshComponent)
+    {
+        return false;
+    }
+
+    FModelGenMeshData MeshData;
+    TSharedPtr<FModelGenTopologyRecord> Topology;
+
+    const bool bReplayed = LastTopology.IsValid() && LastTopologyKey == TopologyKey && Builder.Regenerate(*LastTopology, MeshData);
+    if (bReplayed)
+    {
+        Topology = LastTopology;
+
+        // 组件仍是该拓扑的整体结果时只更新顶点流，不重建索引缓冲与碰撞分段
+        if (HasWholeMeshData() && GetNumMeshChunks() == 1 && MeshData.UpdateProceduralMeshVertices(MeshComponent, 0))
+        {
+            CancelAsyncMeshGeneration();
+            LastMeshData = MakeShared<FModelGenMeshData>(MoveTemp(MeshData));
+            LastMeshBuilder = TSharedPtr<FModelGenMeshBuilder>(CreateMeshBuilder().Release());
+            return true;
+        }
+    }
+    else
+    {
+        Topology = MakeShared<FModelGenTopologyRecord>();
+        Builder.SetTopologyRecord(Topology.Get());
+        const bool bGenerated = FModelGenDiskCache::Get().FindOrGenerate(ParamsHash, Builder, MeshData, ShouldPersistMeshData()) && MeshData.IsValid();
+        Builder.SetTopologyRecord(nullptr);
+
+        if (!bGenerated)
+        {
+            return false;
+        }
+    }
+
+    ApplyMeshData(MoveTemp(MeshData));
+
+    // 磁盘缓存命中时没有运行 Generate，也就没有拓扑可记录，下一次编辑完整生成
+    if (Topology->IsValid())
+    {
+        LastTopology = MoveTemp(Topology);
+        LastTopologyKey = TopologyKey;
+    }
+    return true;
+}
+
+void AProceduralMeshActor::ClearGeneratedMesh()
 {
+    CancelAsyncMeshGeneration();
+    SetNumMeshChunks(1);
+    LastMeshData.Reset();
+    LastMeshBuilder.Reset();
+    LastTopology.Reset();
+
     if (ProceduralMeshComponent)
     {
-        ProceduralMeshComponent->SetVisibility(bVisible);
+        ProceduralMeshComponent->ClearAllMeshSections();
     }
 }
 
-void AProceduralMeshActor::UpdateStaticMeshComponent()
+void AProceduralMeshActor::ApplyMeshChunk(int32 ChunkIndex, const FModelGenMeshData& MeshData)
 {
-    if (!StaticMeshComponent)
+    if (RefreshInstancedShape())
     {
         return;
     }
 
-    if (!ProceduralMeshComponent)
+    CancelAsyncMeshGeneration();
+    LastMeshData.Reset();
+    LastMeshBuilder.Reset();
+    LastTopology.Reset();
+
+    if (ChunkIndex >= GetNumMeshChunks())
+    {
+        SetNumMeshChunks(ChunkIndex + 1);
+    }
+
+    UProceduralMeshComponent* MeshComponent = GetMeshChunkComponent(ChunkIndex);
+    if (!MeshComponent)
     {
         return;
     }
 
-    const int32 NumSections = ProceduralMeshComponent->GetNumSections();
-    if (NumSections == 0)
+    if (MeshData.IsValid())
+    {
+        MeshData.ToProceduralMesh(MeshComponent, 0);
+        ClearSectionsFrom(MeshComponent, 1);
+    }
+    else
+    {
+        MeshComponent->ClearAllMeshSections();
+    }
+}
+
+void AProceduralMeshActor::ClearSectionsFrom(UProceduralMeshComponent* MeshComponent, int32 FirstSection)
+{
+    // OnConstruction 不再整体清空，分段数减少时多出的旧分段需要单独清掉
+    if (!MeshComponent)
     {
         return;
     }
-    UStaticMesh* ConvertedMesh = ConvertProceduralMeshToStaticMesh();
-    if (ConvertedMesh)
+
+    for (int32 SectionIdx = MeshComponent->GetNumSections() - 1; SectionIdx >= FirstSection; --SectionIdx)
     {
-        StaticMeshComponent->SetStaticMesh(ConvertedMesh);
-        StaticMeshComponent->StreamingDistanceMultiplier = 10.0f;
+        const FProcMeshSection* Section = MeshComponent->GetProcMeshSection(SectionIdx);
+        if (Section && Section->ProcVertexBuffer.Num() > 0)
+        {
+            MeshComponent->ClearMeshSection(SectionIdx);
+        }
+    }
+}
 
-        if (ConvertedMesh->BodySetup)
+void AProceduralMeshActor::SetNumMeshChunks(int32 NumChunks)
+{
+    const int32 NumExtraChunks = FMath::Max(NumChunks - 1, 0);
+
+    while (ChunkMeshComponents.Num() > NumExtraChunks)
+    {
+        UProceduralMeshComponent* ChunkComponent = ChunkMeshComponents.Pop(false);
+        if (ChunkComponent)
         {
-            FName ProfileName = ConvertedMesh->BodySetup->DefaultInstance.GetCollisionProfileName();
-            if (!ProfileName.IsNone())
-            {
-                StaticMeshComponent->SetCollisionProfileName(ProfileName);
-            }
-            else
-            {
-                StaticMeshComponent->SetCollisionEnabled(ConvertedMesh->BodySetup->DefaultInstance.GetCollisionEnabled());
-                StaticMeshComponent->SetCollisionObjectType(ConvertedMesh->BodySetup->DefaultInstance.GetObjectType());
-            }
+            ChunkComponent->DestroyComponent();
         }
+    }
 
-        if (StaticMeshMaterial)
+    // 重新运行构造脚本等情况下组件可能已被销毁
+    for (UProceduralMeshComponent*& ChunkComponent : ChunkMeshComponents)
+    {
+        if (!ChunkComponent || ChunkComponent->IsPendingKill())
         {
-            StaticMeshComponent->SetMaterial(0, StaticMeshMaterial);
+            ChunkComponent = CreateChunkMeshComponent();
         }
-        else if (ProceduralDefaultMaterial)
+    }
+
+    while (ChunkMeshComponents.Num() < NumExtraChunks)
+    {
+        ChunkMeshComponents.Add(CreateChunkMeshComponent());
+    }
+
+    if (ChunkStaticMeshComponents.Num() > NumExtraChunks)
+    {
+        SetNumChunkStaticMeshComponents(NumExtraChunks);
+    }
+}
+
+UProceduralMeshComponent* AProceduralMeshActor::GetMeshChunkComponent(int32 ChunkIndex) const
+{
+    if (ChunkIndex == 0)
+    {
+        return ProceduralMeshComponent;
+    }
+
+    return ChunkMeshComponents.IsValidIndex(ChunkIndex - 1) ? ChunkMeshComponents[ChunkIndex - 1] : nullptr;
+}
+
+UProceduralMeshComponent* AProceduralMeshActor::CreateChunkMeshComponent()
+{
+    if (!ProceduralMeshComponent)
+    {
+        return nullptr;
+    }
+
+    UProceduralMeshComponent* ChunkComponent = NewObject<UProceduralMeshComponent>(this, NAME_None, RF_Transient);
+    ChunkComponent->SetupAttachment(ProceduralMeshComponent);
+    SyncChunkComponentSettings(ChunkComponent);
+    ChunkComponent->RegisterComponent();
+    return ChunkComponent;
+}
+
+void AProceduralMeshActor::SyncChunkComponentSettings(UProceduralMeshComponent* ChunkComponent) const
+{
+    if (!ChunkComponent || !ProceduralMeshComponent)
+    {
+        return;
+    }
+
+    ChunkComponent->bUseAsyncCooking = bUseAsyncCooking;
+    ChunkComponent->SetCollisionEnabled(ProceduralMeshComponent->GetCollisionEnabled());
+    ChunkComponent->SetCollisionObjectType(ProceduralMeshComponent->GetCollisionObjectType());
+    ChunkComponent->SetVisibility(ProceduralMeshComponent->GetVisibleFlag());
+    ChunkComponent->SetMaterial(0, ProceduralMeshComponent->GetMaterial(0));
+}
+
+void AProceduralMeshActor::SetNumChunkStaticMeshComponents(int32 NumComponents)
+{
+    while (ChunkStaticMeshComponents.Num() > NumComponents)
+    {
+        UStaticMeshComponent* ChunkComponent = ChunkStaticMeshComponents.Pop(false);
+        if (ChunkComponent)
         {
-            StaticMeshComponent->SetMaterial(0, ProceduralDefaultMaterial);
+            ChunkComponent->DestroyComponent();
         }
-        else
+    }
+
+    for (int32 Index = 0; Index < NumComponents; ++Index)
+    {
+        if (ChunkStaticMeshComponents.IsValidIndex(Index) && ChunkStaticMeshComponents[Index] &&
+            !ChunkStaticMeshComponents[Index]->IsPendingKill())
         {
-            for (int32 SectionIdx = 0; SectionIdx < NumSections; ++SectionIdx)
-            {
-                UMaterialInterface* SectionMaterial = ProceduralMeshComponent->GetMaterial(SectionIdx);
-                if (SectionMaterial)
-                {
-                    StaticMeshComponent->SetMaterial(SectionIdx, SectionMaterial);
-                }
-            }
+            continue;
         }
 
-        StaticMeshComponent->SetVisibility(bShowStaticMeshComponent, true);
+        UStaticMeshComponent* ChunkComponent = NewObject<UStaticMeshComponent>(this, NAME_None, RF_Transient);
+        ChunkComponent->SetupAttachment(ProceduralMeshComponent);
+        ChunkComponent->RegisterComponent();
 
-        if (!StaticMeshComponent->GetAttachParent())
+        if (ChunkStaticMeshComponents.IsValidIndex(Index))
         {
-            StaticMeshComponent->AttachToComponent(ProceduralMeshComponent, FAttachmentTransformRules::KeepWorldTransform);
+            ChunkStaticMeshComponents[Index] = ChunkComponent;
+        }
+        else
+        {
+            ChunkStaticMeshComponents.Add(ChunkComponent);
         }
-
-        StaticMeshComponent->MarkRenderStateDirty();
-        StaticMeshComponent->RecreatePhysicsState();
     }
 }
 
-UStaticMesh* AProceduralMeshActor::ConvertProceduralMeshToStaticMesh() 
+void AProceduralMeshActor::GenerateMeshAsync()
 {
-  if (!ProceduralMeshComponent) {
-    return nullptr;
-  }
+    if (RefreshInstancedShape())
+    {
+        return;
+    }
 
-  const int32 NumSections = ProceduralMeshComponent->GetNumSections();
-  if (NumSections == 0) {
-    return nullptr;
-  }
+    const int32 Serial = AsyncGenerationSerial->Increment();
 
-  UStaticMesh* StaticMesh = CreateStaticMeshObject();
-  if (!StaticMesh) {
-    return nullptr;
-  }
+    TUniquePtr<FModelGenMeshBuilder> Builder = IsValid() ? CreateMeshBuilder() : nullptr;
+    if (!Builder)
+    {
+        ClearGeneratedMesh();
+        FinishAsyncMeshGeneration(false);
+        return;
+    }
 
-  if (!BuildStaticMeshGeometryFromProceduralMesh(StaticMesh)) {
-    return nullptr;
-  }
+    bAsyncGenerationPending = true;
+
+    TWeakObjectPtr<AProceduralMeshActor> WeakThis(this);
+    TSharedRef<FThreadSafeCounter, ESPMode::ThreadSafe> SerialCounter = AsyncGenerationSerial;
+    const FModelGenParamsHash ParamsHash = GetShapeParamsHash();
+    const bool bPersist = ShouldPersistMeshData();
+
+    // 生成用的生成器在工作线程上会积累中间数据，另留一份同参数的快照随结果一起交回；只移动不复制，引用计数不跨线程
+    TSharedPtr<FModelGenMeshBuilder> SourceBuilder(CreateMeshBuilder().Release());
+
+    AsyncTask(ENamedThreads::AnyBackgroundThreadNormalTask,
+        [WeakThis, SerialCounter, Serial, ParamsHash, bPersist, Builder = MoveTemp(Builder), SourceBuilder = MoveTemp(SourceBuilder)]() mutable
+        {
+            // 开始前已被取代则不再生成
+            if (SerialCounter->GetValue() != Serial)
+            {
+                return;
+            }
 
-  InitializeStaticMeshRenderData(StaticMesh);
-  SetupBodySetupAndCollision(StaticMesh);
-  StaticMesh->CreateNavCollision(true);
+            FModelGenMeshData MeshData;
+            const bool bSuccess = FModelGenDiskCache::Get().FindOrGenerate(ParamsHash, *Builder, MeshData, bPersist) && MeshData.IsValid();
+            Builder.Reset();
 
-  return StaticMesh;
+            AsyncTask(ENamedThreads::GameThread,
+                [WeakThis, SerialCounter, Serial, bSuccess, MeshData = MoveTemp(MeshData), SourceBuilder = MoveTemp(SourceBuilder)]() mutable
+                {
+                    AProceduralMeshActor* Actor = WeakThis.Get();
+                    if (!Actor || SerialCounter->GetValue() != Serial)
+                    {
+                        return;
+                    }
+
+                    if (bSuccess)
+                    {
+                        Actor->ApplyMeshData(MoveTemp(MeshData), MoveTemp(SourceBuilder));
+                    }
+                    else
+                    {
+                        Actor->ClearGeneratedMesh();
+                    }
+                    Actor->FinishAsyncMeshGeneration(bSuccess);
+                });
+        });
 }
-UStaticMesh* AProceduralMeshActor::CreateStaticMeshObject() const
+
+void AProceduralMeshActor::CancelAsyncMeshGeneration()
 {
-  UStaticMesh* StaticMesh = NewObject<UStaticMesh>(
-      GetTransientPackage(), NAME_None, RF_Public | RF_Transient);
+    AsyncGenerationSerial->Increment();
+    bAsyncGenerationPending = false;
+}
 
-  if (!StaticMesh) {
-    return nullptr;
-  }
-
-  StaticMesh->SetFlags(RF_Public | RF_Transient);
-  StaticMesh->NeverStream = true;
-  StaticMesh->LightMapResolution = 64;
-  StaticMesh->LightMapCoordinateIndex = 0;
-  StaticMesh->LightmapUVDensity = 512.0f;
-  StaticMesh->LODForCollision = 0;
-  StaticMesh->bAllowCPUAccess = true;
-  StaticMesh->bIsBuiltAtRuntime = true;
-  StaticMesh->bGenerateMeshDistanceField = false;
-  StaticMesh->bHasNavigationData = false;
-  StaticMesh->bSupportPhysicalMaterialMasks = false;
-  StaticMesh->bSupportUniformlyDistributedSampling = false;
-  StaticMesh->LpvBiasMultiplier = 1.0f;
-
-  const int32 NumSections = ProceduralMeshComponent ? ProceduralMeshComponent->GetNumSections() : 0;
-  for (int32 SectionIdx = 0; SectionIdx < NumSections; ++SectionIdx)
-  {
-    UMaterialInterface* SectionMaterial = ProceduralMeshComponent->GetMaterial(SectionIdx);
-    FName MaterialSlotName = FName(*FString::Printf(TEXT("MaterialSlot_%d"), SectionIdx));
-    FStaticMaterial NewStaticMaterial(SectionMaterial, MaterialSlotName);
-    NewStaticMaterial.UVChannelData = FMeshUVChannelInfo(1024.f);
-    StaticMesh->StaticMaterials.Add(NewStaticMaterial);
-  }
-
-  return StaticMesh;
+void AProceduralMeshActor::FinishAsyncMeshGeneration(bool bSuccess)
+{
+    bAsyncGenerationPending = false;
+    OnMeshGenerationCompleted.Broadcast(bSuccess);
+}
+
+void AProceduralMeshActor::SetPMCCollisionEnabled(bool bEnable)
+{
+    bGenerateCollision = bEnable;
+    if (ProceduralMeshComponent)
+    {
+        ProceduralMeshComponent->SetCollisionEnabled(
+            bGenerateCollision ? ECollisionEnabled::QueryAndPhysics
+            : ECollisionEnabled::NoCollision);
+
+        for (UProceduralMeshComponent* ChunkComponent : ChunkMeshComponents)
+        {
+            SyncChunkComponentSettings(ChunkComponent);
+        }
+    }
 }
-bool AProceduralMeshActor::BuildMeshDescriptionFromPMC(FMeshDescription& OutMeshDescription, UStaticMesh* StaticMesh) const
+
+void AProceduralMeshActor::SetProceduralMeshVisibility(bool bVisible)
 {
-  if (!ProceduralMeshComponent) {
-    return false;
-  }
-
-  const int32 NumSections = ProceduralMeshComponent->GetNumSections();
-  if (NumSections == 0) {
-    return false;
-  }
-
-  FStaticMeshAttributes Attributes(OutMeshDescription);
-  Attributes.Register();
-  
-  TPolygonGroupAttributesRef<FName> PolygonGroupMaterialSlotNames =
-      Attributes.GetPolygonGroupMaterialSlotNames();
-
-  FMeshDescriptionBuilder MeshDescBuilder;
-  MeshDescBuilder.SetMeshDescription(&OutMeshDescription);
-  MeshDescBuilder.EnablePolyGroups();
-  MeshDescBuilder.SetNumUVLayers(2);
-
-  TMap<FVector, FVertexID> VertexMap;
-
-  for (int32 SectionIdx = 0; SectionIdx < NumSections; ++SectionIdx) {
-    FProcMeshSection* SectionData =
-        ProceduralMeshComponent->GetProcMeshSection(SectionIdx);
-    if (!SectionData || SectionData->ProcVertexBuffer.Num() < 3 ||
-        SectionData->ProcIndexBuffer.Num() < 3) {
-      continue;
-    }
-
-    FName MaterialSlotName = StaticMesh->StaticMaterials[SectionIdx].MaterialSlotName;
-    const FPolygonGroupID PolygonGroup = MeshDescBuilder.AppendPolygonGroup();
-    PolygonGroupMaterialSlotNames.Set(PolygonGroup, MaterialSlotName);
-
-    TArray<FVertexInstanceID> VertexInstanceIDs;
-
-    for (const FProcMeshVertex& ProcVertex : SectionData->ProcVertexBuffer) {
-      FVertexID VertexID;
-
-      if (FVertexID* FoundID = VertexMap.Find(ProcVertex.Position)) {
-        VertexID = *FoundID;
-      } else {
-        VertexID = MeshDescBuilder.AppendVertex(ProcVertex.Position);
-        VertexMap.Add(ProcVertex.Position, VertexID);
-      }
-      
-      FVertexInstanceID InstanceID = MeshDescBuilder.AppendInstance(VertexID);
-      MeshDescBuilder.SetInstanceNormal(InstanceID, ProcVertex.Normal);
-      MeshDescBuilder.SetInstanceUV(InstanceID, ProcVertex.UV0, 0);
-      MeshDescBuilder.SetInstanceUV(InstanceID, ProcVertex.UV0, 1);
-      MeshDescBuilder.SetInstanceColor(InstanceID, FVector4(ProcVertex.Color));
-      VertexInstanceIDs.Add(InstanceID);
-    }
-
-    for (int32 i = 0; i < SectionData->ProcIndexBuffer.Num(); i += 3) {
-      if (i + 2 >= SectionData->ProcIndexBuffer.Num()) {
-        break;
-      }
-
-      int32 Index1 = SectionData->ProcIndexBuffer[i + 0];
-      int32 Index2 = SectionData->ProcIndexBuffer[i + 1];
-      int32 Index3 = SectionData->ProcIndexBuffer[i + 2];
-      
-      if (Index1 >= VertexInstanceIDs.Num() ||
-          Index2 >= VertexInstanceIDs.Num() ||
-          Index3 >= VertexInstanceIDs.Num()) {
-        continue;
-      }
-      
-      FVertexInstanceID V1 = VertexInstanceIDs[Index1];
-      FVertexInstanceID V2 = VertexInstanceIDs[Index2];
-      FVertexInstanceID V3 = VertexInstanceIDs[Index3];
-
-      MeshDescBuilder.AppendTriangle(V1, V2, V3, PolygonGroup);
-    }
-  }
-
-  return OutMeshDescription.Vertices().Num() > 0;
+    if (ProceduralMeshComponent)
+    {
+        ProceduralMeshComponent->SetVisibility(bVisible);
+
+        for (UProceduralMeshComponent* ChunkComponent : ChunkMeshComponents)
+        {
+            SyncChunkComponentSettings(ChunkComponent);
+        }
+    }
 }
 
-void AProceduralMeshActor::GenerateTangentsManually(FMeshDescription& MeshDescription) const
+void AProceduralMeshActor::UpdateStaticMeshComponent()
 {
-    FStaticMeshAttributes Attributes(MeshDescription);
-    
-    TVertexAttributesRef<FVector> VertexPositions = Attributes.GetVertexPositions();
-    TVertexInstanceAttributesRef<FVector> VertexInstanceNormals = Attributes.GetVertexInstanceNormals();
-    TVertexInstanceAttributesRef<FVector> VertexInstanceTangents = Attributes.GetVertexInstanceTangents();
-    TVertexInstanceAttributesRef<float> VertexInstanceBinormalSigns = Attributes.GetVertexInstanceBinormalSigns();
-    TVertexInstanceAttributesRef<FVector2D> VertexInstanceUVs = Attributes.GetVertexInstanceUVs();
-    
-    for (const FPolygonID PolygonID : MeshDescription.Polygons().GetElementIDs())
-    {
-        const TArray<FTriangleID>& TriangleIDs = MeshDescription.GetPolygonTriangleIDs(PolygonID);
-        
-        for (const FTriangleID TriangleID : TriangleIDs)
+    if (!StaticMeshComponent)
+    {
+        return;
+    }
+
+    if (!ProceduralMeshComponent)
+    {
+        return;
+    }
+
+    // 分块输出时每个分块各自转换为一个 StaticMesh，保留分块的包围盒以便剔除
+    if (ChunkMeshComponents.Num() > 0)
+    {
+        SetNumChunkStaticMeshComponents(ChunkMeshComponents.Num());
+
+        for (int32 ChunkIndex = 0; ChunkIndex < GetNumMeshChunks(); ++ChunkIndex)
         {
-            TArrayView<const FVertexInstanceID> VertexInstances = MeshDescription.GetTriangleVertexInstances(TriangleID);
-            
-            if (VertexInstances.Num() != 3)
+            UProceduralMeshComponent* Source = GetMeshChunkComponent(ChunkIndex);
+            UStaticMeshComponent* Target = (ChunkIndex == 0) ? StaticMeshComponent : ChunkStaticMeshComponents[ChunkIndex - 1];
+            if (!Source || !Target)
             {
                 continue;
             }
 
-            const FVertexInstanceID Instance0 = VertexInstances[0];
-            const FVertexInstanceID Instance1 = VertexInstances[1];
-            const FVertexInstanceID Instance2 = VertexInstances[2];
-            
-            const FVector P0 = VertexPositions[MeshDescription.GetVertexInstanceVertex(Instance0)];
-            const FVector P1 = VertexPositions[MeshDescription.GetVertexInstanceVertex(Instance1)];
-            const FVector P2 = VertexPositions[MeshDescription.GetVertexInstanceVertex(Instance2)];
-            
-            const FVector2D UV0 = VertexInstanceUVs.Get(Instance0, 0);
-            const FVector2D UV1 = VertexInstanceUVs.Get(Instance1, 0);
-            const FVector2D UV2 = VertexInstanceUVs.Get(Instance2, 0);
-            
-            const FVector Edge1 = P1 - P0;
-            const FVector Edge2 = P2 - P0;
-            
-            const FVector2D DeltaUV1 = UV1 - UV0;
-            const FVector2D DeltaUV2 = UV2 - UV0;
-            
-            float Det = (DeltaUV1.X * DeltaUV2.Y - DeltaUV1.Y * DeltaUV2.X);
-            
-            if (FMath::IsNearlyZero(Det))
+            UStaticMesh* ConvertedMesh = ConvertMeshComponentsToStaticMesh(MakeArrayView(&Source, 1), true);
+            if (ConvertedMesh)
             {
-                Det = 1.0f; 
+                ApplyConvertedStaticMesh(Target, ConvertedMesh, Source);
             }
-            
-            const float InvDet = 1.0f / Det;
-            
-            FVector FaceTangent;
-            FaceTangent.X = InvDet * (DeltaUV2.Y * Edge1.X - DeltaUV1.Y * Edge2.X);
-            FaceTangent.Y = InvDet * (DeltaUV2.Y * Edge1.Y - DeltaUV1.Y * Edge2.Y);
-            FaceTangent.Z = InvDet * (DeltaUV2.Y * Edge1.Z - DeltaUV1.Y * Edge2.Z);
-            FaceTangent.Normalize();
-            
-            const FVertexInstanceID CurrentInstances[3] = { Instance0, Instance1, Instance2 };
-            
-            for (int i = 0; i < 3; i++)
+            else
             {
-                FVertexInstanceID CurrentID = CurrentInstances[i];
-                const FVector Normal = VertexInstanceNormals[CurrentID];
-                
-                FVector OrthoTangent = (FaceTangent - Normal * FVector::DotProduct(Normal, FaceTangent));
-                OrthoTangent.Normalize();
-                
-                if (OrthoTangent.IsZero())
-                {
-                    FVector TangentX = FVector::CrossProduct(Normal, FVector::UpVector);
-                    if (TangentX.IsZero()) TangentX = FVector::CrossProduct(Normal, FVector::RightVector);
-                    OrthoTangent = TangentX.GetSafeNormal();
-                }
-                
-                VertexInstanceTangents[CurrentID] = OrthoTangent;
-                
-                FVector Bitangent = FVector::CrossProduct(Normal, OrthoTangent);
-                float Sign = (FVector::DotProduct(FVector::CrossProduct(Normal, FaceTangent), Bitangent) < 0.0f) ? -1.0f : 1.0f;
-                VertexInstanceBinormalSigns[CurrentID] = Sign;
+                Target->SetStaticMesh(nullptr);
             }
         }
+        return;
     }
-}
 
-bool AProceduralMeshActor::BuildStaticMeshGeometryFromProceduralMesh(UStaticMesh* StaticMesh) const
-{
-  if (!StaticMesh) {
-    return false;
-  }
-
-  FMeshDescription MeshDescription;
-  
-  FStaticMeshAttributes Attributes(MeshDescription);
-  Attributes.Register();
-
-  if (!BuildMeshDescriptionFromPMC(MeshDescription, StaticMesh)) {
-    return false;
-  }
-
-  GenerateTangentsManually(MeshDescription);
-  TArray<const FMeshDescription*> MeshDescPtrs;
-  MeshDescPtrs.Emplace(&MeshDescription);
-  
-  UStaticMesh::FBuildMeshDescriptionsParams BuildParams;
-  BuildParams.bUseHashAsGuid = true;
-  BuildParams.bMarkPackageDirty = true;
-  BuildParams.bBuildSimpleCollision = false;
-  BuildParams.bCommitMeshDescription = true;
-  
-  StaticMesh->BuildFromMeshDescriptions(MeshDescPtrs, BuildParams);
-
-  return true;
-}
-bool AProceduralMeshActor::InitializeStaticMeshRenderData(UStaticMesh* StaticMesh) const
-{
-  if (!StaticMesh || !StaticMesh->RenderData || StaticMesh->RenderData->LODResources.Num() < 1)
-  {
-    return false;
-  }
-
-  StaticMesh->NeverStream = true; 
-  StaticMesh->bIgnoreStreamingMipBias = true;
-  StaticMesh->LightMapCoordinateIndex = 0;
+    SetNumChunkStaticMeshComponents(0);
 
-  StaticMesh->RenderData->ScreenSize[0].Default = 0.0f;
-  StaticMesh->RenderData->ScreenSize[1].Default = 0.0f;
+    const int32 NumSections = ProceduralMeshComponent->GetNumSections();
+    if (NumSections == 0)
+    {
+        return;
+    }
+    UStaticMesh* ConvertedMesh = ConvertProceduralMeshToStaticMesh();
+    if (ConvertedMesh)
+    {
+        ApplyConvertedStaticMesh(StaticMeshComponent, ConvertedMesh, ProceduralMeshComponent);
+    }
+}
 
-  StaticMesh->CalculateExtendedBounds();
-  if (StaticMesh->ExtendedBounds.SphereRadius < 10.0f)
-  {
-    StaticMesh->ExtendedBounds = FBoxSphereBounds(FVector::ZeroVector, FVector(500.0f), 1000.0f);
-    if (StaticMesh->RenderData) StaticMesh->RenderData->Bounds = StaticMesh->ExtendedBounds;
-  }
+void AProceduralMeshActor::ApplyConvertedStaticMesh(UStaticMeshComponent* Target, UStaticMesh* ConvertedMesh, UProceduralMeshComponent* Source)
+{
+    Target->SetStaticMesh(ConvertedMesh);
+    Target->StreamingDistanceMultiplier = 10.0f;
 
-  const float ForcedUVDensity = 1024.0f;
-  if (StaticMesh->StaticMaterials.Num() > 0)
-  {
-    for (FStaticMaterial& Mat : StaticMesh->StaticMaterials)
+    if (ConvertedMesh->BodySetup)
     {
-      Mat.UVChannelData.LocalUVDensities[0] = ForcedUVDensity;
-      Mat.UVChannelData.LocalUVDensities[1] = ForcedUVDensity;
-      Mat.UVChannelData.LocalUVDensities[2] = ForcedUVDensity;
-      Mat.UVChannelData.LocalUVDensities[3] = ForcedUVDensity;
+        FName ProfileName = ConvertedMesh->BodySetup->DefaultInstance.GetCollisionProfileName();
+        if (!ProfileName.IsNone())
+        {
+            Target->SetCollisionProfileName(ProfileName);
+        }
+        else
+        {
+            Target->SetCollisionEnabled(ConvertedMesh->BodySetup->DefaultInstance.GetCollisionEnabled());
+            Target->SetCollisionObjectType(ConvertedMesh->BodySetup->DefaultInstance.GetObjectType());
+        }
     }
-  }
 
-  FStaticMeshLODResources& LODResources = StaticMesh->RenderData->LODResources[0];
-  LODResources.bHasColorVertexData = true;
+    if (StaticMeshMaterial)
+    {
+        Target->SetMaterial(0, StaticMeshMaterial);
+    }
+    else if (ProceduralDefaultMaterial)
+    {
+        Target->SetMaterial(0, ProceduralDefaultMaterial);
+    }
+    else
+    {
+        const int32 NumSections = Source->GetNumSections();
+        for (int32 SectionIdx = 0; SectionIdx < NumSections; ++SectionIdx)
+        {
+            UMaterialInterface* SectionMaterial = Source->GetMaterial(SectionIdx);
+            if (SectionMaterial)
+            {
+                Target->SetMaterial(SectionIdx, SectionMaterial);
+            }
+        }
+    }
 
-  StaticMesh->InitResources();
+    Target->SetVisibility(bShowStaticMeshComponent, true);
 
-  StaticMesh->bForceMiplevelsToBeResident = true;
-  StaticMesh->SetForceMipLevelsToBeResident(30.0f, 0);
+    if (!Target->GetAttachParent())
+    {
+        Target->AttachToComponent(ProceduralMeshComponent, FAttachmentTransformRules::KeepWorldTransform);
+    }
 
-  return true;
+    Target->MarkRenderStateDirty();
+    Target->RecreatePhysicsState();
 }
 
-void AProceduralMeshActor::SetupBodySetupProperties(UBodySetup* BodySetup) const
+void AProceduralMeshActor::GetSharedStaticMeshSettings(FModelGenStaticMeshSettings& OutSettings) const
 {
-  if (!BodySetup) {
-    return;
-  }
-  
-  BodySetup->CollisionTraceFlag = CTF_UseComplexAsSimple;
-  BodySetup->bDoubleSidedGeometry = false;
-  BodySetup->bMeshCollideAll = true;
-  
-  if (ProceduralMeshComponent && ProceduralMeshComponent->ProcMeshBodySetup && ProceduralMeshComponent->ProcMeshBodySetup->PhysMaterial)
-  {
-    BodySetup->PhysMaterial = ProceduralMeshComponent->ProcMeshBodySetup->PhysMaterial;
-  }
-  
-  BodySetup->DefaultInstance.SetCollisionProfileName(TEXT("BlockAll"));
-  BodySetup->DefaultInstance.SetEnableGravity(false);
-  BodySetup->DefaultInstance.bUseCCD = false;
-}
-bool AProceduralMeshActor::GenerateSimpleCollision(UBodySetup* BodySetup, UStaticMesh* StaticMesh) const
-{
-  if (!BodySetup || !ProceduralMeshComponent) {
-    return false;
-  }
-
-  int32 HullCount = 8;
-  int32 MaxHullVerts = 16;
-  uint32 HullPrecision = 100000;
-  
-  bool bSuccess = FModelGenConvexDecomp::GenerateConvexHulls(
-    ProceduralMeshComponent,
-    BodySetup,
-    HullCount,
-    MaxHullVerts,
-    HullPrecision);
-  
-  if (bSuccess && BodySetup->AggGeom.ConvexElems.Num() > 0)
-  {
-    return true;
-  }
-  else
-  {
-    if (StaticMesh && StaticMesh->RenderData.IsValid())
-    {
-      const FBoxSphereBounds& Bounds = StaticMesh->RenderData->Bounds;
-      if (Bounds.BoxExtent.X > 0.0f && Bounds.BoxExtent.Y > 0.0f && Bounds.BoxExtent.Z > 0.0f)
-      {
-        FKBoxElem BoxElem;
-        BoxElem.Center = Bounds.Origin;
-        BoxElem.X = Bounds.BoxExtent.X * 2.0f;
-        BoxElem.Y = Bounds.BoxExtent.Y * 2.0f;
-        BoxElem.Z = Bounds.BoxExtent.Z * 2.0f;
-        BodySetup->AggGeom.BoxElems.Add(BoxElem);
-        return true;
-      }
-    }
-  }
-  
-  return false;
+    UMaterialInterface* Material = ProceduralMeshComponent ? ProceduralMeshComponent->GetMaterial(0) : nullptr;
+    OutSettings.SectionMaterials.Add(Material ? Material : ProceduralDefaultMaterial);
+
+    if (ProceduralMeshComponent && ProceduralMeshComponent->ProcMeshBodySetup)
+    {
+        OutSettings.PhysMaterial = ProceduralMeshComponent->ProcMeshBodySetup->PhysMaterial;
+    }
 }
 
-// 辅助函数：手动创建所有 ConvexMesh
-int32 AProceduralMeshActor::CreateConvexMeshesManually(UBodySetup* BodySetup, IPhysXCookingModule* PhysXCookingModule) const
+void AProceduralMeshActor::SetupStaticMeshSettings(FModelGenStaticMeshSettings& Settings, bool bAllowAsyncCollision)
 {
-  if (!BodySetup || !PhysXCookingModule || !PhysXCookingModule->GetPhysXCooking()) {
-    return 0;
-  }
-
-  if (BodySetup->AggGeom.GetElementCount() == 0) {
-    return 0;
-  }
-
-  // 确保所有 ConvexElem 都调用了 UpdateElemBox() 并设置了有效的 Transform
-  int32 ValidConvexElemCount = 0;
-  for (FKConvexElem& ConvexElem : BodySetup->AggGeom.ConvexElems)
-  {
-    if (ConvexElem.VertexData.Num() < 4)
-    {
-      continue;
-    }
-    
-    bool bHasValidVertices = true;
-    for (const FVector& Vert : ConvexElem.VertexData)
-    {
-      if (Vert.ContainsNaN() || 
-          !FMath::IsFinite(Vert.X) || 
-          !FMath::IsFinite(Vert.Y) || 
-          !FMath::IsFinite(Vert.Z))
-      {
-        bHasValidVertices = false;
-        break;
-      }
-    }
-    
-    if (!bHasValidVertices)
-    {
-      continue;
-    }
-    
-    ConvexElem.UpdateElemBox();
-    if (!ConvexElem.GetTransform().IsValid())
-    {
-      ConvexElem.SetTransform(FTransform::Identity);
-    }
-    ConvexElem.BakeTransformToVerts();
-    ValidConvexElemCount++;
-  }
-  
-  BodySetup->bNeverNeedsCookedCollisionData = false;
-  BodySetup->InvalidatePhysicsData();
-  
-  int32 ValidConvexMeshCount = 0;
-  for (int32 ElemIdx = 0; ElemIdx < BodySetup->AggGeom.ConvexElems.Num(); ++ElemIdx)
-  {
-    FKConvexElem& ConvexElem = BodySetup->AggGeom.ConvexElems[ElemIdx];
-    
-    if (ConvexElem.VertexData.Num() < 4)
-    {
-      continue;
-    }
-    
-    bool bHasValidVertices = true;
-    for (const FVector& Vert : ConvexElem.VertexData)
-    {
-      if (Vert.ContainsNaN() || 
-          !FMath::IsFinite(Vert.X) || 
-          !FMath::IsFinite(Vert.Y) || 
-          !FMath::IsFinite(Vert.Z))
-      {
-        bHasValidVertices = false;
-        break;
-      }
-    }
-    
-    if (!bHasValidVertices)
-    {
-      continue;
-    }
-    
-    ConvexElem.UpdateElemBox();
-    if (!ConvexElem.GetTransform().IsValid())
-    {
-      ConvexElem.SetTransform(FTransform::Identity);
-    }
-    
-    if (!ConvexElem.GetTransform().Equals(FTransform::Identity))
-    {
-      ConvexElem.BakeTransformToVerts();
-    }
-    physx::PxConvexMesh* NewConvexMesh = nullptr;
-    EPhysXMeshCookFlags CookFlags = EPhysXMeshCookFlags::Default;
-    
-    EPhysXCookingResult Result = PhysXCookingModule->GetPhysXCooking()->CreateConvex(
-      FName(FPlatformProperties::GetPhysicsFormat()),
-      CookFlags,
-      ConvexElem.VertexData,
-      NewConvexMesh
-    );
-    
-    switch (Result)
-    {
-    case EPhysXCookingResult::Succeeded:
-      ConvexElem.SetConvexMesh(NewConvexMesh);
-      ValidConvexMeshCount++;
-      break;
-    case EPhysXCookingResult::SucceededWithInflation:
-      ConvexElem.SetConvexMesh(NewConvexMesh);
-      ValidConvexMeshCount++;
-      break;
-    case EPhysXCookingResult::Failed:
-      break;
-    default:
-      break;
-    }
-  }
-  
-  BodySetup->bCreatedPhysicsMeshes = true;
-  
-  return ValidConvexMeshCount;
+    if (ProceduralMeshComponent->ProcMeshBodySetup)
+    {
+        Settings.PhysMaterial = ProceduralMeshComponent->ProcMeshBodySetup->PhysMaterial;
+    }
+
+    // 异步烘焙时先以包围盒碰撞顶替，BodySetup 替换后重建仍在使用该网格的组件的物理状态
+    Settings.bAsyncCollision = bAllowAsyncCollision && bUseAsyncCooking;
+    if (Settings.bAsyncCollision)
+    {
+        TWeakObjectPtr<AProceduralMeshActor> WeakThis(this);
+        Settings.OnAsyncCollisionReady = [WeakThis](UStaticMesh* Mesh)
+        {
+            AProceduralMeshActor* Actor = WeakThis.Get();
+            if (!Actor)
+            {
+                return;
+            }
+
+            if (Actor->StaticMeshComponent && Actor->StaticMeshComponent->GetStaticMesh() == Mesh)
+            {
+                Actor->StaticMeshComponent->RecreatePhysicsState();
+            }
+
+            for (UStaticMeshComponent* ChunkComponent : Actor->ChunkStaticMeshComponents)
+            {
+                if (ChunkComponent && ChunkComponent->GetStaticMesh() == Mesh)
+                {
+                    ChunkComponent->RecreatePhysicsState();
+                }
+            }
+        };
+    }
 }
-bool AProceduralMeshActor::ExtractTriMeshDataFromPMC(TArray<FVector>& OutVertices, TArray<FTriIndices>& OutIndices) const
+
+UStaticMesh* AProceduralMeshActor::ConvertMeshComponentsToStaticMesh(TArrayView<UProceduralMeshComponent* const> Sources, bool bAllowAsyncCollision)
 {
-  if (!ProceduralMeshComponent) {
-    return false;
-  }
-
-  OutVertices.Empty();
-  OutIndices.Empty();
-  
-  int32 TotalVertices = 0;
-  int32 TotalSkippedTriangles = 0;
-  
-  for (int32 SectionIdx = 0; SectionIdx < ProceduralMeshComponent->GetNumSections(); ++SectionIdx)
-  {
-    FProcMeshSection* SectionData = ProceduralMeshComponent->GetProcMeshSection(SectionIdx);
-    if (!SectionData) continue;
-    
-    const int32 SectionVertexOffset = TotalVertices;
-    const int32 SectionVertexCount = SectionData->ProcVertexBuffer.Num();
-    
-    for (const FProcMeshVertex& ProcVertex : SectionData->ProcVertexBuffer)
-    {
-      OutVertices.Add(ProcVertex.Position);
-    }
-    const int32 NumSectionIndices = SectionData->ProcIndexBuffer.Num();
-    if (NumSectionIndices % 3 == 0 && SectionVertexCount > 0)
-    {
-      for (int32 Idx = 0; Idx < NumSectionIndices - 2; Idx += 3)
-      {
-        if (Idx < 0 || Idx + 2 >= NumSectionIndices)
-        {
-          break;
-        }
-        
-        uint32 LocalV0 = SectionData->ProcIndexBuffer[Idx];
-        uint32 LocalV1 = SectionData->ProcIndexBuffer[Idx + 1];
-        uint32 LocalV2 = SectionData->ProcIndexBuffer[Idx + 2];
-        
-        if (LocalV0 >= static_cast<uint32>(SectionVertexCount) || 
-            LocalV1 >= static_cast<uint32>(SectionVertexCount) || 
-            LocalV2 >= static_cast<uint32>(SectionVertexCount))
-        {
-          TotalSkippedTriangles++;
-          continue;
-        }
-        
-        const uint32 V0 = SectionVertexOffset + LocalV0;
-        const uint32 V1 = SectionVertexOffset + LocalV1;
-        const uint32 V2 = SectionVertexOffset + LocalV2;
-        
-        if (V0 < static_cast<uint32>(OutVertices.Num()) && 
-            V1 < static_cast<uint32>(OutVertices.Num()) && 
-            V2 < static_cast<uint32>(OutVertices.Num()))
-        {
-          FTriIndices Tri;
-          Tri.v0 = V0;
-          Tri.v1 = V1;
-          Tri.v2 = V2;
-          OutIndices.Add(Tri);
-        }
-        else
+    TArray<FModelGenMeshData> Sections;
+    FModelGenStaticMeshSettings Settings;
+
+    for (UProceduralMeshComponent* Source : Sources)
+    {
+        TArray<FModelGenMeshData> SourceSections;
+        FModelGenStaticMeshConverter::ExtractSectionsFromProceduralMesh(Source, SourceSections);
+
+        for (int32 SectionIdx = 0; SectionIdx < SourceSections.Num(); ++SectionIdx)
         {
-          TotalSkippedTriangles++;
+            if (SourceSections[SectionIdx].IsValid())
+            {
+                Sections.Add(MoveTemp(SourceSections[SectionIdx]));
+                Settings.SectionMaterials.Add(Source->GetMaterial(SectionIdx));
+            }
         }
-      }
-    }
-    
-    TotalVertices = OutVertices.Num();
-  }
-  
-  if (OutVertices.Num() > 0 && OutIndices.Num() > 0)
-  {
-    return true;
-  }
-  
-  return false;
+    }
+
+    if (Sections.Num() == 0)
+    {
+        return nullptr;
+    }
+
+    SetupStaticMeshSettings(Settings, bAllowAsyncCollision);
+    return FModelGenStaticMeshConverter::CreateStaticMesh(Sections, Settings);
 }
 
-// 辅助函数：从 RenderData 提取 TriMesh 数据
-bool AProceduralMeshActor::ExtractTriMeshDataFromRenderData(UStaticMesh* StaticMesh, TArray<FVector>& OutVertices, TArray<FTriIndices>& OutIndices) const
+UStaticMesh* AProceduralMeshActor::ConvertProceduralMeshToStaticMesh()
 {
-  if (!StaticMesh || !StaticMesh->RenderData || StaticMesh->RenderData->LODResources.Num() == 0) {
-    return false;
-  }
-
-  OutVertices.Empty();
-  OutIndices.Empty();
-  
-  const FStaticMeshLODResources& LODResource = StaticMesh->RenderData->LODResources[0];
-  const FPositionVertexBuffer& PositionVertexBuffer = LODResource.VertexBuffers.PositionVertexBuffer;
-  const FRawStaticIndexBuffer& IndexBuffer = LODResource.IndexBuffer;
-
-  // 提取顶点
-  const int32 NumVertices = PositionVertexBuffer.GetNumVertices();
-  if (NumVertices > 0)
-  {
-    OutVertices.Reserve(NumVertices);
-    for (int32 VertIdx = 0; VertIdx < NumVertices; ++VertIdx)
-    {
-      if (VertIdx >= 0 && VertIdx < NumVertices)
-      {
-        OutVertices.Add(PositionVertexBuffer.VertexPosition(VertIdx));
-      }
-      else
-      {
-        break;
-      }
-    }
-
-    // 提取索引并转换为 FTriIndices 格式
-    const int32 NumIndices = IndexBuffer.GetNumIndices();
-    
-    if (NumIndices > 0 && NumIndices % 3 == 0)
-    {
-      OutIndices.Reserve(NumIndices / 3);
-      
-      int32 SkippedTriangles = 0;
-      for (int32 Idx = 0; Idx < NumIndices - 2; Idx += 3)
-      {
-        if (Idx < 0 || Idx + 2 >= NumIndices)
-        {
-          break;
-        }
-        
-        uint32 V0 = IndexBuffer.GetIndex(Idx);
-        uint32 V1 = IndexBuffer.GetIndex(Idx + 1);
-        uint32 V2 = IndexBuffer.GetIndex(Idx + 2);
-        
-        if (V0 >= static_cast<uint32>(NumVertices) || 
-            V1 >= static_cast<uint32>(NumVertices) || 
-            V2 >= static_cast<uint32>(NumVertices))
-        {
-          SkippedTriangles++;
-          continue;
-        }
-        
-        FTriIndices Tri;
-        Tri.v0 = V0;
-        Tri.v1 = V1;
-        Tri.v2 = V2;
-        OutIndices.Add(Tri);
-      }
-      
-      if (OutIndices.Num() > 0)
-      {
-        return true;
-      }
-    }
-  }
-  
-  return false;
+    return ConvertToStaticMesh(true);
 }
 
-bool AProceduralMeshActor::GenerateComplexCollision(UBodySetup* BodySetup, IPhysXCookingModule* PhysXCookingModule) const
+UStaticMesh* AProceduralMeshActor::ConvertToStaticMesh(bool bAllowAsyncCollision)
 {
-  if (!BodySetup) {
-    return false;
-  }
-
-  if (BodySetup->TriMeshes.Num() > 0)
-  {
-    BodySetup->TriMeshes.Empty();
-  }
-  
-  TArray<FVector> NewVertices;
-  TArray<FTriIndices> NewIndices;
-  
-  if (ExtractTriMeshDataFromPMC(NewVertices, NewIndices))
-  {
-    if (NewVertices.Num() > 0 && NewIndices.Num() > 0)
-    {
-      if (!PhysXCookingModule)
-      {
-        PhysXCookingModule = GetPhysXCookingModule();
-      }
-      
-      if (PhysXCookingModule && PhysXCookingModule->GetPhysXCooking())
-      {
-        BodySetup->TriMeshes.AddZeroed();
-
-        EPhysXMeshCookFlags RuntimeCookFlags = EPhysXMeshCookFlags::Default;
-        if (UPhysicsSettings::Get()->bSuppressFaceRemapTable)
+    if (!ProceduralMeshComponent)
+    {
+        return nullptr;
+    }
+
+    // 分块输出合并为单个网格时每个分块各占一个分段，分块结构保留在网格分段中
+    if (ChunkMeshComponents.Num() > 0)
+    {
+        TArray<UProceduralMeshComponent*> Sources;
+        for (int32 ChunkIndex = 0; ChunkIndex < GetNumMeshChunks(); ++ChunkIndex)
         {
-          RuntimeCookFlags |= EPhysXMeshCookFlags::SuppressFaceRemapTable;
+            if (UProceduralMeshComponent* Source = GetMeshChunkComponent(ChunkIndex))
+            {
+                Sources.Add(Source);
+            }
         }
+        return ConvertMeshComponentsToStaticMesh(Sources, bAllowAsyncCollision);
+    }
 
-        TArray<uint16> MaterialIndices;
-        MaterialIndices.AddZeroed(NewIndices.Num());
+    const int32 NumSections = ProceduralMeshComponent->GetNumSections();
+    if (NumSections == 0)
+    {
+        return nullptr;
+    }
 
-        const bool bError = !PhysXCookingModule->GetPhysXCooking()->CreateTriMesh(
-          FName(FPlatformProperties::GetPhysicsFormat()),
-          RuntimeCookFlags,
-          NewVertices,
-          NewIndices,
-          MaterialIndices,
-          true,
-          BodySetup->TriMeshes[0]);
+    // 组件内容仍是最近一次生成的结果时直接使用生成器输出，避免从 PMC 分段复制回读
+    TArray<FModelGenMeshData> Sections;
+    FProcMeshSection* Section = ProceduralMeshComponent->GetProcMeshSection(0);
+    const bool bUseLastMeshData = NumSections == 1 && LastMeshData.IsValid() && Section &&
+        LastMeshData->HasSameTopology(Section, Section->bEnableCollision);
+    if (!bUseLastMeshData)
+    {
+        FModelGenStaticMeshConverter::ExtractSectionsFromProceduralMesh(ProceduralMeshComponent, Sections);
+    }
 
-        if (!bError)
-        {
-          BodySetup->bCreatedPhysicsMeshes = true;
-          return true;
-        }
-        else
+    FModelGenStaticMeshSettings Settings;
+    Settings.SectionMaterials.Reserve(NumSections);
+    for (int32 SectionIdx = 0; SectionIdx < NumSections; ++SectionIdx)
+    {
+        Settings.SectionMaterials.Add(ProceduralMeshComponent->GetMaterial(SectionIdx));
+    }
+
+    SetupStaticMeshSettings(Settings, bAllowAsyncCollision);
+
+    if (bUseLastMeshData)
+    {
+        // 解析碰撞与各级 LOD 都取自产生 LastMeshData 的参数快照，而不是当前参数，避免 LOD0 与低级 LOD 形状不一致
+        TArray<FModelGenMeshData> LODMeshes;
+        if (LastMeshBuilder)
         {
-          BodySetup->TriMeshes.Empty();
+            LastMeshBuilder->GenerateSimpleCollision(Settings.SimpleCollision);
+            LastMeshBuilder->GenerateLODs(LastMeshData->Triangles.Num() / 3, StaticMeshLODCount, LODMeshes);
         }
-      }
+
+        return FModelGenStaticMeshConverter::CreateStaticMesh(*LastMeshData, Settings, LODMeshes);
     }
-  }
-  
-  return false;
-}
 
-void AProceduralMeshActor::LogCollisionStatistics(UBodySetup* BodySetup, UStaticMesh* StaticMesh) const
-{
-}
-void AProceduralMeshActor::SetupBodySetupAndCollision(UStaticMesh* StaticMesh) const
-{
-  if (!StaticMesh) {
-    return;
-  }
-
-  StaticMesh->CreateBodySetup();
-  UBodySetup* NewBodySetup = StaticMesh->BodySetup;
-  if (!NewBodySetup)
-  {
-    return;
-  }
-
-  GenerateSimpleCollision(NewBodySetup, StaticMesh);
-  SetupBodySetupProperties(NewBodySetup);
-
-  IPhysXCookingModule* PhysXCookingModule = GetPhysXCookingModule();
-  if (NewBodySetup->AggGeom.GetElementCount() > 0)
-  {
-    CreateConvexMeshesManually(NewBodySetup, PhysXCookingModule);
-  }
-  
-  TArray<FVector> NewVertices;
-  TArray<FTriIndices> NewIndices;
-  bool bDataFromPMC = ExtractTriMeshDataFromPMC(NewVertices, NewIndices);
-  if (!bDataFromPMC)
-  {
-    ExtractTriMeshDataFromRenderData(StaticMesh, NewVertices, NewIndices);
-  }
-  
-  if (NewVertices.Num() > 0 && NewIndices.Num() > 0)
-  {
-    if (!PhysXCookingModule)
-    {
-      PhysXCookingModule = GetPhysXCookingModule();
-    }
-    
-    if (PhysXCookingModule && PhysXCookingModule->GetPhysXCooking())
-    {
-      NewBodySetup->TriMeshes.AddZeroed();
-
-      EPhysXMeshCookFlags RuntimeCookFlags = EPhysXMeshCookFlags::Default;
-      if (UPhysicsSettings::Get()->bSuppressFaceRemapTable)
-      {
-        RuntimeCookFlags |= EPhysXMeshCookFlags::SuppressFaceRemapTable;
-      }
-
-      TArray<uint16> MaterialIndices;
-      MaterialIndices.AddZeroed(NewIndices.Num());
-
-      const bool bError = !PhysXCookingModule->GetPhysXCooking()->CreateTriMesh(
-        FName(FPlatformProperties::GetPhysicsFormat()),
-        RuntimeCookFlags,
-        NewVertices,
-        NewIndices,
-        MaterialIndices,
-        true,
-        NewBodySetup->TriMeshes[0]);
-
-      if (!bError)
-      {
-        NewBodySetup->bCreatedPhysicsMeshes = true;
-      }
-      else
-      {
-        NewBodySetup->TriMeshes.Empty();
-      }
-    }
-  }
-  
-  LogCollisionStatistics(NewBodySetup, StaticMesh);
+    return FModelGenStaticMeshConverter::CreateStaticMesh(Sections, Settings);
 }
@@ -11,7 +11,10 @@ APyramid::APyramid()
 
 void APyramid::GenerateMesh()
 {
-    TryGenerateMeshInternal();
+    if (!TryGenerateMeshInternal())
+    {
+        ClearGeneratedMesh();
+    }
 }
 
 bool APyramid::TryGenerateMeshInternal()
@@ -21,21 +24,19 @@ bool APyramid::TryGenerateMeshInternal()
         return false;
     }
 
-    FPyramidBuilder Builder(*this);
-    FModelGenMeshData MeshData;
-
-    if (!Builder.Generate(MeshData))
+    if (RefreshInstancedShape())
     {
-        return false;
+        return true;
     }
 
-    if (!MeshData.IsValid())
-    {
-        return false;
-    }
+    const FPyramidParams Params = GetParams();
+    FPyramidBuilder Builder(Params);
+    return GenerateAndApplyMesh(Builder, Params);
+}
 
-    MeshData.ToProceduralMesh(GetProceduralMesh(), 0);
-    return true;
+TUniquePtr<FModelGenMeshBuilder> APyramid::CreateMeshBuilder() const
+{
+    return MakeUnique<FPyramidBuilder>(GetParams());
 }
 
 void APyramid::GeneratePyramid(float InBaseRadius, float InHeight, int32 InSides)
@@ -59,40 +60,40 @@ void APyramid::GeneratePyramid(float InBaseRadius, float InHeight, int32 InSides
     }
 }
 
+FPyramidParams APyramid::GetParams() const
+{
+    FPyramidParams Params;
+    Params.BaseRadius = BaseRadius;
+    Params.Height = Height;
+    Params.Sides = Sides;
+    Params.BevelRadius = BevelRadius;
+    Params.bSmoothSides = bSmoothSides;
+    return Params;
+}
+
+FModelGenParamsHash APyramid::GetShapeParamsHash() const
+{
+    return FModelGenParamsHash::Compute(GetParams());
+}
+
 bool APyramid::IsValid() const
 {
-    return BaseRadius > 0.0f && Height > 0.0f &&
-           Sides >= 3 && Sides <= 25 &&
-           BevelRadius >= 0.0f && BevelRadius < Height;
+    return GetParams().IsValid();
 }
 
 float APyramid::GetBevelTopRadius() const
 {
-    if (BevelRadius <= 0.0f) 
-    {
-        return BaseRadius;
-    }
-    
-    const float ScaleFactor = 1.0f - (BevelRadius / Height);
-    return FMath::Max(0.0f, BaseRadius * ScaleFactor);
+    return GetParams().GetBevelTopRadius();
 }
 
 int32 APyramid::CalculateVertexCountEstimate() const
 {
-    const int32 BaseVertexCount = Sides;
-    const int32 BevelVertexCount = (BevelRadius > 0.0f) ? Sides * 2 : 0;
-    const int32 PyramidVertexCount = Sides + 1;
-    
-    return BaseVertexCount + BevelVertexCount + PyramidVertexCount;
+    return GetParams().CalculateVertexCountEstimate();
 }
 
 int32 APyramid::CalculateTriangleCountEstimate() const
 {
-    const int32 BaseTriangleCount = Sides - 2;
-    const int32 BevelTriangleCount = (BevelRadius > 0.0f) ? Sides * 2 : 0;
-    const int32 PyramidTriangleCount = Sides;
-    
-    return BaseTriangleCount + BevelTriangleCount + PyramidTriangleCount;
+    return GetParams().CalculateTriangleCountEstimate();
 }
 
 void APyramid::SetBaseRadius(float NewBaseRadius)
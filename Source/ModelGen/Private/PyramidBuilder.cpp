@@ -1,10 +1,11 @@
 #include "PyramidBuilder.h"
-#include "Pyramid.h"
 #include "ModelGenMeshData.h"
+#include "PhysicsEngine/AggregateGeom.h"
 #include "ModelGenConstants.h"
+#include "ModelGenStats.h"
 
-FPyramidBuilder::FPyramidBuilder(const APyramid& InPyramid)
-    : Pyramid(InPyramid)
+FPyramidBuilder::FPyramidBuilder(const FPyramidParams& InParams)
+    : Params(InParams)
 {
     Clear();
 }
@@ -18,7 +19,9 @@ void FPyramidBuilder::Clear()
 
 bool FPyramidBuilder::Generate(FModelGenMeshData& OutMeshData)
 {
-    if (!Pyramid.IsValid())
+    MODELGEN_GENERATE_SCOPE(OutMeshData);
+
+    if (!Params.IsValid())
     {
         return false;
     }
@@ -26,12 +29,12 @@ bool FPyramidBuilder::Generate(FModelGenMeshData& OutMeshData)
     Clear();
     ReserveMemory();
 
-    BaseRadius = Pyramid.BaseRadius;
-    Height = Pyramid.Height;
-    Sides = Pyramid.Sides;
-    BevelRadius = Pyramid.BevelRadius;
+    BaseRadius = Params.BaseRadius;
+    Height = Params.Height;
+    Sides = Params.Sides;
+    BevelRadius = Params.BevelRadius;
 
-    BevelTopRadius = Pyramid.GetBevelTopRadius();
+    BevelTopRadius = Params.GetBevelTopRadius();
 
     TopPoint = FVector(0, 0, Height);
 
@@ -53,12 +56,51 @@ bool FPyramidBuilder::Generate(FModelGenMeshData& OutMeshData)
 
 int32 FPyramidBuilder::CalculateVertexCountEstimate() const
 {
-    return Pyramid.CalculateVertexCountEstimate();
+    return Params.CalculateVertexCountEstimate();
 }
 
 int32 FPyramidBuilder::CalculateTriangleCountEstimate() const
 {
-    return Pyramid.CalculateTriangleCountEstimate();
+    return Params.CalculateTriangleCountEstimate();
+}
+
+bool FPyramidBuilder::GenerateSimpleCollision(FKAggregateGeom& OutGeom) const
+{
+    if (!Params.IsValid())
+    {
+        return false;
+    }
+
+    // 底面多边形（倒角时为底部棱柱的上下两圈）加顶点，整体为一个凸包
+    const float RingRadius = Params.GetBevelTopRadius();
+    const float FullAngle = 2.0f * PI;
+
+    TArray<FVector> Points;
+    Points.Reserve(Params.Sides * 2 + 3);
+    AppendPolygonArcPoints(RingRadius, Params.Sides, 0.0f, FullAngle, 0.0f, FullAngle, 0.0f, Points);
+
+    if (Params.BevelRadius > 0.0f)
+    {
+        AppendPolygonArcPoints(RingRadius, Params.Sides, 0.0f, FullAngle, 0.0f, FullAngle, Params.BevelRadius, Points);
+    }
+
+    Points.Add(FVector(0.0f, 0.0f, Params.Height));
+
+    AddConvexElem(OutGeom, MoveTemp(Points));
+    return OutGeom.ConvexElems.Num() > 0;
+}
+
+TUniquePtr<FModelGenMeshBuilder> FPyramidBuilder::CreateReducedBuilder(float TessellationScale) const
+{
+    FPyramidParams Reduced = Params;
+    Reduced.Sides = ScaleSegmentCount(Params.Sides, TessellationScale, MinLODSides);
+
+    if (Reduced.Sides == Params.Sides)
+    {
+        return nullptr;
+    }
+
+    return MakeUnique<FPyramidBuilder>(Reduced);
 }
 
 void FPyramidBuilder::PrecomputeMath()
@@ -135,7 +177,7 @@ void FPyramidBuilder::GenerateSlices()
         FVector N_Bevel_L, N_Bevel_R, N_Bevel_TL, N_Bevel_TR;
         FVector N_Side_L, N_Side_R, N_Side_Tip;
 
-        if (Pyramid.bSmoothSides)
+        if (Params.bSmoothSides)
         {
             auto GetCylNormal = [&](int32 Idx) {
                 return FVector(CosValues[Idx] * CylNormR, SinValues[Idx] * CylNormR, CylNormZ);
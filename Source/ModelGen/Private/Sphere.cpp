@@ -11,7 +11,10 @@ ASphere::ASphere()
 
 void ASphere::GenerateMesh()
 {
-    TryGenerateMeshInternal();
+    if (!TryGenerateMeshInternal())
+    {
+        ClearGeneratedMesh();
+    }
 }
 
 bool ASphere::TryGenerateMeshInternal()
@@ -21,49 +24,49 @@ bool ASphere::TryGenerateMeshInternal()
         return false;
     }
 
-    FSphereBuilder Builder(*this);
-    FModelGenMeshData MeshData;
-
-    if (!Builder.Generate(MeshData))
+    if (RefreshInstancedShape())
     {
-        if (GetProceduralMesh())
-        {
-            GetProceduralMesh()->ClearAllMeshSections();
-        }
-        return false;
+        return true;
     }
 
-    if (!MeshData.IsValid())
-    {
-        return false;
-    }
+    const FSphereParams Params = GetParams();
+    FSphereBuilder Builder(Params);
+    return GenerateAndApplyMesh(Builder, Params);
+}
+
+TUniquePtr<FModelGenMeshBuilder> ASphere::CreateMeshBuilder() const
+{
+    return MakeUnique<FSphereBuilder>(GetParams());
+}
 
-    MeshData.ToProceduralMesh(GetProceduralMesh(), 0);
-    return true;
+FSphereParams ASphere::GetParams() const
+{
+    FSphereParams Params;
+    Params.Sides = Sides;
+    Params.HorizontalCut = HorizontalCut;
+    Params.VerticalCut = VerticalCut;
+    Params.Radius = Radius;
+    return Params;
+}
+
+FModelGenParamsHash ASphere::GetShapeParamsHash() const
+{
+    return FModelGenParamsHash::Compute(GetParams());
 }
 
 bool ASphere::IsValid() const
 {
-    return Radius > KINDA_SMALL_NUMBER &&
-        Sides >= 4 && Sides <= 64 &&
-        HorizontalCut >= 0.0f && HorizontalCut < 1.0f &&
-        VerticalCut > KINDA_SMALL_NUMBER && VerticalCut <= 1.0f;
+    return GetParams().IsValid();
 }
 
 int32 ASphere::CalculateVertexCountEstimate() const
 {
-    const int32 NumRings = FMath::Max(2, Sides / 2);
-    const int32 GridVerts = (NumRings + 1) * (Sides + 1);
-    const int32 CapVerts = Sides * 4; // 粗略估算顶部和侧面切口的顶点
-    return GridVerts + CapVerts;
+    return GetParams().CalculateVertexCountEstimate();
 }
 
 int32 ASphere::CalculateTriangleCountEstimate() const
 {
-    const int32 NumRings = FMath::Max(2, Sides / 2);
-    const int32 GridTris = NumRings * Sides * 2;
-    const int32 CapTris = Sides * 4;
-    return GridTris + CapTris;
+    return GetParams().CalculateTriangleCountEstimate();
 }
 
 void ASphere::SetSides(int32 NewSides)
@@ -1,9 +1,10 @@
 #include "SphereBuilder.h"
-#include "Sphere.h"
 #include "ModelGenMeshData.h"
+#include "PhysicsEngine/AggregateGeom.h"
+#include "ModelGenStats.h"
 
-FSphereBuilder::FSphereBuilder(const ASphere& InSphere)
-    : Sphere(InSphere)
+FSphereBuilder::FSphereBuilder(const FSphereParams& InParams)
+    : Params(InParams)
 {
     Clear();
 }
@@ -26,7 +27,9 @@ static bool IsTriangleDegenerate(int32 V0, int32 V1, int32 V2)
 
 bool FSphereBuilder::Generate(FModelGenMeshData& OutMeshData)
 {
-    if (!Sphere.IsValid())
+    MODELGEN_GENERATE_SCOPE(OutMeshData);
+
+    if (!Params.IsValid())
     {
         return false;
     }
@@ -34,10 +37,10 @@ bool FSphereBuilder::Generate(FModelGenMeshData& OutMeshData)
     Clear();
 
     // Cache settings
-    Radius = Sphere.Radius;
-    Sides = Sphere.Sides;
-    HorizontalCut = Sphere.HorizontalCut;
-    VerticalCut = Sphere.VerticalCut;
+    Radius = Params.Radius;
+    Sides = Params.Sides;
+    HorizontalCut = Params.HorizontalCut;
+    VerticalCut = Params.VerticalCut;
 
     if (HorizontalCut >= 1.0f - KINDA_SMALL_NUMBER)
     {
@@ -72,7 +75,7 @@ bool FSphereBuilder::Generate(FModelGenMeshData& OutMeshData)
         return false;
     }
 
-    MeshData.CalculateTangents();
+    // 切线已在生成顶点时解析给出，无需再做整网格切线计算
     OutMeshData = MeshData;
 
     return true;
@@ -80,12 +83,86 @@ bool FSphereBuilder::Generate(FModelGenMeshData& OutMeshData)
 
 int32 FSphereBuilder::CalculateVertexCountEstimate() const
 {
-    return Sphere.CalculateVertexCountEstimate();
+    return Params.CalculateVertexCountEstimate();
 }
 
 int32 FSphereBuilder::CalculateTriangleCountEstimate() const
 {
-    return Sphere.CalculateTriangleCountEstimate();
+    return Params.CalculateTriangleCountEstimate();
+}
+
+bool FSphereBuilder::GenerateSimpleCollision(FKAggregateGeom& OutGeom) const
+{
+    if (!Params.IsValid())
+    {
+        return false;
+    }
+
+    const float SphereRadius = Params.Radius;
+    const float CutRatio = FMath::Min(Params.HorizontalCut, 1.0f - KINDA_SMALL_NUMBER);
+    const float PhiRange = PI * (1.0f - CutRatio);
+    const float ThetaRange = Params.VerticalCut * 2.0f * PI;
+    const float CenterZ = -SphereRadius * FMath::Cos(PhiRange);
+    const bool bFullTheta = Params.VerticalCut >= 1.0f - KINDA_SMALL_NUMBER;
+
+    if (bFullTheta && CutRatio <= KINDA_SMALL_NUMBER)
+    {
+        FKSphereElem SphereElem(SphereRadius);
+        SphereElem.Center = FVector(0.0f, 0.0f, CenterZ);
+        OutGeom.SphereElems.Add(SphereElem);
+        return true;
+    }
+
+    // 竖切超过半圈后不再是凸体，交给通用分解
+    if (!bFullTheta && Params.VerticalCut > 0.5f + KINDA_SMALL_NUMBER)
+    {
+        return false;
+    }
+
+    // 横切球冠与半圈以内的楔形都是凸体，取球面采样点作为一个凸包
+    const int32 RingCount = 8;
+    const int32 ThetaSegments = bFullTheta ? 16 : FMath::Max(2, FMath::CeilToInt(16.0f * Params.VerticalCut));
+    const int32 ThetaPointCount = bFullTheta ? ThetaSegments : ThetaSegments + 1;
+
+    TArray<FVector> Points;
+    Points.Reserve(RingCount * ThetaPointCount + 2);
+    Points.Add(FVector(0.0f, 0.0f, SphereRadius + CenterZ));
+
+    for (int32 Ring = 1; Ring <= RingCount; ++Ring)
+    {
+        const float Phi = PhiRange * Ring / RingCount;
+        float SinPhi, CosPhi;
+        FMath::SinCos(&SinPhi, &CosPhi, Phi);
+
+        for (int32 i = 0; i < ThetaPointCount; ++i)
+        {
+            const float Theta = ThetaRange * i / ThetaSegments;
+            float SinTheta, CosTheta;
+            FMath::SinCos(&SinTheta, &CosTheta, Theta);
+            Points.Add(FVector(SphereRadius * SinPhi * CosTheta, SphereRadius * SinPhi * SinTheta, SphereRadius * CosPhi + CenterZ));
+        }
+    }
+
+    if (!bFullTheta)
+    {
+        Points.Add(FVector(0.0f, 0.0f, SphereRadius * FMath::Cos(PhiRange) + CenterZ));
+    }
+
+    AddConvexElem(OutGeom, MoveTemp(Points));
+    return OutGeom.ConvexElems.Num() > 0;
+}
+
+TUniquePtr<FModelGenMeshBuilder> FSphereBuilder::CreateReducedBuilder(float TessellationScale) const
+{
+    FSphereParams Reduced = Params;
+    Reduced.Sides = ScaleSegmentCount(Params.Sides, TessellationScale, MinLODSides);
+
+    if (Reduced.Sides == Params.Sides)
+    {
+        return nullptr;
+    }
+
+    return MakeUnique<FSphereBuilder>(Reduced);
 }
 
 FVector FSphereBuilder::GetSpherePoint(float Theta, float Phi) const
@@ -112,6 +189,20 @@ FVector FSphereBuilder::GetSphereNormal(float Theta, float Phi) const
     );
 }
 
+FVector FSphereBuilder::GetSphereTangentU(float Theta) const
+{
+    return FVector(-FMath::Sin(Theta), FMath::Cos(Theta), 0.0f);
+}
+
+FVector FSphereBuilder::GetSphereTangentV(float Theta, float Phi) const
+{
+    return FVector(
+        FMath::Cos(Phi) * FMath::Cos(Theta),
+        FMath::Cos(Phi) * FMath::Sin(Theta),
+        -FMath::Sin(Phi)
+    );
+}
+
 void FSphereBuilder::SafeAddTriangle(int32 V0, int32 V1, int32 V2)
 {
     if (!IsTriangleDegenerate(V0, V1, V2))
@@ -161,7 +252,10 @@ void FSphereBuilder::GenerateSphereMesh()
             FVector Normal = GetSphereNormal(Theta, Phi);
             FVector2D UV(HRatio, VRatio);
 
-            GridIndices[v].Add(AddVertex(Pos, Normal, UV));
+            // U 沿 Theta、V 沿 Phi 增加
+            FProcMeshTangent Tangent = MakeTangent(Normal, GetSphereTangentU(Theta), GetSphereTangentV(Theta, Phi));
+
+            GridIndices[v].Add(AddVertex(Pos, Normal, UV, Tangent));
         }
     }
 
@@ -221,8 +315,9 @@ void FSphereBuilder::GenerateHorizontalCap(float Phi, bool bIsBottom)
     FVector CenterPos(0.0f, 0.0f, CenterZ);
     FVector Normal(0.0f, 0.0f, -1.0f);
     FVector2D CenterUV(0.5f, 0.5f);
+    FProcMeshTangent Tangent = MakeTangent(Normal, FVector::ForwardVector, FVector::RightVector);
 
-    int32 CenterIndex = AddVertex(CenterPos, Normal, CenterUV);
+    int32 CenterIndex = AddVertex(CenterPos, Normal, CenterUV, Tangent);
 
     TArray<int32> RimIndices;
     RimIndices.Reserve(Segments + 1);
@@ -236,7 +331,7 @@ void FSphereBuilder::GenerateHorizontalCap(float Phi, bool bIsBottom)
         float U = (Pos.X / Radius) * 0.5f + 0.5f;
         float V = (Pos.Y / Radius) * 0.5f + 0.5f;
 
-        RimIndices.Add(AddVertex(Pos, Normal, FVector2D(U, V)));
+        RimIndices.Add(AddVertex(Pos, Normal, FVector2D(U, V), Tangent));
     }
 
     for (int32 i = 0; i < Segments; ++i)
@@ -258,6 +353,10 @@ void FSphereBuilder::GenerateVerticalCap(float Theta, bool bIsStart)
     FVector Tangent(-FMath::Sin(Theta), FMath::Cos(Theta), 0.0f);
     FVector Normal = bIsStart ? -Tangent : Tangent;
 
+    // U 从轴线指向轮廓，V 沿 Z 向下
+    FVector RadialDir(FMath::Cos(Theta), FMath::Sin(Theta), 0.0f);
+    FProcMeshTangent CapTangent = MakeTangent(Normal, RadialDir, -FVector::UpVector);
+
     TArray<int32> ProfileIndices;
     TArray<int32> AxisIndices;
 
@@ -268,11 +367,11 @@ void FSphereBuilder::GenerateVerticalCap(float Theta, bool bIsStart)
 
         FVector Pos = GetSpherePoint(Theta, Phi);
         FVector2D UV_Prof(1.0f, Ratio);
-        ProfileIndices.Add(AddVertex(Pos, Normal, UV_Prof));
+        ProfileIndices.Add(AddVertex(Pos, Normal, UV_Prof, CapTangent));
 
         FVector AxisPos(0.0f, 0.0f, Pos.Z);
         FVector2D UV_Axis(0.0f, Ratio);
-        AxisIndices.Add(AddVertex(AxisPos, Normal, UV_Axis));
+        AxisIndices.Add(AddVertex(AxisPos, Normal, UV_Axis, CapTangent));
     }
 
     for (int32 i = 0; i < Segments; ++i)
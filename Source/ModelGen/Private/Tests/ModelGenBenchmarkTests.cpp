@@ -0,0 +1,416 @@
+// Copyright (c) 2024. All rights reserved.
+
+#include "Misc/AutomationTest.h"
+#include "HAL/LowLevelMemTracker.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/App.h"
+#include "Misc/CommandLine.h"
+#include "Misc/DateTime.h"
+#include "Misc/EngineVersion.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Math/RandomStream.h"
+#include "Dom/JsonObject.h"
+#include "Serialization/JsonSerializer.h"
+#include "Serialization/JsonWriter.h"
+
+#include "ModelGen.h"
+#include "ModelGenMeshData.h"
+#include "ModelGenDiskCache.h"
+#include "ModelGenShapeParams.h"
+#include "ModelGenStaticMeshCache.h"
+#include "ModelStrategyFactory.h"
+#include "BevelCubeBuilder.h"
+#include "EditableSurfaceBuilder.h"
+#include "FrustumBuilder.h"
+#include "HollowPrismBuilder.h"
+#include "PolygonTorusBuilder.h"
+#include "PyramidBuilder.h"
+#include "SphereBuilder.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+// 无界面运行各生成器的参数扫描，统计每顶点耗时与内存并写入 JSON，便于版本间对比
+// 用法：UE4Editor-Cmd <Project>.uproject -nullrhi -unattended -ExecCmds="Automation RunTests ModelGen.Benchmark; Quit"
+//   [-llm] [-ModelGenBenchmarkOutput=<path>] [-ModelGenBenchmarkIterations=N] [-ModelGenBenchmarkFilter=<Builder>] [-ModelGenBenchmarkBatch=N]
+// 默认输出到 Saved/ModelGenBenchmark/<时间戳>.json；任一用例生成失败时测试失败
+// 内存取输出网格的实际容量；带 -llm 启动时另记该用例在 LLM 专用标签下仍占用的字节，分配次数请用 -trace=memory 在 Insights 中查看
+namespace ModelGenBenchmark
+{
+#if ENABLE_LOW_LEVEL_MEM_TRACKER
+    // 项目自定义标签区间内取一个，只在基准测试期间作为作用域标签
+    static const ELLMTag BenchmarkTag = static_cast<ELLMTag>(static_cast<int32>(ELLMTag::ProjectTagStart) + 7);
+
+    static bool IsLLMEnabled()
+    {
+        static bool bRegistered = false;
+        if (!FLowLevelMemTracker::Get().IsEnabled())
+        {
+            return false;
+        }
+
+        if (!bRegistered)
+        {
+            FLowLevelMemTracker::Get().RegisterProjectTag(static_cast<int32>(BenchmarkTag), TEXT("ModelGenBenchmark"), NAME_None, NAME_None);
+            bRegistered = true;
+        }
+        return true;
+    }
+
+    // 线程上未汇总的分配量要先刷入追踪器才能读到
+    static int64 GetLLMBytes()
+    {
+        FLowLevelMemTracker::Get().UpdateStatsPerFrame();
+        return FLowLevelMemTracker::Get().GetTagAmountForTracker(ELLMTracker::Default, BenchmarkTag);
+    }
+#endif
+
+    struct FCase
+    {
+        FString Builder;
+        FString Name;
+        TSharedRef<FJsonObject> Params = MakeShared<FJsonObject>();
+        TFunction<TUniquePtr<FModelGenMeshBuilder>()> CreateBuilder;
+    };
+
+    struct FCaseResult
+    {
+        int32 VertexCount = 0;
+        int32 TriangleCount = 0;
+        double MinNs = 0.0;
+        double MedianNs = 0.0;
+        int64 MeshBytes = 0;
+
+        // 仅在 -llm 下有效，否则为 -1
+        int64 LLMBytes = -1;
+    };
+
+    template <typename TBuilder, typename TParams>
+    static FCase MakeCase(const TCHAR* Builder, const FString& Name, const TParams& Params)
+    {
+        ensureMsgf(Params.IsValid(), TEXT("Benchmark case %s/%s is outside the valid parameter range"), Builder, *Name);
+
+        FCase Case;
+        Case.Builder = Builder;
+        Case.Name = Name;
+        Case.CreateBuilder = [Params]() -> TUniquePtr<FModelGenMeshBuilder>
+        {
+            return MakeUnique<TBuilder>(Params);
+        };
+        return Case;
+    }
+
+    // 各档取值都在对应参数结构 IsValid() 的范围内，最密一档即上限，超出范围的参数会让生成器直接返回失败
+    static void BuildCases(TArray<FCase>& OutCases)
+    {
+        for (int32 Sides : { 8, 16, 25 })
+        {
+            for (int32 HeightSegments : { 0, 6, 12 })
+            {
+                for (int32 BevelSegments : { 0, 4 })
+                {
+                    FFrustumParams Params;
+                    Params.TopSides = Sides;
+                    Params.BottomSides = Sides;
+                    Params.HeightSegments = HeightSegments;
+                    Params.BevelRadius = BevelSegments > 0 ? 5.0f : 0.0f;
+                    Params.BevelSegments = FMath::Max(BevelSegments, 1);
+
+                    FCase& Case = OutCases.Add_GetRef(MakeCase<FFrustumBuilder>(TEXT("Frustum"),
+                        FString::Printf(TEXT("Sides%d_Height%d_Bevel%d"), Sides, HeightSegments, BevelSegments), Params));
+                    Case.Params->SetNumberField(TEXT("Sides"), Sides);
+                    Case.Params->SetNumberField(TEXT("HeightSegments"), HeightSegments);
+                    Case.Params->SetNumberField(TEXT("BevelSegments"), BevelSegments);
+                }
+            }
+        }
+
+        for (int32 Sides : { 16, 32, 64 })
+        {
+            FSphereParams Params;
+            Params.Sides = Sides;
+
+            FCase& Case = OutCases.Add_GetRef(MakeCase<FSphereBuilder>(TEXT("Sphere"), FString::Printf(TEXT("Sides%d"), Sides), Params));
+            Case.Params->SetNumberField(TEXT("Sides"), Sides);
+        }
+
+        for (int32 Segments : { 8, 16, 25 })
+        {
+            FPolygonTorusParams Params;
+            Params.MajorSegments = Segments;
+            Params.MinorSegments = Segments;
+
+            FCase& Case = OutCases.Add_GetRef(MakeCase<FPolygonTorusBuilder>(TEXT("PolygonTorus"), FString::Printf(TEXT("Segments%d"), Segments), Params));
+            Case.Params->SetNumberField(TEXT("MajorSegments"), Segments);
+            Case.Params->SetNumberField(TEXT("MinorSegments"), Segments);
+        }
+
+        for (int32 Sides : { 8, 16, 25 })
+        {
+            for (int32 BevelSegments : { 0, 4 })
+            {
+                FHollowPrismParams Params;
+                Params.OuterSides = Sides;
+                Params.InnerSides = Sides;
+                Params.BevelRadius = BevelSegments > 0 ? 5.0f : 0.0f;
+                Params.BevelSegments = FMath::Max(BevelSegments, 1);
+
+                FCase& Case = OutCases.Add_GetRef(MakeCase<FHollowPrismBuilder>(TEXT("HollowPrism"),
+                    FString::Printf(TEXT("Sides%d_Bevel%d"), Sides, BevelSegments), Params));
+                Case.Params->SetNumberField(TEXT("Sides"), Sides);
+                Case.Params->SetNumberField(TEXT("BevelSegments"), BevelSegments);
+            }
+        }
+
+        for (int32 BevelSegments : { 1, 4, 10 })
+        {
+            FBevelCubeParams Params;
+            Params.BevelSegments = BevelSegments;
+
+            FCase& Case = OutCases.Add_GetRef(MakeCase<FBevelCubeBuilder>(TEXT("BevelCube"), FString::Printf(TEXT("Bevel%d"), BevelSegments), Params));
+            Case.Params->SetNumberField(TEXT("BevelSegments"), BevelSegments);
+        }
+
+        for (int32 Sides : { 4, 12, 25 })
+        {
+            FPyramidParams Params;
+            Params.Sides = Sides;
+
+            FCase& Case = OutCases.Add_GetRef(MakeCase<FPyramidBuilder>(TEXT("Pyramid"), FString::Printf(TEXT("Sides%d"), Sides), Params));
+            Case.Params->SetNumberField(TEXT("Sides"), Sides);
+        }
+
+        // 蜿蜒的道路：路点间距固定，横向正弦摆动，带少量爬升
+        for (int32 NumWaypoints : { 10, 50, 200 })
+        {
+            for (bool bAdaptive : { false, true })
+            {
+                FEditableSurfaceParams Params;
+                Params.bAdaptiveSampling = bAdaptive;
+                for (int32 i = 0; i < NumWaypoints; ++i)
+                {
+                    Params.Waypoints.Add(FSurfaceWaypoint(FVector(i * 400.0f, FMath::Sin(i * 0.7f) * 600.0f, i * 5.0f)));
+                }
+                Params.BuildSplineCurves();
+
+                FCase& Case = OutCases.Add_GetRef(MakeCase<FEditableSurfaceBuilder>(TEXT("EditableSurface"),
+                    FString::Printf(TEXT("Waypoints%d%s"), NumWaypoints, bAdaptive ? TEXT("_Adaptive") : TEXT("")), Params));
+                Case.Params->SetNumberField(TEXT("Waypoints"), NumWaypoints);
+                Case.Params->SetBoolField(TEXT("AdaptiveSampling"), bAdaptive);
+            }
+        }
+    }
+
+    static bool RunCase(const FCase& Case, int32 Iterations, FCaseResult& OutResult)
+    {
+        // 预热一次，排除首次调用的缓存与延迟初始化
+        {
+            TUniquePtr<FModelGenMeshBuilder> Builder = Case.CreateBuilder();
+            FModelGenMeshData MeshData;
+            if (!Builder || !Builder->Generate(MeshData))
+            {
+                return false;
+            }
+            OutResult.VertexCount = MeshData.Vertices.Num();
+            OutResult.TriangleCount = MeshData.Triangles.Num() / 3;
+            OutResult.MeshBytes = static_cast<int64>(MeshData.GetAllocatedSize());
+        }
+
+#if ENABLE_LOW_LEVEL_MEM_TRACKER
+        // 单独跑一轮记录 LLM 占用，不与计时混在一起
+        if (IsLLMEnabled())
+        {
+            const int64 BytesBefore = GetLLMBytes();
+            LLM_SCOPE(BenchmarkTag);
+            TUniquePtr<FModelGenMeshBuilder> Builder = Case.CreateBuilder();
+            FModelGenMeshData MeshData;
+            Builder->Generate(MeshData);
+            OutResult.LLMBytes = GetLLMBytes() - BytesBefore;
+        }
+#endif
+
+        TArray<double> Samples;
+        Samples.Reserve(Iterations);
+
+        for (int32 Iteration = 0; Iteration < Iterations; ++Iteration)
+        {
+            // 生成器的构造也计入，与 Actor 每次重建的实际开销一致
+            const uint64 StartCycles = FPlatformTime::Cycles64();
+            {
+                TUniquePtr<FModelGenMeshBuilder> Builder = Case.CreateBuilder();
+                FModelGenMeshData MeshData;
+                Builder->Generate(MeshData);
+            }
+            const uint64 EndCycles = FPlatformTime::Cycles64();
+
+            Samples.Add(FPlatformTime::ToMilliseconds64(EndCycles - StartCycles) * 1.0e6);
+        }
+
+        Samples.Sort();
+        OutResult.MinNs = Samples[0];
+        OutResult.MedianNs = Samples[Samples.Num() / 2];
+        return true;
+    }
+
+    // 五种工厂类型轮流，各取 16 档尺寸，使批量中既有重复参数也有足够多的不同网格
+    static TSharedRef<FJsonObject> RunBatch(int32 NumRequests)
+    {
+        static const TCHAR* Types[][2] = {
+            { TEXT("BevelCube"), TEXT("BevelRadius") },
+            { TEXT("Pyramid"), TEXT("Height") },
+            { TEXT("Frustum"), TEXT("Height") },
+            { TEXT("HollowPrism"), TEXT("Height") },
+            { TEXT("PolygonTorus"), TEXT("MajorRadius") },
+        };
+
+        FRandomStream Random(12345);
+
+        TArray<FModelGenBatchRequest> Requests;
+        Requests.Reserve(NumRequests);
+        for (int32 RequestIndex = 0; RequestIndex < NumRequests; ++RequestIndex)
+        {
+            const int32 TypeIndex = RequestIndex % UE_ARRAY_COUNT(Types);
+            FModelGenBatchRequest& Request = Requests.AddDefaulted_GetRef();
+            Request.ModelType = Types[TypeIndex][0];
+            Request.Parameters.Add(Types[TypeIndex][1], FString::FromInt(20 + 5 * Random.RandRange(0, 15)));
+        }
+
+        // 清空缓存，测的是冷启动生成而不是缓存命中
+        FModelGenStaticMeshCache::Get().Empty();
+
+        FModelGenBatchStats Stats;
+        UCustomModelFactory::CreateModelStaticMeshesBatch(Requests, nullptr, Stats);
+
+        UE_LOG(LogModelGen, Display, TEXT("Batch %d requests: %d unique, %d failed, generate %.2f ms, finalize %.2f ms, %.0f meshes/s"),
+            Stats.NumRequests, Stats.NumUnique, Stats.NumFailed, Stats.GenerateMs, Stats.FinalizeMs, Stats.MeshesPerSecond);
+
+        TSharedRef<FJsonObject> BatchObject = MakeShared<FJsonObject>();
+        BatchObject->SetNumberField(TEXT("requests"), Stats.NumRequests);
+        BatchObject->SetNumberField(TEXT("unique"), Stats.NumUnique);
+        BatchObject->SetNumberField(TEXT("generated"), Stats.NumGenerated);
+        BatchObject->SetNumberField(TEXT("failed"), Stats.NumFailed);
+        BatchObject->SetNumberField(TEXT("triangles"), Stats.GeneratedTriangles);
+        BatchObject->SetNumberField(TEXT("generate_ms"), Stats.GenerateMs);
+        BatchObject->SetNumberField(TEXT("finalize_ms"), Stats.FinalizeMs);
+        BatchObject->SetNumberField(TEXT("total_ms"), Stats.TotalMs);
+        BatchObject->SetNumberField(TEXT("meshes_per_second"), Stats.MeshesPerSecond);
+
+        FModelGenStaticMeshCache::Get().Empty();
+        return BatchObject;
+    }
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FModelGenBuilderBenchmarkTest, "ModelGen.Benchmark.Builders",
+    EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::PerfFilter)
+
+bool FModelGenBuilderBenchmarkTest::RunTest(const FString& Parameters)
+{
+    using namespace ModelGenBenchmark;
+
+    const TCHAR* CommandLine = FCommandLine::Get();
+
+    int32 Iterations = 20;
+    FParse::Value(CommandLine, TEXT("ModelGenBenchmarkIterations="), Iterations);
+    Iterations = FMath::Max(Iterations, 1);
+
+    FString Filter;
+    FParse::Value(CommandLine, TEXT("ModelGenBenchmarkFilter="), Filter);
+
+    int32 BatchSize = 0;
+    FParse::Value(CommandLine, TEXT("ModelGenBenchmarkBatch="), BatchSize);
+
+    const FString Timestamp = FDateTime::UtcNow().ToString(TEXT("%Y%m%d-%H%M%S"));
+    FString OutputPath = FPaths::ProjectSavedDir() / TEXT("ModelGenBenchmark") / (Timestamp + TEXT(".json"));
+    FParse::Value(CommandLine, TEXT("ModelGenBenchmarkOutput="), OutputPath);
+
+    TArray<FCase> Cases;
+    BuildCases(Cases);
+
+    // 测的是生成与转换本身，批量路径不读写磁盘缓存
+    FModelGenDiskCache& DiskCache = FModelGenDiskCache::Get();
+    const bool bDiskCacheWasEnabled = DiskCache.IsEnabled();
+    DiskCache.SetEnabled(false);
+
+    TArray<TSharedPtr<FJsonValue>> CaseValues;
+
+    for (const FCase& Case : Cases)
+    {
+        if (!Filter.IsEmpty() && !Case.Builder.Equals(Filter, ESearchCase::IgnoreCase))
+        {
+            continue;
+        }
+
+        FCaseResult Result;
+        if (!RunCase(Case, Iterations, Result))
+        {
+            AddError(FString::Printf(TEXT("Benchmark %s/%s: generation failed"), *Case.Builder, *Case.Name));
+            continue;
+        }
+
+        const double NsPerVertex = Result.VertexCount > 0 ? Result.MedianNs / Result.VertexCount : 0.0;
+
+        UE_LOG(LogModelGen, Display, TEXT("%-16s %-28s %8d verts %8d tris %12.0f ns %8.1f ns/vert %10lld mesh bytes %10lld llm bytes"),
+            *Case.Builder, *Case.Name, Result.VertexCount, Result.TriangleCount, Result.MedianNs, NsPerVertex,
+            Result.MeshBytes, Result.LLMBytes);
+
+        TSharedRef<FJsonObject> CaseObject = MakeShared<FJsonObject>();
+        CaseObject->SetStringField(TEXT("builder"), Case.Builder);
+        CaseObject->SetStringField(TEXT("case"), Case.Name);
+        CaseObject->SetObjectField(TEXT("params"), Case.Params);
+        CaseObject->SetNumberField(TEXT("vertices"), Result.VertexCount);
+        CaseObject->SetNumberField(TEXT("triangles"), Result.TriangleCount);
+        CaseObject->SetNumberField(TEXT("median_ns"), Result.MedianNs);
+        CaseObject->SetNumberField(TEXT("min_ns"), Result.MinNs);
+        CaseObject->SetNumberField(TEXT("ns_per_vertex"), NsPerVertex);
+        CaseObject->SetNumberField(TEXT("mesh_bytes"), static_cast<double>(Result.MeshBytes));
+        if (Result.LLMBytes >= 0)
+        {
+            CaseObject->SetNumberField(TEXT("llm_bytes"), static_cast<double>(Result.LLMBytes));
+        }
+        CaseValues.Add(MakeShared<FJsonValueObject>(CaseObject));
+    }
+
+    TSharedPtr<FJsonObject> BatchObject;
+    if (BatchSize > 0)
+    {
+        BatchObject = RunBatch(BatchSize);
+        const int32 NumBatchFailed = static_cast<int32>(BatchObject->GetNumberField(TEXT("failed")));
+        if (NumBatchFailed > 0)
+        {
+            AddError(FString::Printf(TEXT("Benchmark batch: %d requests failed"), NumBatchFailed));
+        }
+    }
+
+    DiskCache.SetEnabled(bDiskCacheWasEnabled);
+
+    TSharedRef<FJsonObject> Root = MakeShared<FJsonObject>();
+    Root->SetNumberField(TEXT("format_version"), 2);
+    Root->SetStringField(TEXT("engine_version"), FEngineVersion::Current().ToString());
+    Root->SetStringField(TEXT("timestamp"), Timestamp);
+    Root->SetStringField(TEXT("configuration"), LexToString(FApp::GetBuildConfiguration()));
+    Root->SetNumberField(TEXT("iterations"), Iterations);
+    Root->SetArrayField(TEXT("cases"), CaseValues);
+    if (BatchObject.IsValid())
+    {
+        Root->SetObjectField(TEXT("batch"), BatchObject);
+    }
+
+    FString JsonText;
+    TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&JsonText);
+    if (!FJsonSerializer::Serialize(Root, Writer))
+    {
+        AddError(TEXT("Benchmark: failed to serialize results"));
+        return false;
+    }
+
+    if (!FFileHelper::SaveStringToFile(JsonText, *OutputPath))
+    {
+        AddError(FString::Printf(TEXT("Benchmark: failed to write %s"), *OutputPath));
+        return false;
+    }
+
+    AddInfo(FString::Printf(TEXT("Benchmark: %d cases written to %s"), CaseValues.Num(), *OutputPath));
+    return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
@@ -0,0 +1,71 @@
+// Copyright (c) 2024. All rights reserved.
+
+#include "Misc/AutomationTest.h"
+#include "EditableSurface.h"
+#include "EditableSurfaceBuilder.h"
+#include "ModelGenDiskCache.h"
+#include "ModelGenMeshData.h"
+#include "ModelGenShapeParams.h"
+#include "HAL/FileManager.h"
+#include "Misc/Guid.h"
+#include "Misc/Paths.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FModelGenEditableSurfaceKeyTest, "ModelGen.DiskCache.EditableSurfaceSplineEditMisses",
+    EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FModelGenEditableSurfaceKeyTest::RunTest(const FString& Parameters)
+{
+    FEditableSurfaceParams Params;
+    Params.Waypoints.Add(FSurfaceWaypoint(FVector(0.0f, 0.0f, 0.0f)));
+    Params.Waypoints.Add(FSurfaceWaypoint(FVector(500.0f, 0.0f, 30.0f)));
+    Params.Waypoints.Add(FSurfaceWaypoint(FVector(1000.0f, 200.0f, 90.0f)));
+    Params.BuildSplineCurves();
+
+    if (!TestTrue(TEXT("Params valid"), Params.IsValid() && Params.GetNumSplinePoints() == 3))
+    {
+        return false;
+    }
+
+    // 直接拖动样条组件上的点：路点等反射参数不变，只有曲线快照变化
+    FEditableSurfaceParams SplineEdited = Params;
+    SplineEdited.SplineCurves.Position.Points[1].OutVal += FVector(0.0f, 150.0f, 0.0f);
+    SplineEdited.SplineCurves.UpdateSpline();
+
+    FEditableSurfaceParams UpEdited = Params;
+    UpEdited.DefaultUpVector = FVector(0.0f, 1.0f, 0.0f);
+
+    const FModelGenParamsHash Key = AEditableSurface::ComputeShapeHash(Params);
+    TestTrue(TEXT("Reflected hash ignores the spline edit"), FModelGenParamsHash::Compute(Params) == FModelGenParamsHash::Compute(SplineEdited));
+    TestTrue(TEXT("Spline edit changes the key"), AEditableSurface::ComputeShapeHash(SplineEdited) != Key);
+    TestTrue(TEXT("Up vector changes the key"), AEditableSurface::ComputeShapeHash(UpEdited) != Key);
+    TestTrue(TEXT("Key is stable"), AEditableSurface::ComputeShapeHash(Params) == Key);
+
+    // 指向一次性的临时目录，不污染项目的 Saved/ModelGenCache
+    FModelGenDiskCache& DiskCache = FModelGenDiskCache::Get();
+    const bool bWasEnabled = DiskCache.IsEnabled();
+    const FString PreviousCacheDir = DiskCache.GetCacheDir();
+    const FString TestCacheDir = FPaths::ConvertRelativePathToFull(FPaths::AutomationTransientDir() / TEXT("ModelGenCache") / FGuid::NewGuid().ToString());
+    DiskCache.SetCacheDir(TestCacheDir);
+    DiskCache.SetEnabled(true);
+
+    FEditableSurfaceBuilder Builder(Params);
+    FModelGenMeshData MeshData;
+    if (TestTrue(TEXT("Generate original surface"), DiskCache.FindOrGenerate(Key, Builder, MeshData) && MeshData.IsValid()))
+    {
+        // 写入在后台线程进行
+        DiskCache.Flush();
+
+        FModelGenMeshData Loaded;
+        TestTrue(TEXT("Original key hits"), DiskCache.LoadMeshData(Key, Loaded));
+        TestFalse(TEXT("Edited spline misses"), DiskCache.LoadMeshData(AEditableSurface::ComputeShapeHash(SplineEdited), Loaded));
+    }
+
+    DiskCache.SetEnabled(bWasEnabled);
+    DiskCache.SetCacheDir(PreviousCacheDir);
+    IFileManager::Get().DeleteDirectory(*TestCacheDir, false, true);
+    return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
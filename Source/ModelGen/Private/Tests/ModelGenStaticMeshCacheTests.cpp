@@ -0,0 +1,97 @@
+// Copyright (c) 2024. All rights reserved.
+
+#include "Misc/AutomationTest.h"
+#include "Engine/Engine.h"
+#include "Engine/StaticMesh.h"
+#include "Engine/World.h"
+#include "PhysicsEngine/BodySetup.h"
+#include "ModelStrategyFactory.h"
+#include "ModelGenMeshBuilder.h"
+#include "ProceduralMeshActor.h"
+#include "Sphere.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace ModelGenStaticMeshCacheTests
+{
+    // 与实际碰撞逐类比较元素数，包围盒占位只有一个 BoxElem
+    static void TestMatchesSimpleCollision(FAutomationTestBase& Test, const TCHAR* What, const UStaticMesh* Mesh, const FKAggregateGeom& Expected)
+    {
+        if (!Test.TestNotNull(FString::Printf(TEXT("%s: mesh"), What), Mesh) ||
+            !Test.TestNotNull(FString::Printf(TEXT("%s: BodySetup"), What), Mesh->BodySetup))
+        {
+            return;
+        }
+
+        const FKAggregateGeom& Geom = Mesh->BodySetup->AggGeom;
+        Test.TestEqual(FString::Printf(TEXT("%s: sphere elems"), What), Geom.SphereElems.Num(), Expected.SphereElems.Num());
+        Test.TestEqual(FString::Printf(TEXT("%s: box elems"), What), Geom.BoxElems.Num(), Expected.BoxElems.Num());
+        Test.TestEqual(FString::Printf(TEXT("%s: sphyl elems"), What), Geom.SphylElems.Num(), Expected.SphylElems.Num());
+        Test.TestEqual(FString::Printf(TEXT("%s: convex elems"), What), Geom.ConvexElems.Num(), Expected.ConvexElems.Num());
+
+        for (int32 ElemIdx = 0; ElemIdx < Geom.ConvexElems.Num(); ++ElemIdx)
+        {
+            Test.TestNotNull(FString::Printf(TEXT("%s: convex %d cooked"), What, ElemIdx), Geom.ConvexElems[ElemIdx].GetConvexMesh());
+        }
+
+        Test.TestTrue(FString::Printf(TEXT("%s: physics meshes created"), What), Mesh->BodySetup->bCreatedPhysicsMeshes);
+    }
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FModelGenCachedMeshCollisionTest, "ModelGen.StaticMeshCache.CachedMeshHasSimpleCollision",
+    EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FModelGenCachedMeshCollisionTest::RunTest(const FString& Parameters)
+{
+    using namespace ModelGenStaticMeshCacheTests;
+
+    UWorld* World = UWorld::CreateWorld(EWorldType::Game, false);
+    FWorldContext& WorldContext = GEngine->CreateNewWorldContext(EWorldType::Game);
+    WorldContext.SetCurrentWorld(World);
+
+    UCustomModelFactory::ClearCache();
+
+    // Actor 路径：开启异步烘焙的 Actor 转换后立即销毁，与 CreateModelStaticMeshFromActor 相同
+    ASphere* Sphere = World->SpawnActor<ASphere>();
+    if (TestNotNull(TEXT("Sphere actor"), Sphere))
+    {
+        Sphere->bUseAsyncCooking = true;
+
+        FKAggregateGeom Expected;
+        // 派生类把 CreateMeshBuilder 声明为 protected，经基类调用
+        const AProceduralMeshActor* SphereBase = Sphere;
+        TUniquePtr<FModelGenMeshBuilder> Builder = SphereBase->CreateMeshBuilder();
+        TestTrue(TEXT("Sphere has analytic collision"), Builder.IsValid() && Builder->GenerateSimpleCollision(Expected));
+
+        UStaticMesh* Mesh = UCustomModelFactory::GetOrCreateStaticMesh(Sphere);
+        Sphere->Destroy();
+
+        TestMatchesSimpleCollision(*this, TEXT("Actor path"), Mesh, Expected);
+        if (Mesh && Mesh->BodySetup && Mesh->BodySetup->AggGeom.SphereElems.Num() == 1 && Expected.SphereElems.Num() == 1)
+        {
+            TestEqual(TEXT("Actor path: sphere radius"), Mesh->BodySetup->AggGeom.SphereElems[0].Radius, Expected.SphereElems[0].Radius);
+        }
+    }
+
+    // 生成器路径，第二次请求应命中同一个缓存网格
+    TMap<FString, FString> PyramidParameters;
+    FModelGenParamsHash PyramidHash;
+    TUniquePtr<FModelGenMeshBuilder> PyramidBuilder = UCustomModelFactory::CreateBuilder(TEXT("Pyramid"), PyramidParameters, PyramidHash);
+    if (TestNotNull(TEXT("Pyramid builder"), PyramidBuilder.Get()))
+    {
+        FKAggregateGeom Expected;
+        PyramidBuilder->GenerateSimpleCollision(Expected);
+
+        UStaticMesh* Mesh = UCustomModelFactory::CreateModelStaticMesh(TEXT("Pyramid"), PyramidParameters, World);
+        TestMatchesSimpleCollision(*this, TEXT("Builder path"), Mesh, Expected);
+        TestEqual(TEXT("Builder path: cache hit"), UCustomModelFactory::CreateModelStaticMesh(TEXT("Pyramid"), PyramidParameters, World), Mesh);
+    }
+
+    UCustomModelFactory::ClearCache();
+
+    GEngine->DestroyWorldContext(World);
+    World->DestroyWorld(false);
+    return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
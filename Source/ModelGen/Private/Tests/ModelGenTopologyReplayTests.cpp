@@ -0,0 +1,72 @@
+// Copyright (c) 2024. All rights reserved.
+
+#include "Misc/AutomationTest.h"
+#include "FrustumBuilder.h"
+#include "ModelGenMeshData.h"
+#include "ModelGenParamsHash.h"
+#include "ModelGenShapeParams.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FModelGenTopologyReplayTest, "ModelGen.Builder.TopologyReplayMatchesFullGenerate",
+    EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FModelGenTopologyReplayTest::RunTest(const FString& Parameters)
+{
+    FFrustumParams Params;
+    Params.HeightSegments = 3;
+    Params.BevelRadius = 5.0f;
+    Params.BendAmount = 0.3f;
+
+    FModelGenTopologyRecord Record;
+    FModelGenMeshData Original;
+    {
+        FFrustumBuilder Builder(Params);
+        Builder.SetTopologyRecord(&Record);
+        if (!TestTrue(TEXT("Record original"), Builder.Generate(Original) && Record.IsValid()))
+        {
+            return false;
+        }
+    }
+
+    // 只改连续参数：离散哈希不变，重放结果须与完整生成一致
+    FFrustumParams Edited = Params;
+    Edited.TopRadius = 40.0f;
+    Edited.Height = 140.0f;
+    Edited.BendAmount = 0.5f;
+    TestTrue(TEXT("Continuous edit keeps the discrete hash"), FModelGenParamsHash::ComputeDiscrete(Edited) == FModelGenParamsHash::ComputeDiscrete(Params));
+
+    FModelGenMeshData Replayed;
+    FModelGenMeshData Expected;
+    TestTrue(TEXT("Replay succeeds"), FFrustumBuilder(Edited).Regenerate(Record, Replayed));
+    TestTrue(TEXT("Full generate succeeds"), FFrustumBuilder(Edited).Generate(Expected));
+
+    if (TestEqual(TEXT("Vertex count"), Replayed.Vertices.Num(), Expected.Vertices.Num()))
+    {
+        TestTrue(TEXT("Index buffer"), Replayed.Triangles == Expected.Triangles);
+        for (int32 Index = 0; Index < Expected.Vertices.Num(); ++Index)
+        {
+            if (!Replayed.Vertices[Index].Equals(Expected.Vertices[Index], KINDA_SMALL_NUMBER) ||
+                !Replayed.Normals[Index].Equals(Expected.Normals[Index], KINDA_SMALL_NUMBER) ||
+                !Replayed.UVs[Index].Equals(Expected.UVs[Index], KINDA_SMALL_NUMBER))
+            {
+                AddError(FString::Printf(TEXT("Vertex %d differs from full generate"), Index));
+                break;
+            }
+        }
+    }
+
+    // 倒角半径归零会跳过倒角分支，调用序列与记录不符，必须回退完整生成
+    FFrustumParams NoBevel = Params;
+    NoBevel.BevelRadius = 0.0f;
+    FModelGenMeshData Rejected;
+    TestFalse(TEXT("Branch change rejects the replay"), FFrustumBuilder(NoBevel).Regenerate(Record, Rejected));
+
+    FFrustumParams MoreSides = Params;
+    MoreSides.TopSides = Params.TopSides + 1;
+    TestTrue(TEXT("Side count changes the discrete hash"), FModelGenParamsHash::ComputeDiscrete(MoreSides) != FModelGenParamsHash::ComputeDiscrete(Params));
+
+    return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
@@ -4,6 +4,7 @@
 
 #include "CoreMinimal.h"
 #include "ProceduralMeshActor.h"
+#include "ModelGenShapeParams.h"
 
 #include "BevelCube.generated.h"
 
@@ -42,6 +43,9 @@ public:
 
     virtual void GenerateMesh() override;
 
+protected:
+    virtual TUniquePtr<FModelGenMeshBuilder> CreateMeshBuilder() const override;
+
 private:
     bool TryGenerateMeshInternal();
 
@@ -54,5 +58,9 @@ public:
     int32 GetTriangleCount() const;
 
 public:
+    FBevelCubeParams GetParams() const;
+
+    virtual FModelGenParamsHash GetShapeParamsHash() const override;
+
     virtual bool IsValid() const override;
 };
@@ -2,8 +2,7 @@
 
 #include "CoreMinimal.h"
 #include "ModelGenMeshBuilder.h"
-
-class ABevelCube;
+#include "ModelGenShapeParams.h"
 
 struct FUnfoldedFace
 {
@@ -16,14 +15,16 @@ struct FUnfoldedFace
 class MODELGEN_API FBevelCubeBuilder : public FModelGenMeshBuilder
 {
 public:
-    explicit FBevelCubeBuilder(const ABevelCube& InBevelCube);
+    explicit FBevelCubeBuilder(const FBevelCubeParams& InParams);
 
     virtual bool Generate(FModelGenMeshData& OutMeshData) override;
     virtual int32 CalculateVertexCountEstimate() const override;
     virtual int32 CalculateTriangleCountEstimate() const override;
+    virtual bool GenerateSimpleCollision(FKAggregateGeom& OutGeom) const override;
+    virtual TUniquePtr<FModelGenMeshBuilder> CreateReducedBuilder(float TessellationScale) const override;
 
 private:
-    const ABevelCube& BevelCube;
+    FBevelCubeParams Params;
 
     bool bEnableBevel;
 
@@ -2,48 +2,13 @@
 
 #include "CoreMinimal.h"
 #include "ProceduralMeshActor.h"
+#include "ModelGenShapeParams.h"
 #include "Components/SplineComponent.h"
 #include "EditableSurface.generated.h"
 
 class FEditableSurfaceBuilder;
 struct FModelGenMeshData;
 
-UENUM(BlueprintType)
-enum class ESurfaceCurveType : uint8
-{
-    Standard UMETA(DisplayName = "标准曲线"),
-    Smooth UMETA(DisplayName = "平滑曲线")
-};
-
-UENUM(BlueprintType)
-enum class ESurfaceTextureMapping : uint8
-{
-    Default UMETA(DisplayName = "默认"),
-    Stretch UMETA(DisplayName = "拉伸")
-};
-
-USTRUCT(BlueprintType)
-struct FSurfaceWaypoint
-{
-    GENERATED_BODY()
-
-    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Waypoint", meta = (MakeEditWidget = true))
-    FVector Position = FVector::ZeroVector;
-
-    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Waypoint", meta = (UIMin = "-1.0"))
-    float Width = -1.0f;
-
-    FSurfaceWaypoint()
-        : Position(FVector::ZeroVector), Width(-1.0f)
-    {
-    }
-
-    FSurfaceWaypoint(const FVector& InPosition, float InWidth = -1.0f)
-        : Position(InPosition), Width(InWidth)
-    {
-    }
-};
-
 UCLASS(BlueprintType, meta = (DisplayName = "Editable Surface"))
 class MODELGEN_API AEditableSurface : public AProceduralMeshActor
 {
@@ -110,6 +75,28 @@ public:
     UFUNCTION(BlueprintCallable, Category = "EditableSurface|Parameters")
     void SetLoopRemovalThreshold(float NewValue);
 
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "EditableSurface|Geometry",
+        meta = (DisplayName = "自适应采样"))
+    bool bAdaptiveSampling = false;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "EditableSurface|Geometry",
+        meta = (ClampMin = "0.1", ClampMax = "45.0", UIMin = "0.5", UIMax = "15.0",
+            DisplayName = "自适应角度容差", EditCondition = "bAdaptiveSampling"))
+    float AdaptiveAngleTolerance = 2.0f;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "EditableSurface|Geometry",
+        meta = (ClampMin = "0.01", ClampMax = "100.0", UIMin = "0.1", UIMax = "20.0",
+            DisplayName = "自适应弦高容差", EditCondition = "bAdaptiveSampling"))
+    float AdaptiveChordTolerance = 1.0f;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "EditableSurface|Geometry",
+        meta = (ClampMin = "10.0", ClampMax = "10000.0", UIMin = "50.0", UIMax = "2000.0",
+            DisplayName = "自适应最大步长", EditCondition = "bAdaptiveSampling"))
+    float AdaptiveMaxStep = 500.0f;
+
+    UFUNCTION(BlueprintCallable, Category = "EditableSurface|Parameters")
+    void SetAdaptiveSampling(bool bNewAdaptiveSampling);
+
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "EditableSurface|Thickness",
         meta = (DisplayName = "曲面厚度"))
     bool bEnableThickness = false;
@@ -178,6 +165,17 @@ public:
     UFUNCTION(BlueprintCallable, Category = "EditableSurface|Parameters")
     void SetTextureMapping(ESurfaceTextureMapping NewTextureMapping);
 
+    // 每个分块包含的样条段数；大于 0 时每个分块写入独立的 PMC，编辑时只重建并上传受影响的分块，0 为整条生成
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "EditableSurface|Generation",
+        meta = (ClampMin = "0", UIMin = "0", UIMax = "64", DisplayName = "分块样条段数"))
+    int32 SegmentsPerChunk = 0;
+
+    // 整条生成时每个分块的三角形上限；大于 0 时按空间切分为多个包围盒紧凑的 PMC，屏幕外路段可被剔除
+    // 按样条段分块时分块大小由 SegmentsPerChunk 决定，此项不生效
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "EditableSurface|Generation",
+        meta = (ClampMin = "0", UIMin = "0", UIMax = "65536", DisplayName = "分块三角形上限"))
+    int32 MaxTrianglesPerChunk = 0;
+
     UFUNCTION(BlueprintCallable, Category = "EditableSurface|Parameters")
     void UpdateSplineFromWaypoints();
 
@@ -189,7 +187,20 @@ public:
 
     virtual void GenerateMesh() override;
 
+protected:
+    virtual TUniquePtr<FModelGenMeshBuilder> CreateMeshBuilder() const override;
+
+    // 同时丢弃分块哈希，之后的分块生成全部重建
+    virtual void ClearGeneratedMesh() override;
+
 public:
+    FEditableSurfaceParams GetParams() const;
+
+    virtual FModelGenParamsHash GetShapeParamsHash() const override;
+
+    // 整体生成的输入哈希：反射参数之外还计入样条曲线快照与默认上方向，直接编辑样条组件也会换键
+    static FModelGenParamsHash ComputeShapeHash(const FEditableSurfaceParams& Params);
+
     virtual bool IsValid() const override;
 
     int32 CalculateVertexCountEstimate() const;
@@ -197,9 +208,20 @@ public:
 
 private:
     bool TryGenerateMeshInternal();
+    bool TryGenerateChunkedMeshInternal(const FEditableSurfaceParams& Params);
+
+    // 分块的输入哈希：覆盖分块内样条点的参数值、插值模式、位置、切线、旋转与缩放，分块范围内的重参数化表，以及除路点外的全部参数
+    static FModelGenParamsHash ComputeChunkHash(const FEditableSurfaceParams& Params, const FModelGenParamsHash& SharedHash,
+        int32 FirstPoint, int32 LastPoint);
     void InitializeDefaultWaypoints();
     void RebuildSplineData();
 
     float NextWaypointDistance = 200.0f;
 
+    // 上次写入各分块时的输入哈希，下标即 PMC 分段索引
+    TArray<FModelGenParamsHash> ChunkHashes;
+
+    // 各分块的结果是否已写入磁盘缓存；交互编辑时生成的分块在提交时即使未变也要补写
+    TArray<bool> PersistedChunks;
+
 };
\ No newline at end of file
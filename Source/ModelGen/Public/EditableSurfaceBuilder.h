@@ -2,10 +2,7 @@
 
 #include "CoreMinimal.h"
 #include "ModelGenMeshBuilder.h"
-#include "EditableSurface.h"
-
-class AEditableSurface;
-class USplineComponent;
+#include "ModelGenShapeParams.h"
 
 struct FSurfaceSamplePoint
 {
@@ -48,29 +45,42 @@ struct FRailPoint
     FVector2D UV;
     float DistanceAlongRail;
 
+    // 对应中心线采样点在区间内的距离比例，自适应重采样时左右轨道按它配对
+    float PathFraction;
+
     FRailPoint() 
-        : Position(FVector::ZeroVector), Normal(FVector::UpVector), Tangent(FVector::ForwardVector), UV(FVector2D::ZeroVector), DistanceAlongRail(0.f) 
+        : Position(FVector::ZeroVector), Normal(FVector::UpVector), Tangent(FVector::ForwardVector), UV(FVector2D::ZeroVector), DistanceAlongRail(0.f), PathFraction(0.f) 
     {}
 };
 
 class MODELGEN_API FEditableSurfaceBuilder : public FModelGenMeshBuilder
 {
 public:
-    explicit FEditableSurfaceBuilder(const AEditableSurface& InSurface);
+    explicit FEditableSurfaceBuilder(const FEditableSurfaceParams& InParams);
 
     virtual bool Generate(FModelGenMeshData& OutMeshData) override;
     virtual int32 CalculateVertexCountEstimate() const override;
     virtual int32 CalculateTriangleCountEstimate() const override;
 
+    // 沿样条方向加大采样步长与自适应容差，侧边圆滑度同比降低
+    virtual TUniquePtr<FModelGenMeshBuilder> CreateReducedBuilder(float TessellationScale) const override;
+
     void Clear();
 
+    // 只生成样条距离 [StartDistance, EndDistance] 内的一段，供分块增量重建使用
+    // 首尾端盖只在区间触及样条两端时生成；纹理 V 向按整数个平铺周期拉伸，使相邻分块在接缝处连续且互不依赖
+    void SetDistanceRange(float StartDistance, float EndDistance);
+
 private:
-    const AEditableSurface& Surface;
+    FEditableSurfaceParams Params;
 
-    USplineComponent* SplineComponent;
     float SurfaceWidth;
     float SplineSampleStep;
     float LoopRemovalThreshold;
+    bool bAdaptiveSampling;
+    float AdaptiveAngleTolerance;
+    float AdaptiveChordTolerance;
+    float AdaptiveMaxStep;
     bool bEnableThickness;
     float ThicknessValue;
     int32 SideSmoothness;
@@ -81,10 +91,21 @@ private:
     ESurfaceTextureMapping TextureMapping;
 	float CachedMaxProfileLength;
 
+    float RangeStartDistance;
+    float RangeEndDistance;
+    bool bHasDistanceRange;
+
     TArray<FSurfaceSamplePoint> SampledPath;
     TArray<FCornerData> PathCornerData;
 
+    // 自适应采样时各采样点在区间内的距离比例，轨道重采样在这些中心线参数处取点，空数组表示均匀步长
+    TArray<float> AdaptiveRailFractions;
+
     void SampleSplinePath();
+    void SampleSplinePathAdaptive();
+    void SubdivideSampleSpan(const FSurfaceSamplePoint& Start, const FSurfaceSamplePoint& End, float CosAngleTolerance);
+    bool NeedsSubdivision(const FSurfaceSamplePoint& Start, const FSurfaceSamplePoint& Mid, const FSurfaceSamplePoint& End, float CosAngleTolerance) const;
+    FSurfaceSamplePoint MakeSamplePoint(float Distance) const;
     void CalculateCornerGeometry();
 
     TArray<FRailPoint> LeftRailRaw;
@@ -117,4 +138,5 @@ private:
     void ApplyMonotonicityConstraint(FVector& Pos, const FVector& LastValidPos, const FVector& Tangent);
 
     void CorrectRailUVs(TArray<FRailPoint>& Rail, float TargetTotalLength);
+    float GetTileSnapScale(float UVSpan) const;
 };
\ No newline at end of file
@@ -2,6 +2,7 @@
 
 #include "CoreMinimal.h"
 #include "ProceduralMeshActor.h"
+#include "ModelGenShapeParams.h"
 #include "Frustum.generated.h"
 
 class FFrustumBuilder;
@@ -95,10 +96,17 @@ public:
 
     virtual void GenerateMesh() override;
 
+protected:
+    virtual TUniquePtr<FModelGenMeshBuilder> CreateMeshBuilder() const override;
+
 private:
     bool TryGenerateMeshInternal();
 
 public:
+    FFrustumParams GetParams() const;
+
+    virtual FModelGenParamsHash GetShapeParamsHash() const override;
+
     virtual bool IsValid() const override;
     
     float GetHalfHeight() const { return Height * 0.5f; }
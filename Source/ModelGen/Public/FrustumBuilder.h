@@ -2,22 +2,23 @@
 
 #include "CoreMinimal.h"
 #include "ModelGenMeshBuilder.h"
-
-class AFrustum;
+#include "ModelGenShapeParams.h"
 
 class MODELGEN_API FFrustumBuilder : public FModelGenMeshBuilder
 {
 public:
-    explicit FFrustumBuilder(const AFrustum& InFrustum);
+    explicit FFrustumBuilder(const FFrustumParams& InParams);
 
     virtual bool Generate(FModelGenMeshData& OutMeshData) override;
     virtual int32 CalculateVertexCountEstimate() const override;
     virtual int32 CalculateTriangleCountEstimate() const override;
+    virtual bool GenerateSimpleCollision(FKAggregateGeom& OutGeom) const override;
+    virtual TUniquePtr<FModelGenMeshBuilder> CreateReducedBuilder(float TessellationScale) const override;
 
     void Clear();
 
 private:
-    const AFrustum& Frustum;
+    FFrustumParams Params;
 
     bool bEnableBevel;
     float StartAngle;
@@ -4,6 +4,7 @@
 
 #include "CoreMinimal.h"
 #include "ProceduralMeshActor.h"
+#include "ModelGenShapeParams.h"
 #include "HollowPrism.generated.h"
 
 class UProceduralMeshComponent;
@@ -77,6 +78,9 @@ public:
 
     virtual void GenerateMesh() override;
 
+protected:
+    virtual TUniquePtr<FModelGenMeshBuilder> CreateMeshBuilder() const override;
+
 private:
     bool TryGenerateMeshInternal();
     
@@ -84,6 +88,10 @@ private:
     void RegenerateMeshBlueprint();
     
 public:
+    FHollowPrismParams GetParams() const;
+
+    virtual FModelGenParamsHash GetShapeParamsHash() const override;
+
     bool IsValid() const;
     float GetWallThickness() const;
     bool IsFullCircle() const;
@@ -2,20 +2,21 @@
 
 #include "CoreMinimal.h"
 #include "ModelGenMeshBuilder.h"
-
-class AHollowPrism;
+#include "ModelGenShapeParams.h"
 
 class MODELGEN_API FHollowPrismBuilder : public FModelGenMeshBuilder
 {
 public:
-    explicit FHollowPrismBuilder(const AHollowPrism& InHollowPrism);
+    explicit FHollowPrismBuilder(const FHollowPrismParams& InParams);
 
     virtual bool Generate(FModelGenMeshData& OutMeshData) override;
     virtual int32 CalculateVertexCountEstimate() const override;
     virtual int32 CalculateTriangleCountEstimate() const override;
+    virtual bool GenerateSimpleCollision(FKAggregateGeom& OutGeom) const override;
+    virtual TUniquePtr<FModelGenMeshBuilder> CreateReducedBuilder(float TessellationScale) const override;
 
 private:
-    const AHollowPrism& HollowPrism;
+    FHollowPrismParams Params;
 
     bool bEnableBevel;
     int32 BevelSegments;
@@ -0,0 +1,102 @@
+// Copyright (c) 2024. All rights reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Containers/List.h"
+#include "IPhysXCooking.h"
+#include "ModelGenParamsHash.h"
+
+struct FTriIndices;
+
+namespace physx
+{
+    class PxConvexMesh;
+    class PxTriangleMesh;
+}
+
+struct FModelGenCollisionCookCacheStats
+{
+    int32 NumEntries = 0;
+    int32 HitCount = 0;
+    int32 MissCount = 0;
+    int32 EvictionCount = 0;
+};
+
+// 按几何内容哈希（顶点、索引、烘焙标志、物理格式）缓存已烘焙的凸包与三角网格
+// 缓存自身持有一次 PhysX 引用；返回的网格已为调用方额外增加一次引用，交给 BodySetup 后由其按正常流程释放
+// 内存未命中时若 FModelGenDiskCache 已开启，先从磁盘读取烘焙流，仍未命中才烘焙并写回
+class MODELGEN_API FModelGenCollisionCookCache
+{
+public:
+    static FModelGenCollisionCookCache& Get();
+
+    FModelGenCollisionCookCache();
+    ~FModelGenCollisionCookCache();
+
+    // 烘焙失败返回 nullptr；可在任意线程调用，烘焙本身不持有锁
+    physx::PxConvexMesh* FindOrCookConvex(
+        IPhysXCooking* Cooking,
+        FName Format,
+        EPhysXMeshCookFlags CookFlags,
+        const TArray<FVector>& Vertices);
+
+    physx::PxTriangleMesh* FindOrCookTriMesh(
+        IPhysXCooking* Cooking,
+        FName Format,
+        EPhysXMeshCookFlags CookFlags,
+        const TArray<FVector>& Vertices,
+        const TArray<FTriIndices>& Indices,
+        const TArray<uint16>& MaterialIndices,
+        bool bFlipNormals);
+
+    void Empty();
+
+    void SetMaxEntries(int32 InMaxEntries);
+    int32 GetMaxEntries() const;
+
+    int32 Num() const;
+    FModelGenCollisionCookCacheStats GetStats() const;
+
+private:
+    struct FEntry
+    {
+        physx::PxConvexMesh* ConvexMesh = nullptr;
+        physx::PxTriangleMesh* TriMesh = nullptr;
+        TDoubleLinkedList<FModelGenParamsHash>::TDoubleLinkedListNode* LruNode = nullptr;
+    };
+
+    static FModelGenParamsHash MakeKey(
+        uint8 MeshType,
+        FName Format,
+        EPhysXMeshCookFlags CookFlags,
+        const TArray<FVector>& Vertices,
+        const TArray<FTriIndices>* Indices,
+        const TArray<uint16>* MaterialIndices,
+        bool bFlipNormals);
+
+    static void AcquireMesh(const FEntry& Entry);
+    static void ReleaseMesh(const FEntry& Entry);
+
+    // 命中时为调用方增加引用并返回 true
+    bool FindAndAcquire(const FModelGenParamsHash& Key, FEntry& OutEntry);
+
+    // 新烘焙的网格入缓存；其他线程已先放入同一键时释放新网格并改用已有的，返回时均已为调用方增加引用
+    void AddAndAcquire(const FModelGenParamsHash& Key, FEntry& InOutEntry);
+
+    void RemoveEntry(const FModelGenParamsHash& Key);
+    void EvictToBudget();
+
+    TMap<FModelGenParamsHash, FEntry> Entries;
+
+    // 头部为最近使用，尾部为最久未使用
+    TDoubleLinkedList<FModelGenParamsHash> LruList;
+
+    int32 MaxEntries = 1024;
+
+    int32 HitCount = 0;
+    int32 MissCount = 0;
+    int32 EvictionCount = 0;
+
+    mutable FCriticalSection Lock;
+};
@@ -27,68 +27,6 @@ struct FDecompParams
     float MinVolumeRatio = 0.001f;
 };
 
-struct FFace
-{
-    int32 V0, V1, V2;
-    FFace* Neighbor[3];
-    TArray<int32> OutsidePoints;
-    bool bVisited;
-
-    FFace()
-        : V0(-1), V1(-1), V2(-1), bVisited(false)
-    {
-        Neighbor[0] = Neighbor[1] = Neighbor[2] = nullptr;
-    }
-
-    FFace(int32 InV0, int32 InV1, int32 InV2)
-        : V0(InV0), V1(InV1), V2(InV2), bVisited(false)
-    {
-        Neighbor[0] = Neighbor[1] = Neighbor[2] = nullptr;
-    }
-
-    void UpdatePlane(const TArray<FVector>& Points, FVector& OutNormal, float& OutDistance) const
-    {
-        FVector Edge1 = Points[V1] - Points[V0];
-        FVector Edge2 = Points[V2] - Points[V0];
-        OutNormal = FVector::CrossProduct(Edge1, Edge2);
-        float NormalLen = OutNormal.Size();
-        if (NormalLen > KINDA_SMALL_NUMBER)
-        {
-            OutNormal /= NormalLen;
-            OutDistance = -FVector::DotProduct(OutNormal, Points[V0]);
-        }
-        else
-        {
-            OutNormal = FVector::ZeroVector;
-            OutDistance = 0.0f;
-        }
-    }
-
-    float GetDistance(const TArray<FVector>& Points, const FVector& Point) const
-    {
-        FVector Normal;
-        float Distance;
-        UpdatePlane(Points, Normal, Distance);
-        return FVector::DotProduct(Normal, Point) + Distance;
-    }
-};
-
-struct FBoundaryEdge
-{
-    int32 V0, V1;
-    FFace* NeighborFace;
-
-    FBoundaryEdge()
-        : V0(-1), V1(-1), NeighborFace(nullptr)
-    {
-    }
-
-    FBoundaryEdge(int32 InV0, int32 InV1, FFace* InNeighborFace)
-        : V0(InV0), V1(InV1), NeighborFace(InNeighborFace)
-    {
-    }
-};
-
 class FModelGenConvexDecomp
 {
 public:
@@ -99,49 +37,38 @@ public:
         int32 MaxHullVerts,
         uint32 HullPrecision);
 
+    // 直接由顶点与索引分解，不依赖 ProceduralMeshComponent
+    static bool GenerateConvexHulls(
+        const FMeshData& MeshData,
+        UBodySetup* BodySetup,
+        int32 HullCount,
+        int32 MaxHullVerts,
+        uint32 HullPrecision);
+
+    // 只写入 OutGeom.ConvexElems，不触碰 UObject，可在工作线程调用
+    static bool GenerateConvexHulls(
+        const FMeshData& MeshData,
+        FKAggregateGeom& OutGeom,
+        int32 HullCount,
+        int32 MaxHullVerts,
+        uint32 HullPrecision);
+
 private:
     static bool ExtractMeshData(UProceduralMeshComponent* ProceduralMeshComponent, FMeshData& OutMeshData);
 
+    // 只划分不建包：按串行深度优先顺序收集叶子点集，凸包随后并行生成
     static void RecursiveDecompose(
         const FMeshData& MeshData,
         const TArray<int32>& TriangleIndices,
         const FDecompParams& Params,
         int32 CurrentDepth,
-        TArray<FKConvexElem>& OutConvexElems);
+        TArray<TArray<FVector>>& OutLeafPoints);
 
-    static bool GenerateConvexHull(const TArray<FVector>& Points, FKConvexElem& OutConvexElem);
-
-    static bool IsCollinear(const FVector& P0, const FVector& P1, const FVector& P2, float Epsilon);
-
-    static bool IsCoplanar(const FVector& P0, const FVector& P1, const FVector& P2, const FVector& P3, float Epsilon);
-
-    static bool BuildInitialTetrahedron(
-        const TArray<FVector>& Points,
-        TArray<FFace*>& OutFaces,
-        TArray<int32>& OutUnassignedPoints);
+    // 各叶子独立生成凸包，结果按叶子顺序合并，与串行执行一致
+    static void GenerateLeafHulls(const TArray<TArray<FVector>>& LeafPoints, TArray<FKConvexElem>& OutConvexElems);
 
-    static int32 FindFurthestPoint(const TArray<FVector>& Points, FFace* Face);
-
-    static void FindVisibleFaces(
-        const TArray<FVector>& Points,
-        int32 PointIndex,
-        FFace* StartFace,
-        TArray<FFace*>& OutVisibleFaces,
-        TMap<int32, FBoundaryEdge>& OutBoundaryEdges);
-
-    static void ConstructNewFaces(
-        const TArray<FVector>& Points,
-        int32 PointIndex,
-        TArray<FFace*>& OutNewFaces,
-        TMap<int32, FBoundaryEdge>& BoundaryEdges,
-        const TArray<FFace*>& VisibleFaces);
-
-    static void PartitionOutsideSet(
-        TArray<FFace*>& PendingFaces,
-        TArray<FFace*>& NewFaces,
-        const TArray<FVector>& Points,
-        TArray<int32>& UnassignedPoints,
-        FFace*& HeadFace);
+    // QuickHull：面池 + 缓存平面 + 待处理队列，期望复杂度 O(n log n)
+    static bool GenerateConvexHull(const TArray<FVector>& Points, FKConvexElem& OutConvexElem);
 
     static FBox CalculateTriangleBounds(const FMeshData& MeshData, const TArray<int32>& TriangleIndices);
 
@@ -0,0 +1,108 @@
+// Copyright (c) 2024. All rights reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Templates/Atomic.h"
+#include "Templates/Function.h"
+#include "Async/TaskGraphInterfaces.h"
+#include "ModelGenParamsHash.h"
+
+struct FModelGenMeshData;
+class FModelGenMeshBuilder;
+
+struct FModelGenDiskCacheStats
+{
+    int32 MeshHitCount = 0;
+    int32 MeshMissCount = 0;
+    int32 CollisionHitCount = 0;
+    int32 CollisionMissCount = 0;
+    int32 WriteCount = 0;
+
+    // 头部、版本或长度校验失败而被删除的文件
+    int32 RejectedCount = 0;
+
+    // 超出容量预算或过期而被清理的文件
+    int32 PrunedCount = 0;
+
+    int64 BytesRead = 0;
+    int64 BytesWritten = 0;
+};
+
+// Saved/ModelGenCache 下按内容寻址的持久缓存，跨编辑器会话保留生成的网格数据与烘焙后的碰撞
+// 网格文件以 参数哈希（含形状结构体名）+ 生成器几何版本 为键，碰撞文件以 FModelGenCollisionCookCache 的几何键 + PhysX 版本为键
+// 文件为定长头 + 流表 + 按 16 字节对齐的原始数据流，读取时优先内存映射；写入在后台线程先写临时文件再改名，可在任意线程调用
+// 总大小受字节预算约束：命中时刷新文件时间，超出预算时按最近使用时间从旧到新清理，过期文件一并删除
+class MODELGEN_API FModelGenDiskCache
+{
+public:
+    static FModelGenDiskCache& Get();
+
+    FModelGenDiskCache();
+
+    // 默认关闭，编辑器下以命令行 -ModelGenDiskCache 开启；-ModelGenDiskCacheBudgetMB=N 设置容量预算
+    bool IsEnabled() const { return bEnabled; }
+    void SetEnabled(bool bInEnabled) { bEnabled = bInEnabled; }
+
+    const FString& GetCacheDir() const { return CacheDir; }
+
+    // 先等待在途写入；只应在没有生成任务进行时调用，例如测试把缓存指向临时目录
+    void SetCacheDir(const FString& InCacheDir);
+
+    int64 GetByteBudget() const { return ByteBudget; }
+    void SetByteBudget(int64 InByteBudget);
+
+    // 命中时直接读入网格数据，否则调用 Builder.Generate；bPersist 为 true 时把有效结果排队写入磁盘
+    // 交互拖动等瞬时编辑应传 false，只读不写，避免每一帧的中间结果都落盘；未开启或 ParamsHash 无效时等同于 Generate
+    bool FindOrGenerate(const FModelGenParamsHash& ParamsHash, FModelGenMeshBuilder& Builder, FModelGenMeshData& OutMeshData, bool bPersist = true);
+
+    bool LoadMeshData(const FModelGenParamsHash& ParamsHash, FModelGenMeshData& OutMeshData);
+
+    // 在调用线程打包后交给后台线程写入，返回是否已排队
+    bool SaveMeshData(const FModelGenParamsHash& ParamsHash, const FModelGenMeshData& MeshData);
+
+    // 烘焙数据为 IPhysXCooking::CookConvex / CookTriMesh 输出的 PhysX 流
+    bool LoadCookedCollision(const FModelGenParamsHash& CookKey, TArray<uint8>& OutCookedData);
+    bool SaveCookedCollision(const FModelGenParamsHash& CookKey, const TArray<uint8>& CookedData);
+
+    // 等待所有排队中的写入完成
+    void Flush();
+
+    // 删除过期文件，再按最近使用时间从旧到新删除，直到总大小降到预算以内
+    void Prune();
+
+    // 删除缓存目录下的全部文件
+    void Clear();
+
+    FModelGenDiskCacheStats GetStats() const;
+
+private:
+    FString GetMeshPath(const FModelGenParamsHash& ParamsHash) const;
+    FString GetCollisionPath(const FModelGenParamsHash& CookKey) const;
+
+    // 按内存映射或整体读入的方式把文件内容交给 Parse，返回 Parse 的结果；校验失败的文件会被删除，成功时刷新文件时间供清理排序
+    bool ReadFile(const FString& Path, TFunctionRef<bool(const uint8* Data, int64 Size)> Parse);
+    bool WriteFile(const FString& Path, const TArray<uint8>& Buffer);
+    void QueueWrite(FString&& Path, TArray<uint8>&& Buffer);
+
+    FString CacheDir;
+
+    TAtomic<bool> bEnabled;
+
+    TAtomic<int64> ByteBudget;
+
+    // 目录总大小的估计值，每次清理后校正；为负表示本次会话尚未扫描过
+    int64 CachedBytes = -1;
+
+    FGraphEventArray PendingWrites;
+
+    FModelGenDiskCacheStats Stats;
+
+    mutable FCriticalSection StatsLock;
+
+    // 保护 CachedBytes 与 PendingWrites
+    FCriticalSection WriteLock;
+
+    // 同一时间只做一次目录扫描
+    FCriticalSection PruneLock;
+};
@@ -0,0 +1,99 @@
+// Copyright (c) 2024. All rights reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "ModelGenParamsHash.h"
+
+#include "ModelGenInstancingSubsystem.generated.h"
+
+class AActor;
+class AProceduralMeshActor;
+class UHierarchicalInstancedStaticMeshComponent;
+class UMaterialInterface;
+class UStaticMesh;
+
+USTRUCT()
+struct FModelGenInstanceGroup
+{
+    GENERATED_BODY()
+
+    UPROPERTY(Transient)
+    UHierarchicalInstancedStaticMeshComponent* Component = nullptr;
+
+    // 与 Component 的实例一一对应
+    UPROPERTY(Transient)
+    TArray<TWeakObjectPtr<AProceduralMeshActor>> Actors;
+
+    FModelGenParamsHash Key;
+};
+
+// 把参数相同的程序化形状合并为一个共享 StaticMesh 的 HISM，绘制调用与内存随不同形状数而不是 Actor 数增长
+// 分组键为形状参数哈希 + 材质 + 物理材质 + 是否碰撞 + LOD 数；参数哈希无效（不支持的类型）或 bAllowInstancing 为 false 的 Actor 不参与
+UCLASS()
+class MODELGEN_API UModelGenInstancingSubsystem : public UWorldSubsystem
+{
+    GENERATED_BODY()
+
+public:
+    static UModelGenInstancingSubsystem* Get(const UWorld* World);
+
+    virtual void Deinitialize() override;
+
+    // 开启后 BeginPlay 的形状自动加入实例组，并立即合并世界中已有的形状
+    UFUNCTION(BlueprintCallable, Category = "ModelGen|Instancing")
+    void SetAutoInstancingEnabled(bool bEnabled);
+
+    UFUNCTION(BlueprintCallable, BlueprintPure, Category = "ModelGen|Instancing")
+    bool IsAutoInstancingEnabled() const { return bAutoInstancing; }
+
+    // 合并世界中所有可实例化的形状，返回新加入的 Actor 数
+    UFUNCTION(BlueprintCallable, Category = "ModelGen|Instancing")
+    int32 InstanceAllShapes();
+
+    UFUNCTION(BlueprintCallable, Category = "ModelGen|Instancing")
+    bool AddActor(AProceduralMeshActor* Actor);
+
+    // 总是清除 Actor 的实例化状态；bRestoreMesh 为 true 时 Actor 按当前参数重新生成自己的网格
+    UFUNCTION(BlueprintCallable, Category = "ModelGen|Instancing")
+    void RemoveActor(AProceduralMeshActor* Actor, bool bRestoreMesh = true);
+
+    UFUNCTION(BlueprintCallable, Category = "ModelGen|Instancing")
+    void RemoveAllActors(bool bRestoreMesh = true);
+
+    // Actor 移动或参数变化后重新归组；只有变换变化时只更新该 Actor 对应的实例
+    UFUNCTION(BlueprintCallable, Category = "ModelGen|Instancing")
+    void RefreshActor(AProceduralMeshActor* Actor);
+
+    UFUNCTION(BlueprintCallable, BlueprintPure, Category = "ModelGen|Instancing")
+    int32 GetNumInstanceGroups() const { return Groups.Num(); }
+
+    UFUNCTION(BlueprintCallable, BlueprintPure, Category = "ModelGen|Instancing")
+    int32 GetNumInstancedActors() const { return ActorGroups.Num(); }
+
+private:
+    static FModelGenParamsHash MakeGroupKey(const FModelGenParamsHash& ParamsHash, const AProceduralMeshActor* Actor);
+
+    int32 FindOrCreateGroup(const FModelGenParamsHash& Key, AProceduralMeshActor* Actor);
+    UHierarchicalInstancedStaticMeshComponent* CreateGroupComponent(UStaticMesh* Mesh, UMaterialInterface* Material, bool bCollision);
+
+    // 按组内 Actor 的当前变换重建全部实例，同时剔除已销毁的 Actor
+    void RebuildGroupInstances(int32 GroupIndex);
+    void RemoveGroup(int32 GroupIndex);
+
+    AActor* GetOrCreateHolderActor();
+
+    UPROPERTY(Transient)
+    AActor* HolderActor = nullptr;
+
+    UPROPERTY(Transient)
+    TArray<FModelGenInstanceGroup> Groups;
+
+    TMap<FModelGenParamsHash, int32> GroupIndices;
+
+    // Actor 当前所在组的键
+    TMap<TWeakObjectPtr<AProceduralMeshActor>, FModelGenParamsHash> ActorGroups;
+
+    bool bAutoInstancing = false;
+};
@@ -5,6 +5,8 @@
 #include "CoreMinimal.h"
 #include "ModelGenMeshData.h"
 
+struct FKAggregateGeom;
+
 UENUM(BlueprintType)
 enum class EEndCapType : uint8
 {
@@ -26,36 +28,127 @@ enum class EInnerOuter : uint8
     Outer   UMETA(DisplayName = "外侧")
 };
 
+// 顶点焊接键：位置/法线/UV 按焊接容差量化后的整数分量
+struct FModelGenVertexKey
+{
+    int64 Components[8];
+    uint32 Hash;
+
+    FModelGenVertexKey(const FVector& Pos, const FVector& Normal, const FVector2D& UV, float InvTolerance);
+
+    bool operator==(const FModelGenVertexKey& Other) const
+    {
+        return FMemory::Memcmp(Components, Other.Components, sizeof(Components)) == 0;
+    }
+
+    friend uint32 GetTypeHash(const FModelGenVertexKey& Key)
+    {
+        return Key.Hash;
+    }
+};
+
+// 一次完整生成的拓扑：每次加顶点得到的索引、每次加三角形传入的索引，以及去重后的最终索引缓冲
+// 离散参数不变时半径、高度、弯曲等连续参数通常只改变顶点取值，可按它重放生成，跳过焊接表与三角形去重
+struct MODELGEN_API FModelGenTopologyRecord
+{
+    TArray<int32> VertexRefs;
+    TArray<int32> TriangleCalls;
+    TArray<int32> Triangles;
+    int32 NumVertices = 0;
+
+    bool IsValid() const { return NumVertices > 0 && VertexRefs.Num() > 0; }
+
+    void Reset();
+};
+
 class MODELGEN_API FModelGenMeshBuilder
 {
 public:
     FModelGenMeshBuilder();
     virtual ~FModelGenMeshBuilder() = default;
 
+    // 磁盘缓存按参数哈希寻址，参数不变而输出变了的网格只能靠它失效：修改任一生成器的输出（顶点、索引、法线、UV、切线、分段方式）都必须递增
+    // 2：EditableSurface 自适应采样改为两侧导轨按共享的中心线参数重采样
+    static constexpr uint32 GeometryVersion = 2;
+
     virtual bool Generate(FModelGenMeshData& OutMeshData) = 0;
 
+    // 之后的 Generate 把拓扑记录到 OutRecord，传 nullptr 停止记录；Generate 成功返回时记录才完整
+    void SetTopologyRecord(FModelGenTopologyRecord* OutRecord) { TopologyRecord = OutRecord; }
+
+    // 按记录的拓扑重放 Generate：顶点直接写入记录的位置，索引缓冲取自记录，不查焊接表也不做三角形去重
+    // 调用序列与记录不一致（连续参数改变了分支，例如倒角半径归零）或原先焊接的顶点不再重合时返回 false，调用方应完整生成
+    // 新出现的重合顶点不会被焊接，结果与完整生成在索引上可能不同，只用于显示，不应写入磁盘缓存
+    bool Regenerate(const FModelGenTopologyRecord& Record, FModelGenMeshData& OutMeshData);
+
     virtual int32 CalculateVertexCountEstimate() const = 0;
     virtual int32 CalculateTriangleCountEstimate() const = 0;
 
+    // 由形状参数直接给出简单碰撞（球、盒、胶囊或分扇区凸包），只依赖参数，无需先调用 Generate
+    // 返回 false 表示该形状或当前参数没有解析碰撞，调用方回退到通用凸分解
+    virtual bool GenerateSimpleCollision(FKAggregateGeom& OutGeom) const { return false; }
+
+    // 同一形状以较低细分（TessellationScale 为 (0, 1) 内的比例）重新生成的生成器，用于 LOD；细分已无法降低时返回 nullptr
+    virtual TUniquePtr<FModelGenMeshBuilder> CreateReducedBuilder(float TessellationScale) const { return nullptr; }
+
+    // 依次以 1/2、1/4… 的细分重新生成 LOD1 起的网格，直到达到 MaxLODs（含 LOD0）或三角形数不再明显下降
+    void GenerateLODs(int32 BaseTriangleCount, int32 MaxLODs, TArray<FModelGenMeshData>& OutLODs) const;
+
 protected:
+    // 低于该边数的多边形视为形状本身的棱面，生成 LOD 时不再减少
+    static constexpr int32 MinLODSides = 8;
+
+    // 按比例缩小分段数，结果不低于 MinCount；原值已不大于 MinCount 时保持不变
+    static int32 ScaleSegmentCount(int32 Count, float Scale, int32 MinCount);
+
     FModelGenMeshData MeshData;
 
-    TMap<FString, int32> UniqueVerticesMap;
+    TMap<FModelGenVertexKey, int32> UniqueVerticesMap;
+
+    // GetOrAddVertex 的焊接容差，分量差在容差内的顶点视为同一顶点
+    float WeldTolerance = 1.0e-6f;
 
     int32 GetOrAddVertex(const FVector& Pos, const FVector& Normal, const FVector2D& UV);
+    int32 GetOrAddVertex(const FVector& Pos, const FVector& Normal, const FVector2D& UV, const FProcMeshTangent& Tangent);
+
+    void SetWeldTolerance(float InTolerance);
 
     FVector GetPosByIndex(int32 index) const;
 
     int32 AddVertex(const FVector& Pos, const FVector& Normal, const FVector2D& UV);
+    int32 AddVertex(const FVector& Pos, const FVector& Normal, const FVector2D& UV, const FProcMeshTangent& Tangent);
 
     void AddTriangle(int32 V0, int32 V1, int32 V2);
     void AddQuad(int32 V0, int32 V1, int32 V2, int32 V3);
 
     FVector CalculateTangent(const FVector& Normal) const;
 
+    // 由位置对 U、V 的导数方向构造切线，约定与 FModelGenMeshData::CalculateTangents 一致
+    FProcMeshTangent MakeTangent(const FVector& Normal, const FVector& DPosDU, const FVector& DPosDV) const;
+
+    // 重放时按记录一次分配顶点流并取用记录的索引缓冲
     void Clear();
 
-    bool ValidateGeneratedData() const;
+    // 校验生成结果；记录拓扑时在这里补全最终索引缓冲，重放时同时核对调用序列已完整走完
+    bool ValidateGeneratedData();
+
+    // 正多边形环（外接圆半径 Radius，Sides 条边均分 [StartAngle, StartAngle + ArcAngle]）在 [FromAngle, ToAngle] 内的轮廓点，含两端点
+    static void AppendPolygonArcPoints(float Radius, int32 Sides, float StartAngle, float ArcAngle,
+        float FromAngle, float ToAngle, float Z, TArray<FVector>& OutPoints);
+
+    // 以点集作为一个凸包元素加入，点数不足 4 时忽略
+    static void AddConvexElem(FKAggregateGeom& OutGeom, TArray<FVector>&& Points);
 
     void ReserveMemory();
+
+private:
+    int32 ReplayVertex(const FVector& Pos, const FVector& Normal, const FVector2D& UV, const FProcMeshTangent& Tangent, bool bWelded);
+
+    FModelGenTopologyRecord* TopologyRecord = nullptr;
+
+    const FModelGenTopologyRecord* ReplayRecord = nullptr;
+    int32 ReplayVertexCursor = 0;
+    int32 ReplayTriangleCursor = 0;
+    int32 ReplayWrittenVertices = 0;
+    bool bReplayMismatch = false;
 };
\ No newline at end of file
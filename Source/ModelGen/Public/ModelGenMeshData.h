@@ -51,12 +51,21 @@ public:
     int32 GetVertexCount() const { return VertexCount; }
     
     int32 GetTriangleCount() const { return TriangleCount; }
+
+    // 各顶点流与索引缓冲已分配的字节数，不含去重用的临时集合
+    SIZE_T GetAllocatedSize() const;
     
     
     int32 AddVertex(const FVector& Position, 
                    const FVector& Normal = FVector::ZeroVector, 
                    const FVector2D& UV = FVector2D::ZeroVector, 
                    const FLinearColor& Color = FLinearColor::White);
+
+    int32 AddVertex(const FVector& Position,
+                   const FVector& Normal,
+                   const FVector2D& UV,
+                   const FProcMeshTangent& Tangent,
+                   const FLinearColor& Color = FLinearColor::White);
     
     void AddTriangle(int32 V0, int32 V1, int32 V2);
     
@@ -66,8 +75,19 @@ public:
     
     void ToProceduralMesh(UProceduralMeshComponent* MeshComponent, int32 SectionIndex = 0) const;
 
+    // 已有分段的顶点数、索引缓冲和碰撞设置与本数据完全一致时，可走 UpdateMeshSection 快速路径
+    bool HasSameTopology(const FProcMeshSection* Section, bool bCreateCollision) const;
+
+    // 调用方已确认索引缓冲与分段一致（按记录的拓扑重放生成）时只更新顶点流，跳过索引比较
+    // 分段不存在、顶点数或索引数不同、碰撞开关已变时返回 false，调用方改走 ToProceduralMesh
+    bool UpdateProceduralMeshVertices(UProceduralMeshComponent* MeshComponent, int32 SectionIndex = 0) const;
+
     void CalculateTangents();
 
+    // 按三角形质心沿包围盒最长轴做中位数切分，直到每块不超过 MaxTriangles，得到空间上连贯、包围盒紧凑的分块
+    // 块内只保留引用到的顶点，切分处的顶点会在相邻块中各复制一份；不需要切分时输出原数据的一份拷贝
+    void SplitByTriangleBudget(int32 MaxTriangles, TArray<FModelGenMeshData>& OutChunks) const;
+
     FVector CalculateTangent(const FVector& Normal) const;
 private:
     // 用于三角形去重的键集合（基于规范化后的顶点索引）
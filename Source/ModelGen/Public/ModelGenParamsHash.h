@@ -0,0 +1,54 @@
+// Copyright (c) 2024. All rights reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+class UScriptStruct;
+
+// 形状参数的 128 位内容哈希：按反射字段逐个规范化后哈希，而不是拼接字符串
+struct MODELGEN_API FModelGenParamsHash
+{
+    uint64 Low = 0;
+    uint64 High = 0;
+
+    bool IsValid() const { return (Low | High) != 0; }
+
+    bool operator==(const FModelGenParamsHash& Other) const
+    {
+        return Low == Other.Low && High == Other.High;
+    }
+
+    bool operator!=(const FModelGenParamsHash& Other) const
+    {
+        return !(*this == Other);
+    }
+
+    friend uint32 GetTypeHash(const FModelGenParamsHash& Hash)
+    {
+        return static_cast<uint32>(Hash.Low ^ (Hash.Low >> 32));
+    }
+
+    FString ToString() const;
+
+    // 结构体名、字段名与字段值都参与哈希；Transient 字段与非反射成员不参与
+    static FModelGenParamsHash Compute(const UScriptStruct* Struct, const void* Data);
+
+    // 只哈希整数、布尔、枚举等离散字段，浮点字段视为连续参数跳过；离散字段相同的两组参数通常生成相同的拓扑
+    static FModelGenParamsHash ComputeDiscrete(const UScriptStruct* Struct, const void* Data);
+
+    // 对任意字节流计算同样的 128 位哈希，供几何数据等非反射内容使用
+    static FModelGenParamsHash ComputeBytes(const void* Data, int64 NumBytes);
+
+    template <typename TParams>
+    static FModelGenParamsHash Compute(const TParams& Params)
+    {
+        return Compute(TParams::StaticStruct(), &Params);
+    }
+
+    template <typename TParams>
+    static FModelGenParamsHash ComputeDiscrete(const TParams& Params)
+    {
+        return ComputeDiscrete(TParams::StaticStruct(), &Params);
+    }
+};
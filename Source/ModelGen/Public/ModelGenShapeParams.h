@@ -0,0 +1,299 @@
+// Copyright (c) 2024. All rights reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Components/SplineComponent.h"
+#include "ModelGenShapeParams.generated.h"
+
+// 各形状的纯参数块：生成器按值持有，不引用任何 UObject，可在工作线程中生成
+
+USTRUCT(BlueprintType)
+struct MODELGEN_API FFrustumParams
+{
+    GENERATED_BODY()
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Frustum", meta = (ClampMin = "0.01", ClampMax = "1000"))
+    float TopRadius = 30.0f;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Frustum", meta = (ClampMin = "0.01", ClampMax = "1000"))
+    float BottomRadius = 50.0f;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Frustum", meta = (ClampMin = "0.01", ClampMax = "1000"))
+    float Height = 100.0f;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Frustum", meta = (ClampMin = "3", ClampMax = "25"))
+    int32 TopSides = 8;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Frustum", meta = (ClampMin = "3", ClampMax = "25"))
+    int32 BottomSides = 12;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Frustum", meta = (ClampMin = "0", ClampMax = "12"))
+    int32 HeightSegments = 0;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Frustum", meta = (ClampMin = "0.0", ClampMax = "250"))
+    float BevelRadius = 0.0f;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Frustum", meta = (ClampMin = "0", ClampMax = "12"))
+    int32 BevelSegments = 2;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Frustum", meta = (ClampMin = "-1.0", ClampMax = "1.0"))
+    float BendAmount = 0.0f;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Frustum", meta = (ClampMin = "0.0", ClampMax = "1000"))
+    float MinBendRadius = 1.0f;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Frustum", meta = (ClampMin = "0.0", ClampMax = "360.0"))
+    float ArcAngle = 360.0f;
+
+    bool IsValid() const;
+    int32 CalculateVertexCountEstimate() const;
+    int32 CalculateTriangleCountEstimate() const;
+};
+
+USTRUCT(BlueprintType)
+struct MODELGEN_API FSphereParams
+{
+    GENERATED_BODY()
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Sphere", meta = (ClampMin = "4", ClampMax = "64"))
+    int32 Sides = 16;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Sphere", meta = (ClampMin = "0.0", ClampMax = "1.0"))
+    float HorizontalCut = 0.0f;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Sphere", meta = (ClampMin = "0.0", ClampMax = "1.0"))
+    float VerticalCut = 1.0f;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Sphere", meta = (ClampMin = "0.01", ClampMax = "1000"))
+    float Radius = 50.0f;
+
+    bool IsValid() const;
+    int32 CalculateVertexCountEstimate() const;
+    int32 CalculateTriangleCountEstimate() const;
+};
+
+USTRUCT(BlueprintType)
+struct MODELGEN_API FHollowPrismParams
+{
+    GENERATED_BODY()
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "HollowPrism", meta = (ClampMin = "0.01", ClampMax = "1000"))
+    float InnerRadius = 25.0f;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "HollowPrism", meta = (ClampMin = "0.01", ClampMax = "1000"))
+    float OuterRadius = 50.0f;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "HollowPrism", meta = (ClampMin = "0.01", ClampMax = "1000"))
+    float Height = 100.0f;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "HollowPrism", meta = (ClampMin = "3", ClampMax = "25"))
+    int32 OuterSides = 8;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "HollowPrism", meta = (ClampMin = "3", ClampMax = "25"))
+    int32 InnerSides = 8;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "HollowPrism", meta = (ClampMin = "0.0", ClampMax = "360.0"))
+    float ArcAngle = 360.0f;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "HollowPrism", meta = (ClampMin = "0.0", ClampMax = "500"))
+    float BevelRadius = 0.0f;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "HollowPrism", meta = (ClampMin = "0", ClampMax = "4"))
+    int32 BevelSegments = 2;
+
+    bool IsValid() const;
+    float GetWallThickness() const { return OuterRadius - InnerRadius; }
+    bool IsFullCircle() const { return FMath::IsNearlyEqual(ArcAngle, 360.0f, 0.1f); }
+    int32 CalculateVertexCountEstimate() const;
+    int32 CalculateTriangleCountEstimate() const;
+};
+
+USTRUCT(BlueprintType)
+struct MODELGEN_API FPolygonTorusParams
+{
+    GENERATED_BODY()
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "PolygonTorus", meta = (ClampMin = "1.0", ClampMax = "1000"))
+    float MajorRadius = 100.0f;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "PolygonTorus", meta = (ClampMin = "1.0", ClampMax = "1000"))
+    float MinorRadius = 25.0f;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "PolygonTorus", meta = (ClampMin = 3, ClampMax = 25))
+    int32 MajorSegments = 8;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "PolygonTorus", meta = (ClampMin = 3, ClampMax = 25))
+    int32 MinorSegments = 8;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "PolygonTorus", meta = (ClampMin = "0.0", ClampMax = "360.0"))
+    float TorusAngle = 360.0f;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "PolygonTorus")
+    bool bSmoothCrossSection = true;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "PolygonTorus")
+    bool bSmoothVerticalSection = true;
+
+    bool IsValid() const;
+    int32 CalculateVertexCountEstimate() const;
+    int32 CalculateTriangleCountEstimate() const;
+};
+
+USTRUCT(BlueprintType)
+struct MODELGEN_API FPyramidParams
+{
+    GENERATED_BODY()
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Pyramid", meta = (ClampMin = "0.01", ClampMax = "1000"))
+    float BaseRadius = 70.0f;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Pyramid", meta = (ClampMin = "0.01", ClampMax = "1000"))
+    float Height = 100.0f;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Pyramid", meta = (ClampMin = "3", ClampMax = "25"))
+    int32 Sides = 4;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Pyramid", meta = (ClampMin = "0.0", ClampMax = "500"))
+    float BevelRadius = 0.0f;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Pyramid")
+    bool bSmoothSides = false;
+
+    bool IsValid() const;
+    float GetBevelTopRadius() const;
+    int32 CalculateVertexCountEstimate() const;
+    int32 CalculateTriangleCountEstimate() const;
+};
+
+USTRUCT(BlueprintType)
+struct MODELGEN_API FBevelCubeParams
+{
+    GENERATED_BODY()
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "BevelCube")
+    FVector Size = FVector(100.0f, 100.0f, 100.0f);
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "BevelCube", meta = (ClampMin = "0.0", ClampMax = "500"))
+    float BevelRadius = 10.0f;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "BevelCube", meta = (ClampMin = "0", ClampMax = "10"))
+    int32 BevelSegments = 3;
+
+    bool IsValid() const;
+    FVector GetHalfSize() const { return Size * 0.5f; }
+    FVector GetInnerOffset() const { return GetHalfSize() - FVector(BevelRadius); }
+    int32 GetVertexCount() const;
+    int32 GetTriangleCount() const;
+};
+
+UENUM(BlueprintType)
+enum class ESurfaceCurveType : uint8
+{
+    Standard UMETA(DisplayName = "标准曲线"),
+    Smooth UMETA(DisplayName = "平滑曲线")
+};
+
+UENUM(BlueprintType)
+enum class ESurfaceTextureMapping : uint8
+{
+    Default UMETA(DisplayName = "默认"),
+    Stretch UMETA(DisplayName = "拉伸")
+};
+
+USTRUCT(BlueprintType)
+struct FSurfaceWaypoint
+{
+    GENERATED_BODY()
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Waypoint", meta = (MakeEditWidget = true))
+    FVector Position = FVector::ZeroVector;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Waypoint", meta = (UIMin = "-1.0"))
+    float Width = -1.0f;
+
+    FSurfaceWaypoint()
+        : Position(FVector::ZeroVector), Width(-1.0f)
+    {
+    }
+
+    FSurfaceWaypoint(const FVector& InPosition, float InWidth = -1.0f)
+        : Position(InPosition), Width(InWidth)
+    {
+    }
+};
+
+USTRUCT(BlueprintType)
+struct MODELGEN_API FEditableSurfaceParams
+{
+    GENERATED_BODY()
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "EditableSurface")
+    TArray<FSurfaceWaypoint> Waypoints;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "EditableSurface")
+    ESurfaceCurveType CurveType = ESurfaceCurveType::Smooth;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "EditableSurface", meta = (ClampMin = "0.01", ClampMax = "2000"))
+    float SurfaceWidth = 100.0f;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "EditableSurface", meta = (ClampMin = "10.0", ClampMax = "1000.0"))
+    float SplineSampleStep = 10.0f;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "EditableSurface", meta = (ClampMin = "1.0", ClampMax = "5000.0"))
+    float LoopRemovalThreshold = 10.0f;
+
+    // 自适应采样：SplineSampleStep 作为最小步长，只在曲率、倾斜或宽度变化处加密
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "EditableSurface")
+    bool bAdaptiveSampling = false;
+
+    // 相邻采样点切线/法线允许的最大夹角（度）
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "EditableSurface", meta = (ClampMin = "0.1", ClampMax = "45.0"))
+    float AdaptiveAngleTolerance = 2.0f;
+
+    // 中心线与宽度相对弦线插值允许的最大偏差
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "EditableSurface", meta = (ClampMin = "0.01", ClampMax = "100.0"))
+    float AdaptiveChordTolerance = 1.0f;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "EditableSurface", meta = (ClampMin = "10.0", ClampMax = "10000.0"))
+    float AdaptiveMaxStep = 500.0f;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "EditableSurface")
+    bool bEnableThickness = false;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "EditableSurface", meta = (ClampMin = "0.01", ClampMax = "200"))
+    float ThicknessValue = 20.0f;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "EditableSurface", meta = (ClampMin = "0", ClampMax = "5"))
+    int32 SideSmoothness = 1;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "EditableSurface")
+    float RightSlopeLength = 30.0f;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "EditableSurface")
+    float RightSlopeGradient = 1.0f;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "EditableSurface")
+    float LeftSlopeLength = 30.0f;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "EditableSurface")
+    float LeftSlopeGradient = 1.0f;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "EditableSurface")
+    ESurfaceTextureMapping TextureMapping = ESurfaceTextureMapping::Default;
+
+    // 由路点构建的样条曲线快照（本地空间），不参与反射；样条组件也可被直接编辑，哈希时需单独计入
+    FSplineCurves SplineCurves;
+    FVector DefaultUpVector = FVector::UpVector;
+
+    // 按路点和曲线类型重建 SplineCurves，与 AEditableSurface 的样条组件保持一致
+    void BuildSplineCurves(int32 ReparamStepsPerSegment = 10);
+
+    int32 GetNumSplinePoints() const { return SplineCurves.Position.Points.Num(); }
+    float GetSplineLength() const { return SplineCurves.GetSplineLength(); }
+    float GetDistanceAtSplinePoint(int32 PointIndex) const;
+    FTransform GetTransformAtDistance(float Distance) const;
+    FVector GetScaleAtDistance(float Distance) const;
+
+    bool IsValid() const;
+};
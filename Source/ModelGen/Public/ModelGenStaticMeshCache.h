@@ -0,0 +1,98 @@
+// Copyright (c) 2024. All rights reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/GCObject.h"
+#include "Containers/List.h"
+#include "ModelGenParamsHash.h"
+
+#include "ModelGenStaticMeshCache.generated.h"
+
+class UStaticMesh;
+
+USTRUCT(BlueprintType)
+struct FModelGenStaticMeshCacheStats
+{
+    GENERATED_BODY()
+
+    UPROPERTY(BlueprintReadOnly, Category = "ModelFactory|Cache")
+    int32 NumEntries = 0;
+
+    UPROPERTY(BlueprintReadOnly, Category = "ModelFactory|Cache")
+    int64 TotalBytes = 0;
+
+    UPROPERTY(BlueprintReadOnly, Category = "ModelFactory|Cache")
+    int64 BudgetBytes = 0;
+
+    UPROPERTY(BlueprintReadOnly, Category = "ModelFactory|Cache")
+    int32 HitCount = 0;
+
+    UPROPERTY(BlueprintReadOnly, Category = "ModelFactory|Cache")
+    int32 MissCount = 0;
+
+    UPROPERTY(BlueprintReadOnly, Category = "ModelFactory|Cache")
+    int32 EvictionCount = 0;
+
+    UPROPERTY(BlueprintReadOnly, Category = "ModelFactory|Cache")
+    float HitRate = 0.0f;
+};
+
+// 按参数哈希缓存生成的 StaticMesh：FGCObject 持有引用防止被 GC，超出字节预算时按最近最少使用淘汰
+class MODELGEN_API FModelGenStaticMeshCache : public FGCObject
+{
+public:
+    static FModelGenStaticMeshCache& Get();
+
+    FModelGenStaticMeshCache();
+    virtual ~FModelGenStaticMeshCache();
+
+    // 命中时刷新最近使用顺序；失效的条目会被移除并计为未命中
+    UStaticMesh* Find(const FModelGenParamsHash& Key);
+
+    void Add(const FModelGenParamsHash& Key, UStaticMesh* Mesh);
+    void Remove(const FModelGenParamsHash& Key);
+    void Empty();
+    int32 RemoveInvalidEntries();
+
+    void SetBudgetBytes(int64 InBudgetBytes);
+    int64 GetBudgetBytes() const;
+
+    int32 Num() const;
+    FModelGenStaticMeshCacheStats GetStats() const;
+
+    // 渲染数据与碰撞数据（BodySetup）的估算内存
+    static int64 CalculateMeshBytes(const UStaticMesh* Mesh);
+
+    //~ Begin FGCObject Interface
+    virtual void AddReferencedObjects(FReferenceCollector& Collector) override;
+    virtual FString GetReferencerName() const override;
+    //~ End FGCObject Interface
+
+private:
+    struct FEntry
+    {
+        UStaticMesh* Mesh = nullptr;
+        int64 SizeBytes = 0;
+        TDoubleLinkedList<FModelGenParamsHash>::TDoubleLinkedListNode* LruNode = nullptr;
+    };
+
+    static bool IsMeshUsable(const UStaticMesh* Mesh);
+
+    void RemoveEntry(const FModelGenParamsHash& Key);
+    void EvictToBudget(const FModelGenParamsHash& KeepKey);
+
+    TMap<FModelGenParamsHash, FEntry> Entries;
+
+    // 头部为最近使用，尾部为最久未使用
+    TDoubleLinkedList<FModelGenParamsHash> LruList;
+
+    int64 TotalBytes = 0;
+    int64 BudgetBytes = 256ll * 1024 * 1024;
+
+    int32 HitCount = 0;
+    int32 MissCount = 0;
+    int32 EvictionCount = 0;
+
+    mutable FCriticalSection Lock;
+};
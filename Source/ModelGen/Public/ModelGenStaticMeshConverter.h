@@ -0,0 +1,97 @@
+// Copyright (c) 2024. All rights reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "ModelGenMeshData.h"
+#include "PhysicsEngine/AggregateGeom.h"
+#include "PhysicsEngine/BodySetupEnums.h"
+#include "IPhysXCooking.h"
+
+class UStaticMesh;
+class UBodySetup;
+class UMaterialInterface;
+class UPhysicalMaterial;
+class UProceduralMeshComponent;
+class IPhysXCookingModule;
+struct FMeshDescription;
+struct FMeshData;
+struct FTriIndices;
+
+namespace physx
+{
+    class PxConvexMesh;
+    class PxTriangleMesh;
+}
+
+struct MODELGEN_API FModelGenStaticMeshSettings
+{
+    // 按分段顺序对应的材质，数量不足的分段使用 nullptr（引擎默认材质）
+    TArray<UMaterialInterface*> SectionMaterials;
+
+    UPhysicalMaterial* PhysMaterial = nullptr;
+
+    bool bGenerateSimpleCollision = true;
+    bool bGenerateComplexCollision = true;
+
+    // 形状由参数给出的解析简单碰撞；不为空时直接使用，不再做通用凸分解
+    FKAggregateGeom SimpleCollision;
+
+    // 凸分解与烘焙放到后台任务，完成前 BodySetup 只有包围盒；完成后在游戏线程整体替换 BodySetup
+    bool bAsyncCollision = false;
+
+    // 异步碰撞替换完成后在游戏线程调用，使用方在此重建组件的物理状态
+    TFunction<void(UStaticMesh*)> OnAsyncCollisionReady;
+};
+
+// 由 FModelGenMeshData 直接构建运行时 StaticMesh，不需要 Actor 或 ProceduralMeshComponent
+class MODELGEN_API FModelGenStaticMeshConverter
+{
+public:
+    // 每个网格数据对应一个材质分段；保留网格数据中的切线与顶点划分，必须在游戏线程调用
+    // LODMeshes 依次作为 LOD1、LOD2…，每级只有一个分段并使用材质槽 0，切换屏幕尺寸按各级三角形数自动设置；碰撞只取 LOD0
+    static UStaticMesh* CreateStaticMesh(TArrayView<const FModelGenMeshData> Sections, const FModelGenStaticMeshSettings& Settings,
+        TArrayView<const FModelGenMeshData> LODMeshes = TArrayView<const FModelGenMeshData>());
+
+    static UStaticMesh* CreateStaticMesh(const FModelGenMeshData& MeshData, const FModelGenStaticMeshSettings& Settings,
+        TArrayView<const FModelGenMeshData> LODMeshes = TArrayView<const FModelGenMeshData>());
+
+    // 将 ProceduralMeshComponent 的分段复制为网格数据，供已有组件的转换路径复用
+    static void ExtractSectionsFromProceduralMesh(const UProceduralMeshComponent* ProceduralMeshComponent, TArray<FModelGenMeshData>& OutSections);
+
+private:
+    static UStaticMesh* CreateStaticMeshObject(int32 NumSections, const FModelGenStaticMeshSettings& Settings);
+    static bool BuildMeshDescription(TArrayView<const FModelGenMeshData> Sections, FMeshDescription& OutMeshDescription, UStaticMesh* StaticMesh);
+    static bool BuildStaticMeshGeometry(TArrayView<const FModelGenMeshData> Sections, TArrayView<const FModelGenMeshData> LODMeshes, UStaticMesh* StaticMesh);
+    static bool InitializeStaticMeshRenderData(UStaticMesh* StaticMesh);
+    static void SetupLODScreenSizes(UStaticMesh* StaticMesh);
+    static void SetupBodySetupProperties(UBodySetup* BodySetup, const FModelGenStaticMeshSettings& Settings);
+    static void BuildDecompMeshData(TArrayView<const FModelGenMeshData> Sections, FMeshData& OutMeshData);
+    static bool AddBoundsBoxElem(const FBox& Bounds, FKAggregateGeom& OutGeom);
+
+    // 以下三个函数不访问 UObject，可在工作线程执行
+    static bool GenerateSimpleCollision(const FMeshData& DecompMeshData, const FModelGenStaticMeshSettings& Settings, FKAggregateGeom& OutGeom);
+    static void CookConvexElems(TArray<FKConvexElem>& ConvexElems, IPhysXCooking* PhysXCooking, TArray<physx::PxConvexMesh*>& OutConvexMeshes);
+    static physx::PxTriangleMesh* CookTriMesh(IPhysXCooking* PhysXCooking, EPhysXMeshCookFlags CookFlags, TArray<FVector>& Vertices, TArray<FTriIndices>& Indices);
+
+    static int32 CreateConvexMeshesManually(UBodySetup* BodySetup, IPhysXCookingModule* PhysXCookingModule);
+    static bool ExtractTriMeshData(TArrayView<const FModelGenMeshData> Sections, TArray<FVector>& OutVertices, TArray<FTriIndices>& OutIndices);
+    static bool ExtractTriMeshDataFromRenderData(UStaticMesh* StaticMesh, TArray<FVector>& OutVertices, TArray<FTriIndices>& OutIndices);
+    static void SetupBodySetupAndCollision(TArrayView<const FModelGenMeshData> Sections, UStaticMesh* StaticMesh, const FModelGenStaticMeshSettings& Settings);
+
+    static void LaunchAsyncCollision(
+        UStaticMesh* StaticMesh,
+        IPhysXCooking* PhysXCooking,
+        EPhysXMeshCookFlags TriMeshCookFlags,
+        FMeshData&& DecompMeshData,
+        TArray<FVector>&& TriVertices,
+        TArray<FTriIndices>&& TriIndices,
+        const FModelGenStaticMeshSettings& Settings);
+
+    static void FinishAsyncCollision(
+        UStaticMesh* StaticMesh,
+        ECollisionTraceFlag TraceFlag,
+        const FKAggregateGeom& Geom,
+        const TArray<physx::PxConvexMesh*>& ConvexMeshes,
+        physx::PxTriangleMesh* TriMesh);
+};
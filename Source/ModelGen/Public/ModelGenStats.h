@@ -0,0 +1,128 @@
+// Copyright (c) 2024. All rights reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Stats/Stats.h"
+#include "Trace/Trace.h"
+#include "ProfilingDebugging/CpuProfilerTrace.h"
+
+#include "ModelGenStats.generated.h"
+
+struct FModelGenMeshData;
+
+DECLARE_STATS_GROUP(TEXT("ModelGen"), STATGROUP_ModelGen, STATCAT_Advanced);
+
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Builder Generate"), STAT_ModelGen_Generate, STATGROUP_ModelGen, MODELGEN_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Calculate Tangents"), STAT_ModelGen_CalculateTangents, STATGROUP_ModelGen, MODELGEN_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("To ProceduralMesh"), STAT_ModelGen_ToProceduralMesh, STATGROUP_ModelGen, MODELGEN_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Build MeshDescription"), STAT_ModelGen_BuildMeshDescription, STATGROUP_ModelGen, MODELGEN_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Build From MeshDescriptions"), STAT_ModelGen_BuildStaticMesh, STATGROUP_ModelGen, MODELGEN_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Convex Decomposition"), STAT_ModelGen_ConvexDecomposition, STATGROUP_ModelGen, MODELGEN_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("PhysX Cooking"), STAT_ModelGen_CollisionCooking, STATGROUP_ModelGen, MODELGEN_API);
+
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Generated Vertices"), STAT_ModelGen_GeneratedVertices, STATGROUP_ModelGen, MODELGEN_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Generated Triangles"), STAT_ModelGen_GeneratedTriangles, STATGROUP_ModelGen, MODELGEN_API);
+
+DECLARE_MEMORY_STAT_EXTERN(TEXT("Last Generated MeshData"), STAT_ModelGen_GeneratedMeshDataMemory, STATGROUP_ModelGen, MODELGEN_API);
+DECLARE_MEMORY_STAT_EXTERN(TEXT("Last ProceduralMesh Upload"), STAT_ModelGen_UploadedMeshMemory, STATGROUP_ModelGen, MODELGEN_API);
+DECLARE_MEMORY_STAT_EXTERN(TEXT("StaticMesh Cache"), STAT_ModelGen_StaticMeshCacheMemory, STATGROUP_ModelGen, MODELGEN_API);
+
+// Insights 中用 -trace=cpu,ModelGen 单独打开
+UE_TRACE_CHANNEL_EXTERN(ModelGenChannel, MODELGEN_API);
+
+UENUM(BlueprintType)
+enum class EModelGenStage : uint8
+{
+    Generate,
+    CalculateTangents,
+    ToProceduralMesh,
+    BuildMeshDescription,
+    BuildStaticMesh,
+    ConvexDecomposition,
+    CollisionCooking,
+
+    Count UMETA(Hidden)
+};
+
+// 各阶段最近一次执行的耗时；分块生成时为最后完成的一块
+USTRUCT(BlueprintType)
+struct MODELGEN_API FModelGenGenerationStats
+{
+    GENERATED_BODY()
+
+    UPROPERTY(BlueprintReadOnly, Category = "ModelFactory|Stats")
+    float GenerateMs = 0.0f;
+
+    UPROPERTY(BlueprintReadOnly, Category = "ModelFactory|Stats")
+    float CalculateTangentsMs = 0.0f;
+
+    UPROPERTY(BlueprintReadOnly, Category = "ModelFactory|Stats")
+    float ToProceduralMeshMs = 0.0f;
+
+    UPROPERTY(BlueprintReadOnly, Category = "ModelFactory|Stats")
+    float BuildMeshDescriptionMs = 0.0f;
+
+    UPROPERTY(BlueprintReadOnly, Category = "ModelFactory|Stats")
+    float BuildStaticMeshMs = 0.0f;
+
+    UPROPERTY(BlueprintReadOnly, Category = "ModelFactory|Stats")
+    float ConvexDecompositionMs = 0.0f;
+
+    UPROPERTY(BlueprintReadOnly, Category = "ModelFactory|Stats")
+    float CollisionCookingMs = 0.0f;
+
+    UPROPERTY(BlueprintReadOnly, Category = "ModelFactory|Stats")
+    int32 VertexCount = 0;
+
+    UPROPERTY(BlueprintReadOnly, Category = "ModelFactory|Stats")
+    int32 TriangleCount = 0;
+
+    UPROPERTY(BlueprintReadOnly, Category = "ModelFactory|Stats")
+    int64 MeshDataBytes = 0;
+};
+
+// 汇总各阶段计时，供蓝图和日志读取；可在任意线程记录
+class MODELGEN_API FModelGenStageRecorder
+{
+public:
+    static void RecordStage(EModelGenStage Stage, double Seconds);
+    static void RecordMesh(const FModelGenMeshData& MeshData);
+
+    static FModelGenGenerationStats GetLastStats();
+    static void Reset();
+};
+
+// 单个阶段的计时作用域，析构时写入 FModelGenStageRecorder
+class MODELGEN_API FModelGenStageScope
+{
+public:
+    explicit FModelGenStageScope(EModelGenStage InStage);
+    ~FModelGenStageScope();
+
+private:
+    EModelGenStage Stage;
+    double StartTime;
+};
+
+// 构建器 Generate 的计时作用域，额外记录输出网格的规模
+class MODELGEN_API FModelGenGenerateScope : public FModelGenStageScope
+{
+public:
+    explicit FModelGenGenerateScope(const FModelGenMeshData& InMeshData);
+    ~FModelGenGenerateScope();
+
+private:
+    const FModelGenMeshData& MeshData;
+};
+
+// 同时打开 stat 计数、Insights 事件和阶段计时
+#define MODELGEN_STAGE_SCOPE(StageName) \
+    SCOPE_CYCLE_COUNTER(STAT_ModelGen_##StageName); \
+    TRACE_CPUPROFILER_EVENT_SCOPE_ON_CHANNEL_STR("ModelGen::" #StageName, ModelGenChannel); \
+    FModelGenStageScope PREPROCESSOR_JOIN(ModelGenStageScope_, __LINE__)(EModelGenStage::StageName)
+
+#define MODELGEN_GENERATE_SCOPE(OutMeshData) \
+    SCOPE_CYCLE_COUNTER(STAT_ModelGen_Generate); \
+    TRACE_CPUPROFILER_EVENT_SCOPE_ON_CHANNEL_STR("ModelGen::Generate", ModelGenChannel); \
+    FModelGenGenerateScope PREPROCESSOR_JOIN(ModelGenGenerateScope_, __LINE__)(OutMeshData)
@@ -4,10 +4,68 @@
 
 #include "CoreMinimal.h"
 #include "UObject/Object.h"
+#include "ModelGenStaticMeshCache.h"
+#include "ModelGenStats.h"
 #include "ModelStrategyFactory.generated.h"
 
 class AActor;
 class UWorld;
+class UScriptStruct;
+class AProceduralMeshActor;
+class FModelGenMeshBuilder;
+struct FModelGenStaticMeshSettings;
+
+USTRUCT(BlueprintType)
+struct FModelGenBatchRequest
+{
+    GENERATED_BODY()
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "ModelFactory|Batch")
+    FString ModelType;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "ModelFactory|Batch")
+    TMap<FString, FString> Parameters;
+};
+
+USTRUCT(BlueprintType)
+struct FModelGenBatchStats
+{
+    GENERATED_BODY()
+
+    UPROPERTY(BlueprintReadOnly, Category = "ModelFactory|Batch")
+    int32 NumRequests = 0;
+
+    // 去重后实际需要的网格数
+    UPROPERTY(BlueprintReadOnly, Category = "ModelFactory|Batch")
+    int32 NumUnique = 0;
+
+    UPROPERTY(BlueprintReadOnly, Category = "ModelFactory|Batch")
+    int32 NumCacheHits = 0;
+
+    UPROPERTY(BlueprintReadOnly, Category = "ModelFactory|Batch")
+    int32 NumGenerated = 0;
+
+    UPROPERTY(BlueprintReadOnly, Category = "ModelFactory|Batch")
+    int32 NumFailed = 0;
+
+    UPROPERTY(BlueprintReadOnly, Category = "ModelFactory|Batch")
+    int32 GeneratedTriangles = 0;
+
+    // 并行生成网格数据的墙钟时间
+    UPROPERTY(BlueprintReadOnly, Category = "ModelFactory|Batch")
+    float GenerateMs = 0.0f;
+
+    // 游戏线程上创建 StaticMesh 渲染与碰撞资源的时间
+    UPROPERTY(BlueprintReadOnly, Category = "ModelFactory|Batch")
+    float FinalizeMs = 0.0f;
+
+    UPROPERTY(BlueprintReadOnly, Category = "ModelFactory|Batch")
+    float TotalMs = 0.0f;
+
+    // 按请求数计的吞吐
+    UPROPERTY(BlueprintReadOnly, Category = "ModelFactory|Batch")
+    float MeshesPerSecond = 0.0f;
+};
 
 UCLASS(BlueprintType)
 class MODELGEN_API UCustomModelFactory : public UObject
@@ -32,6 +90,11 @@ class MODELGEN_API UCustomModelFactory : public UObject
 
     UFUNCTION(BlueprintCallable, Category = "ModelFactory")
     static UStaticMesh* CreateModelStaticMeshWithDefaults(const FString& ModelTypeName, UWorld* World);
+
+    // 批量创建 StaticMesh：相同参数只生成一次，网格数据在工作线程并行生成，渲染与碰撞资源在游戏线程统一创建
+    // 返回数组与 Requests 一一对应，失败的位置为 nullptr；未注册生成器的类型逐个走 Actor 路径
+    UFUNCTION(BlueprintCallable, Category = "ModelFactory|Batch")
+    static TArray<UStaticMesh*> CreateModelStaticMeshesBatch(const TArray<FModelGenBatchRequest>& Requests, UWorld* World, FModelGenBatchStats& OutStats);
     
     UFUNCTION(BlueprintCallable, Category = "ModelFactory|Cache")
     static void ClearCache();
@@ -44,32 +107,74 @@ class MODELGEN_API UCustomModelFactory : public UObject
     
     UFUNCTION(BlueprintCallable, Category = "ModelFactory|Cache")
     static void LogCacheStats();
+
+    UFUNCTION(BlueprintCallable, BlueprintPure, Category = "ModelFactory|Cache")
+    static FModelGenStaticMeshCacheStats GetCacheStats();
+
+    // 缓存的内存预算（渲染数据 + 碰撞数据），超出后按最近最少使用淘汰
+    UFUNCTION(BlueprintCallable, Category = "ModelFactory|Cache")
+    static void SetCacheBudgetMB(float BudgetMB);
+
+    // Saved/ModelGenCache 下跨会话保留的网格数据与烘焙碰撞，命中时跳过生成与烘焙；默认关闭
+    UFUNCTION(BlueprintCallable, Category = "ModelFactory|Cache")
+    static void SetDiskCacheEnabled(bool bEnabled);
+
+    // 磁盘缓存的容量预算，超出后按最近使用时间从旧到新清理
+    UFUNCTION(BlueprintCallable, Category = "ModelFactory|Cache")
+    static void SetDiskCacheBudgetMB(float BudgetMB);
+
+    UFUNCTION(BlueprintCallable, BlueprintPure, Category = "ModelFactory|Cache")
+    static bool IsDiskCacheEnabled();
+
+    UFUNCTION(BlueprintCallable, Category = "ModelFactory|Cache")
+    static void ClearDiskCache();
     
+    // 最近一次生成各阶段的耗时（毫秒）与输出网格规模
+    UFUNCTION(BlueprintCallable, BlueprintPure, Category = "ModelFactory|Stats")
+    static FModelGenGenerationStats GetLastGenerationStats();
+
+    UFUNCTION(BlueprintCallable, Category = "ModelFactory|Stats")
+    static void LogGenerationStats();
+
     // 生成缓存键（用于比较模型是否相同）
     UFUNCTION(BlueprintCallable, Category = "ModelFactory|Cache")
     static FString GenerateCacheKey(const FString& ModelType, const TMap<FString, FString>& Parameters);
 
+    // 由字符串参数创建生成器，同时输出参数哈希；参数无效时返回 nullptr
+    using FModelBuilderFactory = TFunction<TUniquePtr<FModelGenMeshBuilder>(const TMap<FString, FString>& Parameters, FModelGenParamsHash& OutParamsHash)>;
+
+    // 注册不经过 Actor 的生成路径，CreateModelStaticMesh 优先使用
+    static void RegisterBuilderType(const FString& ModelTypeName, FModelBuilderFactory BuilderFactory);
+
+    static TUniquePtr<FModelGenMeshBuilder> CreateBuilder(const FString& ModelTypeName, const TMap<FString, FString>& Parameters, FModelGenParamsHash& OutParamsHash);
+
+    // 缓存未命中时用给定生成器生成并转换，结果按 参数哈希 + 材质、碰撞与 LOD 设置 入缓存；生成失败返回 nullptr
+    // 不带设置的版本使用 ProceduralMeshActor 的默认材质与 LOD 数
+    static UStaticMesh* FindOrCreateStaticMesh(const FModelGenParamsHash& ParamsHash, FModelGenMeshBuilder& Builder);
+    static UStaticMesh* FindOrCreateStaticMesh(const FModelGenParamsHash& ParamsHash, FModelGenMeshBuilder& Builder,
+        const FModelGenStaticMeshSettings& Settings, int32 LODCount);
+
+    // 按字段名（不区分大小写）把字符串参数导入参数结构体，返回成功导入的个数
+    static int32 ApplyParameters(const UScriptStruct* Struct, void* Data, const TMap<FString, FString>& Parameters);
+
 private:
+    // 同一形状在不同材质、碰撞方式或 LOD 数下得到不同的 StaticMesh，这些设置都要进入缓存键
+    static FModelGenParamsHash MakeStaticMeshCacheKey(const FModelGenParamsHash& ParamsHash, const FModelGenStaticMeshSettings& Settings, int32 LODCount);
+
+    static void GetDefaultStaticMeshSettings(FModelGenStaticMeshSettings& OutSettings, int32& OutLODCount);
+
     // 内部方法：统一的Actor创建逻辑
     static AActor* CreateModelActorInternal(const FString& ModelTypeName, const TMap<FString, FString>& Parameters, UWorld* World, const FVector& Location, const FRotator& Rotation);
     
 private:
     // 模型类型注册表
     static TMap<FString, TSubclassOf<AActor>> ModelTypeRegistry;
-    
-    // 静态缓存：模型类型+参数哈希 -> StaticMesh
-    static TMap<FString, UStaticMesh*> StaticMeshCache;
-    
-    // 缓存统计信息
-    static int32 CacheHitCount;
-    static int32 CacheMissCount;
-    static int32 CacheAccessCount;
-    
-    // 自动清理间隔（每 N 次访问清理一次）
-    static const int32 AUTO_CLEANUP_INTERVAL;
-    
-    // 线程安全锁：保护缓存访问
-    static FCriticalSection CacheLock;
+
+    // 生成器注册表
+    static TMap<FString, FModelBuilderFactory> BuilderRegistry;
+
+    // 未注册生成器的类型仍通过临时 Actor 生成
+    static UStaticMesh* CreateModelStaticMeshFromActor(const FString& ModelTypeName, const TMap<FString, FString>& Parameters, UWorld* World);
     
     // 初始化默认模型类型
     static void InitializeDefaultModelTypes();
@@ -4,6 +4,7 @@
 
 #include "CoreMinimal.h"
 #include "ProceduralMeshActor.h"
+#include "ModelGenShapeParams.h"
 #include "PolygonTorus.generated.h"
 
 UCLASS(BlueprintType, meta=(DisplayName = "Polygon Torus"))
@@ -70,10 +71,17 @@ public:
 
     virtual void GenerateMesh() override;
 
+protected:
+    virtual TUniquePtr<FModelGenMeshBuilder> CreateMeshBuilder() const override;
+
 private:
     bool TryGenerateMeshInternal();
 
 public:
+    FPolygonTorusParams GetParams() const;
+
+    virtual FModelGenParamsHash GetShapeParamsHash() const override;
+
     virtual bool IsValid() const override;
 
     int32 CalculateVertexCountEstimate() const;
@@ -2,20 +2,21 @@
 
 #include "CoreMinimal.h"
 #include "ModelGenMeshBuilder.h"
-
-class APolygonTorus;
+#include "ModelGenShapeParams.h"
 
 class MODELGEN_API FPolygonTorusBuilder : public FModelGenMeshBuilder
 {
 public:
-    explicit FPolygonTorusBuilder(const APolygonTorus& InPolygonTorus);
+    explicit FPolygonTorusBuilder(const FPolygonTorusParams& InParams);
 
     virtual bool Generate(FModelGenMeshData& OutMeshData) override;
     virtual int32 CalculateVertexCountEstimate() const override;
     virtual int32 CalculateTriangleCountEstimate() const override;
+    virtual bool GenerateSimpleCollision(FKAggregateGeom& OutGeom) const override;
+    virtual TUniquePtr<FModelGenMeshBuilder> CreateReducedBuilder(float TessellationScale) const override;
 
 private:
-    const APolygonTorus& PolygonTorus;
+    FPolygonTorusParams Params;
 
     struct FCachedTrig
     {
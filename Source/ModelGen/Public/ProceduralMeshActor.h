@@ -4,13 +4,21 @@
 
 #include "CoreMinimal.h"
 #include "GameFramework/Actor.h"
+#include "HAL/ThreadSafeCounter.h"
 #include "Components/StaticMeshComponent.h"
 #include "ProceduralMeshComponent.h"
+#include "ModelGenParamsHash.h"
 
 #include "ProceduralMeshActor.generated.h"
 
 class UProceduralMeshComponent;
 class UMaterialInterface;
+class FModelGenMeshBuilder;
+struct FModelGenMeshData;
+struct FModelGenTopologyRecord;
+struct FModelGenStaticMeshSettings;
+
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnMeshGenerationCompleted, bool, bSuccess);
 
 UCLASS(BlueprintType, meta=(DisplayName = "Procedural Mesh Actor"))
 class MODELGEN_API AProceduralMeshActor : public AActor
@@ -21,6 +29,22 @@ public:
     AProceduralMeshActor();
 
     virtual void OnConstruction(const FTransform& Transform) override;
+    virtual void BeginPlay() override;
+    virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+#if WITH_EDITOR
+    virtual void PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent) override;
+#endif
+
+    // 为 false 时不参与 UModelGenInstancingSubsystem 的实例化合并
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "ProceduralMesh|Instancing")
+    bool bAllowInstancing = true;
+
+    UFUNCTION(BlueprintCallable, BlueprintPure, Category = "ProceduralMesh|Instancing")
+    bool IsInstanced() const { return bInstanced; }
+
+    // 由 UModelGenInstancingSubsystem 切换：实例化期间释放自身的网格与 StaticMesh，由共享的 HISM 显示和碰撞
+    // 取消时 bRegenerate 为 true 则按当前参数重新生成；为 false 时只清除实例化状态，之后的生成调用照常生效
+    void SetInstanced(bool bInInstanced, bool bRegenerate = true);
 
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "ProceduralMesh|Component")
     UProceduralMeshComponent* ProceduralMeshComponent;
@@ -40,9 +64,6 @@ public:
     UFUNCTION(BlueprintCallable, Category = "ProceduralMesh|Operations")
     void SetPMCCollisionEnabled(bool bEnable);
 
-    UFUNCTION(BlueprintCallable, Category = "ProceduralMesh|Collision")
-    void GeneratePMCollisionData();
-
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "ProceduralMesh|Collision")
     bool bGenerateCollision = true;
 
@@ -50,6 +71,10 @@ public:
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "ProceduralMesh|StaticMesh")
     bool bShowStaticMeshComponent = true;
 
+    // 转换出的 StaticMesh 最多包含的 LOD 数（含 LOD0），其余各级由生成器降低细分重新生成；1 表示只有 LOD0
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "ProceduralMesh|StaticMesh", meta = (ClampMin = "1", ClampMax = "8"))
+    int32 StaticMeshLODCount = 4;
+
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "ProceduralMesh|Materials")
     UMaterialInterface* StaticMeshMaterial = nullptr;
 
@@ -59,32 +84,134 @@ public:
     UFUNCTION(BlueprintCallable, Category = "ProceduralMesh|Operations")
     UStaticMesh* ConvertProceduralMeshToStaticMesh();
 
+    // bAllowAsyncCollision 为 false 时无视 bUseAsyncCooking 同步烘焙碰撞
+    // 结果交给 Actor 以外的使用方（工厂、共享缓存）时必须同步：异步完成后只通知本 Actor 的组件，其他组件会一直停留在包围盒占位碰撞
+    UStaticMesh* ConvertToStaticMesh(bool bAllowAsyncCollision);
+
     UFUNCTION(BlueprintCallable, Category = "ProceduralMesh|StaticMesh",
         meta = (CallInEditor = "true", DisplayName = "转换到 StaticMesh"))
     void UpdateStaticMeshComponent();
 
+    // OnConstruction 时是否在任务图上异步生成网格
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "ProceduralMesh|Generation")
+    bool bAsyncMeshGeneration = false;
+
+    // 异步生成结束（成功应用、失败或无法生成）时在游戏线程广播，被取代的任务不会广播
+    UPROPERTY(BlueprintAssignable, Category = "ProceduralMesh|Generation")
+    FOnMeshGenerationCompleted OnMeshGenerationCompleted;
+
+    // 在后台线程构建网格数据，完成后回到游戏线程写入 ProceduralMeshComponent
+    UFUNCTION(BlueprintCallable, Category = "ProceduralMesh|Operations")
+    void GenerateMeshAsync();
+
+    UFUNCTION(BlueprintCallable, Category = "ProceduralMesh|Operations")
+    void CancelAsyncMeshGeneration();
+
+    UFUNCTION(BlueprintCallable, BlueprintPure, Category = "ProceduralMesh|Operations")
+    bool IsAsyncMeshGenerationPending() const { return bAsyncGenerationPending; }
+
+    // 分块输出时的分块数；分块 0 即 ProceduralMeshComponent，其余分块各自是一个子 PMC
+    UFUNCTION(BlueprintCallable, BlueprintPure, Category = "ProceduralMesh|Component")
+    int32 GetNumMeshChunks() const { return 1 + ChunkMeshComponents.Num(); }
+
    protected:
 
     virtual bool IsValid() const {return true;}
 
     UProceduralMeshComponent* GetProceduralMesh() const { return ProceduralMeshComponent; }
 
+    // 实例化期间参数或变换变化只交给实例组重新归组；返回 true 时调用方应跳过自身的网格生成
+    bool RefreshInstancedShape();
+
+    // 将生成结果写入组件，并使尚未完成的异步任务失效；结果会被保留供 StaticMesh 转换直接使用
+    // SourceBuilder 为产生该结果的参数快照，转换时的解析碰撞由它给出；为空时以当前参数创建（同步生成时二者一致）
+    void ApplyMeshData(FModelGenMeshData&& MeshData, TSharedPtr<FModelGenMeshBuilder> SourceBuilder = nullptr);
+
+    // 同步生成并写入分块 0。离散参数（整数、布尔、枚举）与上次完整生成相同时先按记录的拓扑重放生成，
+    // 只经 UpdateMeshSection 更新顶点流；重放与记录不符或离散参数变化时经磁盘缓存完整生成并重新记录拓扑
+    template <typename TParams>
+    bool GenerateAndApplyMesh(FModelGenMeshBuilder& Builder, const TParams& Params)
+    {
+        return GenerateAndApplyMesh(Builder, FModelGenParamsHash::Compute(Params), FModelGenParamsHash::ComputeDiscrete(Params));
+    }
+
+    bool GenerateAndApplyMesh(FModelGenMeshBuilder& Builder, const FModelGenParamsHash& ParamsHash, const FModelGenParamsHash& TopologyKey);
+
+    // 参数无效或生成失败时清掉组件中的旧网格与转换用的上次结果，显示与 StaticMesh 转换都不再停留在旧参数上
+    virtual void ClearGeneratedMesh();
+
+    // 只写入指定分块并保留其余分块，分块不存在时自动创建；写入后 StaticMesh 转换改为从各分块组件回读
+    // 每个分块是独立的 PMC，包围盒只覆盖自身，屏幕外的分块可以被单独剔除
+    void ApplyMeshChunk(int32 ChunkIndex, const FModelGenMeshData& MeshData);
+
+    // 调整分块数，多余分块的组件（及其转换出的 StaticMeshComponent）被销毁
+    void SetNumMeshChunks(int32 NumChunks);
+
+    // 生成结果是否写入磁盘缓存：只有编辑器中提交属性修改时的重建才写，拖动滑条、运行时改参数等瞬时编辑只读不写
+    bool ShouldPersistMeshData() const { return bCommittingEdit; }
+
+    // 组件内容是否来自最近一次 ApplyMeshData 的整体写入
+    bool HasWholeMeshData() const { return LastMeshData.IsValid(); }
+
 public:
     UFUNCTION(BlueprintCallable, Category = "ProceduralMesh|Operations")
     virtual void GenerateMesh() { }
 
+    // 当前形状参数的内容哈希，相同配置得到相同哈希；不支持的类型返回无效哈希
+    virtual FModelGenParamsHash GetShapeParamsHash() const { return FModelGenParamsHash(); }
+
+    // 以当前参数快照创建生成器，供后台线程使用；参数无效时返回 nullptr
+    virtual TUniquePtr<FModelGenMeshBuilder> CreateMeshBuilder() const;
+
+    // 由 UCustomModelFactory 按参数生成并放入共享缓存的 StaticMesh 所用的材质与物理材质
+    void GetSharedStaticMeshSettings(FModelGenStaticMeshSettings& OutSettings) const;
+
 private:
-    UStaticMesh* CreateStaticMeshObject() const;
-    bool BuildMeshDescriptionFromPMC(FMeshDescription& OutMeshDescription, UStaticMesh* StaticMesh) const;
-    bool BuildStaticMeshGeometryFromProceduralMesh(UStaticMesh* StaticMesh) const;
-    bool InitializeStaticMeshRenderData(UStaticMesh* StaticMesh) const;
-    void SetupBodySetupProperties(UBodySetup* BodySetup) const;
-    bool GenerateSimpleCollision(UBodySetup* BodySetup, UStaticMesh* StaticMesh) const;
-    int32 CreateConvexMeshesManually(UBodySetup* BodySetup, IPhysXCookingModule* PhysXCookingModule) const;
-    bool ExtractTriMeshDataFromPMC(TArray<FVector>& OutVertices, TArray<FTriIndices>& OutIndices) const;
-    bool ExtractTriMeshDataFromRenderData(UStaticMesh* StaticMesh, TArray<FVector>& OutVertices, TArray<FTriIndices>& OutIndices) const;
-    bool GenerateComplexCollision(UBodySetup* BodySetup, IPhysXCookingModule* PhysXCookingModule) const;
-    void LogCollisionStatistics(UBodySetup* BodySetup, UStaticMesh* StaticMesh) const;
-    void SetupBodySetupAndCollision(UStaticMesh* StaticMesh) const;
-    void GenerateTangentsManually(FMeshDescription& MeshDescription) const;
+    void FinishAsyncMeshGeneration(bool bSuccess);
+
+    // 运行时 SetActorLocation 等不会触发 OnConstruction，实例化期间由根组件的变换回调同步 HISM 实例
+    void OnRootTransformUpdated(USceneComponent* UpdatedComponent, EUpdateTransformFlags UpdateTransformFlags, ETeleportType Teleport);
+
+    UProceduralMeshComponent* GetMeshChunkComponent(int32 ChunkIndex) const;
+    UProceduralMeshComponent* CreateChunkMeshComponent();
+    void SyncChunkComponentSettings(UProceduralMeshComponent* ChunkComponent) const;
+
+    // 清掉 FirstSection 及之后仍有数据的分段
+    static void ClearSectionsFrom(UProceduralMeshComponent* MeshComponent, int32 FirstSection);
+    void SetNumChunkStaticMeshComponents(int32 NumComponents);
+
+    // 多个 PMC 的分段合并为一个 StaticMesh，每个非空分段各占一个网格分段
+    UStaticMesh* ConvertMeshComponentsToStaticMesh(TArrayView<UProceduralMeshComponent* const> Sources, bool bAllowAsyncCollision);
+    void SetupStaticMeshSettings(FModelGenStaticMeshSettings& Settings, bool bAllowAsyncCollision);
+    void ApplyConvertedStaticMesh(UStaticMeshComponent* Target, UStaticMesh* ConvertedMesh, UProceduralMeshComponent* Source);
+
+    // 分块 1..N-1 的 PMC 及其转换结果所用的 StaticMeshComponent，运行时创建，不保存
+    UPROPERTY(Transient)
+    TArray<UProceduralMeshComponent*> ChunkMeshComponents;
+
+    UPROPERTY(Transient)
+    TArray<UStaticMeshComponent*> ChunkStaticMeshComponents;
+
+    // 异步任务序号，任务完成时序号不一致即说明已被新的请求取代
+    TSharedRef<FThreadSafeCounter, ESPMode::ThreadSafe> AsyncGenerationSerial = MakeShared<FThreadSafeCounter, ESPMode::ThreadSafe>();
+
+    bool bAsyncGenerationPending = false;
+
+    bool bInstanced = false;
+
+    // 非交互的 PostEditChangeProperty 期间为 true
+    bool bCommittingEdit = false;
+
+    FDelegateHandle RootTransformUpdatedHandle;
+
+    // 最近一次写入组件的生成结果，转换时用它代替从 PMC 分段回读
+    TSharedPtr<FModelGenMeshData> LastMeshData;
+
+    // 产生 LastMeshData 的参数快照；参数之后被修改或有异步任务在途时，转换仍与组件中的网格一致
+    TSharedPtr<FModelGenMeshBuilder> LastMeshBuilder;
+
+    // 组件中整体结果的拓扑记录及其离散参数哈希，供下一次编辑原位重算
+    TSharedPtr<FModelGenTopologyRecord> LastTopology;
+
+    FModelGenParamsHash LastTopologyKey;
 };
@@ -4,6 +4,7 @@
 
 #include "CoreMinimal.h"
 #include "ProceduralMeshActor.h"
+#include "ModelGenShapeParams.h"
 #include "Pyramid.generated.h"
 
 class FPyramidBuilder;
@@ -54,10 +55,17 @@ public:
 
     virtual void GenerateMesh() override;
 
+protected:
+    virtual TUniquePtr<FModelGenMeshBuilder> CreateMeshBuilder() const override;
+
 private:
     bool TryGenerateMeshInternal();
 
 public:
+    FPyramidParams GetParams() const;
+
+    virtual FModelGenParamsHash GetShapeParamsHash() const override;
+
     virtual bool IsValid() const override;
     
     UFUNCTION(BlueprintCallable, Category = "Pyramid|Generation")
@@ -2,20 +2,21 @@
 
 #include "CoreMinimal.h"
 #include "ModelGenMeshBuilder.h"
-
-class APyramid;
+#include "ModelGenShapeParams.h"
 
 class MODELGEN_API FPyramidBuilder : public FModelGenMeshBuilder
 {
 public:
-    explicit FPyramidBuilder(const APyramid& InPyramid);
+    explicit FPyramidBuilder(const FPyramidParams& InParams);
 
     virtual bool Generate(FModelGenMeshData& OutMeshData) override;
     virtual int32 CalculateVertexCountEstimate() const override;
     virtual int32 CalculateTriangleCountEstimate() const override;
+    virtual bool GenerateSimpleCollision(FKAggregateGeom& OutGeom) const override;
+    virtual TUniquePtr<FModelGenMeshBuilder> CreateReducedBuilder(float TessellationScale) const override;
 
 private:
-    const APyramid& Pyramid;
+    FPyramidParams Params;
 
     float BaseRadius;
     float Height;
@@ -2,6 +2,7 @@
 
 #include "CoreMinimal.h"
 #include "ProceduralMeshActor.h"
+#include "ModelGenShapeParams.h"
 #include "Sphere.generated.h"
 
 class FSphereBuilder;
@@ -45,10 +46,17 @@ public:
 
     virtual void GenerateMesh() override;
 
+protected:
+    virtual TUniquePtr<FModelGenMeshBuilder> CreateMeshBuilder() const override;
+
 private:
     bool TryGenerateMeshInternal();
 
 public:
+    FSphereParams GetParams() const;
+
+    virtual FModelGenParamsHash GetShapeParamsHash() const override;
+
     virtual bool IsValid() const override;
     
     int32 CalculateVertexCountEstimate() const;
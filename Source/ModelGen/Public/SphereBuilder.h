@@ -2,22 +2,23 @@
 
 #include "CoreMinimal.h"
 #include "ModelGenMeshBuilder.h"
-
-class ASphere;
+#include "ModelGenShapeParams.h"
 
 class MODELGEN_API FSphereBuilder : public FModelGenMeshBuilder
 {
 public:
-    explicit FSphereBuilder(const ASphere& InSphere);
+    explicit FSphereBuilder(const FSphereParams& InParams);
 
     virtual bool Generate(FModelGenMeshData& OutMeshData) override;
     virtual int32 CalculateVertexCountEstimate() const override;
     virtual int32 CalculateTriangleCountEstimate() const override;
+    virtual bool GenerateSimpleCollision(FKAggregateGeom& OutGeom) const override;
+    virtual TUniquePtr<FModelGenMeshBuilder> CreateReducedBuilder(float TessellationScale) const override;
 
     void Clear();
 
 private:
-    const ASphere& Sphere;
+    FSphereParams Params;
 
     float Radius;
     int32 Sides;
@@ -32,6 +33,8 @@ private:
 
     FVector GetSpherePoint(float Theta, float Phi) const;
     FVector GetSphereNormal(float Theta, float Phi) const;
+    FVector GetSphereTangentU(float Theta) const;
+    FVector GetSphereTangentV(float Theta, float Phi) const;
 
     void SafeAddTriangle(int32 V0, int32 V1, int32 V2);
     void SafeAddQuad(int32 V0, int32 V1, int32 V2, int32 V3);